@@ -0,0 +1,112 @@
+import GStreamer
+import Foundation
+
+/// Example moving video frames between processes through shared memory.
+///
+/// Demonstrates:
+/// - Publishing appsink frames with SharedMemoryPublisher
+/// - Reading them in place with SharedMemorySubscriber
+/// - Measuring transport throughput for 4K BGRA frames
+///
+/// Usage:
+///   gst-shm bench [frames]          In-process publisher and subscriber
+///   gst-shm publish <socket>        Publish videotestsrc frames
+///   gst-shm subscribe <socket>      Print frames from a publisher
+@main
+struct GstShmExample {
+    static func main() async throws {
+        print("GStreamer version: \(GStreamer.versionString)")
+
+        let arguments = CommandLine.arguments.dropFirst()
+        switch arguments.first {
+        case "publish":
+            try await publish(socketPath: arguments.dropFirst().first ?? "/tmp/gst-shm.sock")
+        case "subscribe":
+            try await subscribe(socketPath: arguments.dropFirst().first ?? "/tmp/gst-shm.sock")
+        default:
+            try await bench(frames: arguments.dropFirst().first.flatMap { Int($0) } ?? 600)
+        }
+    }
+
+    /// Push 4K BGRA buffers through the transport as fast as the subscriber releases them.
+    static func bench(frames: Int) async throws {
+        let width = 3840
+        let height = 2160
+        let frameSize = width * height * 4
+        let socketPath = NSTemporaryDirectory() + "gst-shm-bench-\(getpid()).sock"
+
+        let publisher = try SharedMemoryPublisher(socketPath: socketPath, slotCount: 4, slotSize: frameSize)
+        let subscriber = try SharedMemorySubscriber(socketPath: socketPath)
+        let caps = "video/x-raw,format=BGRA,width=\(width),height=\(height),framerate=30/1"
+
+        // One buffer reused for every frame, so only the transport is measured.
+        let buffer = try Buffer(size: frameSize, pts: 0)
+
+        let consumer = Task {
+            var received = 0
+            var checksum: UInt64 = 0
+            for await frame in subscriber.frames() {
+                // Touch one byte per page, as a consumer reading the frame would.
+                checksum &+= frame.withBytes { bytes in
+                    stride(from: 0, to: bytes.byteCount, by: 4096).reduce(UInt64(0)) {
+                        $0 &+ UInt64(bytes.unsafeLoad(fromByteOffset: $1, as: UInt8.self))
+                    }
+                } ?? 0
+                frame.release()
+                received += 1
+                if received == frames { break }
+            }
+            return (received, checksum)
+        }
+
+        print("Publishing \(frames) frames of \(width)x\(height) BGRA (\(frameSize / 1_048_576) MiB each)...")
+        let clock = ContinuousClock()
+        let start = clock.now
+        for _ in 0..<frames {
+            try await publisher.publish(buffer, caps: caps)
+        }
+        let (received, _) = await consumer.value
+        let elapsed = clock.now - start
+        publisher.close()
+
+        let seconds = Double(elapsed.components.seconds) + Double(elapsed.components.attoseconds) / 1e18
+        let megabytes = Double(received * frameSize) / 1_048_576
+        print("Received \(received) frames in \(String(format: "%.2f", seconds))s")
+        print("Throughput: \(String(format: "%.0f", megabytes / seconds)) MiB/s, \(String(format: "%.1f", Double(received) / seconds)) fps")
+        print("Statistics: \(publisher.statistics)")
+    }
+
+    /// Publish a test pattern until interrupted.
+    static func publish(socketPath: String) async throws {
+        let pipeline = try Pipeline("""
+            videotestsrc is-live=true ! \
+            video/x-raw,format=BGRA,width=1280,height=720,framerate=30/1 ! \
+            appsink name=sink
+            """)
+        let sink = try AppSink(pipeline: pipeline, name: "sink")
+        let publisher = try SharedMemoryPublisher(
+            socketPath: socketPath,
+            slotSize: 1280 * 720 * 4,
+            dropWhenFull: true
+        )
+
+        try pipeline.play()
+        print("Publishing on \(socketPath). Press Ctrl+C to stop.")
+        try await publisher.publish(from: sink)
+        publisher.close()
+        pipeline.stop()
+    }
+
+    /// Print every frame a publisher sends.
+    static func subscribe(socketPath: String) async throws {
+        let subscriber = try SharedMemorySubscriber(socketPath: socketPath)
+        print("Subscribed to \(socketPath)")
+
+        for await frame in subscriber.frames() {
+            let pts = frame.pts.map { String(format: "%.3fs", Double($0) / 1e9) } ?? "none"
+            print("Frame \(frame.sequence): \(frame.size) bytes, pts \(pts), caps \(frame.caps ?? "unknown")")
+            frame.release()
+        }
+        print("Publisher closed")
+    }
+}
@@ -116,6 +116,18 @@ let package = Package(
             path: "Examples/gst-appsrc"
         ),
 
+        .executableTarget(
+            name: "gst-allocators",
+            dependencies: ["GStreamer"],
+            path: "Examples/gst-allocators"
+        ),
+
+        .executableTarget(
+            name: "gst-shm",
+            dependencies: ["GStreamer"],
+            path: "Examples/gst-shm"
+        ),
+
         .executableTarget(
             name: "gst-tee",
             dependencies: ["GStreamer"],
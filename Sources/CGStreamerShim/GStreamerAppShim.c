@@ -1,5 +1,9 @@
 #include "include/GStreamerAppShim.h"
 
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
 // MARK: - AppSink
 
 GstSample* swift_gst_app_sink_pull_sample(GstAppSink* appsink) {
@@ -10,6 +14,10 @@ GstSample* swift_gst_app_sink_try_pull_sample(GstAppSink* appsink, GstClockTime
     return gst_app_sink_try_pull_sample(appsink, timeout);
 }
 
+GstSample* swift_gst_app_sink_try_pull_preroll(GstAppSink* appsink, GstClockTime timeout) {
+    return gst_app_sink_try_pull_preroll(appsink, timeout);
+}
+
 gboolean swift_gst_app_sink_is_eos(GstAppSink* appsink) {
     return gst_app_sink_is_eos(appsink);
 }
@@ -34,6 +42,15 @@ void swift_gst_app_sink_set_drop(GstAppSink* appsink, gboolean drop) {
     g_object_set(G_OBJECT(appsink), "drop", drop, NULL);
 }
 
+GstSample* swift_gst_base_sink_get_last_sample(GstElement* sink) {
+    if (!g_object_class_find_property(G_OBJECT_GET_CLASS(sink), "last-sample")) {
+        return NULL;
+    }
+    GstSample* sample = NULL;
+    g_object_get(sink, "last-sample", &sample, NULL);
+    return sample;
+}
+
 // MARK: - AppSrc
 
 GstFlowReturn swift_gst_app_src_push_buffer(GstAppSrc* appsrc, GstBuffer* buffer) {
@@ -140,6 +157,307 @@ GstClockTime swift_gst_second(void) {
     return GST_SECOND;
 }
 
+// MARK: - Buffer Flags and Regions
+
+gboolean swift_gst_buffer_is_delta_unit(GstBuffer* buffer) {
+    return GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT);
+}
+
+GstBuffer* swift_gst_buffer_share_region(GstBuffer* buffer, gsize offset, gsize size) {
+    if (offset + size > gst_buffer_get_size(buffer)) {
+        return NULL;
+    }
+    // Without GST_BUFFER_COPY_DEEP the new buffer refs the same memories.
+    return gst_buffer_copy_region(buffer, GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS | GST_BUFFER_COPY_MEMORY,
+                                  offset, size);
+}
+
+gboolean swift_gst_buffer_is_writable(GstBuffer* buffer) {
+    return gst_buffer_is_writable(buffer);
+}
+
+GstBuffer* swift_gst_buffer_make_writable(GstBuffer* buffer) {
+    return gst_buffer_make_writable(buffer);
+}
+
+GstBuffer* swift_gst_buffer_new_empty(void) {
+    return gst_buffer_new();
+}
+
+guint swift_gst_buffer_n_memory(GstBuffer* buffer) {
+    return gst_buffer_n_memory(buffer);
+}
+
+guint swift_gst_buffer_get_max_memory(void) {
+    return gst_buffer_get_max_memory();
+}
+
+void swift_gst_buffer_add_memories(GstBuffer* buffer, GstBuffer* source, gboolean prepend) {
+    // Take the references first: source may be buffer itself.
+    guint count = gst_buffer_n_memory(source);
+    GstMemory** memories = g_newa(GstMemory*, count);
+    for (guint index = 0; index < count; index++) {
+        memories[index] = gst_buffer_get_memory(source, index);
+    }
+    for (guint index = 0; index < count; index++) {
+        gst_buffer_insert_memory(buffer, prepend ? (gint)index : -1, memories[index]);
+    }
+}
+
+GstBuffer* swift_gst_caps_get_codec_data(GstCaps* caps) {
+    if (gst_caps_get_size(caps) == 0) {
+        return NULL;
+    }
+    const GValue* value = gst_structure_get_value(gst_caps_get_structure(caps, 0), "codec_data");
+    if (!value || !GST_VALUE_HOLDS_BUFFER(value)) {
+        return NULL;
+    }
+    return gst_value_get_buffer(value);
+}
+
+// MARK: - Allocators
+
+#define SWIFT_GST_HUGE_PAGE_SIZE ((gsize)2 * 1024 * 1024)
+
+typedef struct {
+    GstAllocator parent;
+    SwiftGstMemorySource source;
+    gsize alignment;
+    SwiftGstAllocateCallback allocate;
+    SwiftGstDeallocateCallback deallocate;
+    gpointer user_data;
+    GDestroyNotify destroy;
+    /* Protected by the object lock */
+    guint64 allocations;
+    guint64 bytes;
+    guint64 huge_page_bytes;
+} SwiftGstAllocator;
+
+typedef struct {
+    GstAllocatorClass parent_class;
+} SwiftGstAllocatorClass;
+
+GType swift_gst_allocator_get_type(void);
+G_DEFINE_TYPE(SwiftGstAllocator, swift_gst_allocator, GST_TYPE_ALLOCATOR)
+
+/* One block of memory handed to GStreamer; holds the allocator alive until freed */
+typedef struct {
+    SwiftGstAllocator* allocator;
+    gpointer data;
+    gsize size;
+    gboolean huge_pages;
+} SwiftGstAllocation;
+
+static gpointer swift_gst_huge_pages_map(gsize size, gsize* mapped, gboolean* reserved) {
+    gsize length = (size + SWIFT_GST_HUGE_PAGE_SIZE - 1) & ~(SWIFT_GST_HUGE_PAGE_SIZE - 1);
+    *mapped = length;
+    *reserved = FALSE;
+#ifdef MAP_HUGETLB
+    gpointer data = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (data != MAP_FAILED) {
+        *reserved = TRUE;
+        return data;
+    }
+#endif
+    /* Transparent huge pages only back 2 MiB-aligned ranges: over-map and trim */
+    guint8* raw = mmap(NULL, length + SWIFT_GST_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                       -1, 0);
+    if ((gpointer)raw == MAP_FAILED) {
+        return NULL;
+    }
+    guint8* aligned = (guint8*)(((guintptr)raw + SWIFT_GST_HUGE_PAGE_SIZE - 1) & ~(guintptr)(SWIFT_GST_HUGE_PAGE_SIZE - 1));
+    if (aligned > raw) {
+        munmap(raw, (gsize)(aligned - raw));
+    }
+    gsize tail = (gsize)((raw + length + SWIFT_GST_HUGE_PAGE_SIZE) - (aligned + length));
+    if (tail > 0) {
+        munmap(aligned + length, tail);
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+    return aligned;
+}
+
+static void swift_gst_allocation_free(gpointer user_data) {
+    SwiftGstAllocation* allocation = user_data;
+    SwiftGstAllocator* self = allocation->allocator;
+
+    switch (self->source) {
+    case SWIFT_GST_MEMORY_ALIGNED:
+        free(allocation->data);
+        break;
+    case SWIFT_GST_MEMORY_HUGE_PAGES:
+        munmap(allocation->data, allocation->size);
+        break;
+    case SWIFT_GST_MEMORY_PROVIDED:
+        self->deallocate(allocation->data, allocation->size, self->user_data);
+        break;
+    }
+
+    GST_OBJECT_LOCK(self);
+    self->allocations--;
+    self->bytes -= allocation->size;
+    if (allocation->huge_pages) {
+        self->huge_page_bytes -= allocation->size;
+    }
+    GST_OBJECT_UNLOCK(self);
+
+    gst_object_unref(self);
+    g_free(allocation);
+}
+
+static GstMemory* swift_gst_allocator_alloc(GstAllocator* base, gsize size, GstAllocationParams* params) {
+    SwiftGstAllocator* self = (SwiftGstAllocator*)base;
+    gsize alignment = MAX(self->alignment, params->align + 1);
+    /* Round the prefix up so the data itself starts aligned */
+    gsize offset = (params->prefix + alignment - 1) & ~(alignment - 1);
+    gsize total = offset + size + params->padding;
+
+    SwiftGstAllocation* allocation = g_new0(SwiftGstAllocation, 1);
+    allocation->size = total;
+    switch (self->source) {
+    case SWIFT_GST_MEMORY_ALIGNED:
+        if (posix_memalign(&allocation->data, MAX(alignment, sizeof(gpointer)), total) != 0) {
+            allocation->data = NULL;
+        }
+        break;
+    case SWIFT_GST_MEMORY_HUGE_PAGES:
+        allocation->data = swift_gst_huge_pages_map(total, &allocation->size, &allocation->huge_pages);
+        break;
+    case SWIFT_GST_MEMORY_PROVIDED:
+        allocation->data = self->allocate(total, alignment, self->user_data);
+        break;
+    }
+    if (!allocation->data) {
+        g_free(allocation);
+        return NULL;
+    }
+
+    if (offset > 0 && (params->flags & GST_MEMORY_FLAG_ZERO_PREFIXED)) {
+        memset(allocation->data, 0, offset);
+    }
+    if (params->padding > 0 && (params->flags & GST_MEMORY_FLAG_ZERO_PADDED)) {
+        memset((guint8*)allocation->data + offset + size, 0, params->padding);
+    }
+
+    allocation->allocator = gst_object_ref(self);
+    GST_OBJECT_LOCK(self);
+    self->allocations++;
+    self->bytes += allocation->size;
+    if (allocation->huge_pages) {
+        self->huge_page_bytes += allocation->size;
+    }
+    GST_OBJECT_UNLOCK(self);
+
+    /* Wrapped system memory maps, shares and copies like any other buffer;
+     * only the backing store and its release are ours. */
+    return gst_memory_new_wrapped(params->flags, allocation->data, total, offset, size, allocation,
+                                  swift_gst_allocation_free);
+}
+
+static void swift_gst_allocator_finalize(GObject* object) {
+    SwiftGstAllocator* self = (SwiftGstAllocator*)object;
+    if (self->destroy) {
+        self->destroy(self->user_data);
+    }
+    G_OBJECT_CLASS(swift_gst_allocator_parent_class)->finalize(object);
+}
+
+static void swift_gst_allocator_class_init(SwiftGstAllocatorClass* klass) {
+    GST_ALLOCATOR_CLASS(klass)->alloc = swift_gst_allocator_alloc;
+    G_OBJECT_CLASS(klass)->finalize = swift_gst_allocator_finalize;
+}
+
+static void swift_gst_allocator_init(SwiftGstAllocator* self) {
+    self->alignment = sizeof(gpointer);
+}
+
+static GstAllocator* swift_gst_allocator_new(SwiftGstMemorySource source, gsize alignment) {
+    SwiftGstAllocator* self = g_object_new(swift_gst_allocator_get_type(), NULL);
+    gst_object_ref_sink(self);
+    self->source = source;
+    self->alignment = MAX(alignment, sizeof(gpointer));
+    return (GstAllocator*)self;
+}
+
+GstAllocator* swift_gst_allocator_new_aligned(gsize alignment) {
+    return swift_gst_allocator_new(SWIFT_GST_MEMORY_ALIGNED, alignment);
+}
+
+GstAllocator* swift_gst_allocator_new_huge_pages(void) {
+    return swift_gst_allocator_new(SWIFT_GST_MEMORY_HUGE_PAGES, SWIFT_GST_HUGE_PAGE_SIZE);
+}
+
+GstAllocator* swift_gst_allocator_new_provided(gsize alignment, SwiftGstAllocateCallback allocate,
+                                               SwiftGstDeallocateCallback deallocate, gpointer user_data,
+                                               GDestroyNotify destroy) {
+    SwiftGstAllocator* self = (SwiftGstAllocator*)swift_gst_allocator_new(SWIFT_GST_MEMORY_PROVIDED, alignment);
+    self->allocate = allocate;
+    self->deallocate = deallocate;
+    self->user_data = user_data;
+    self->destroy = destroy;
+    return (GstAllocator*)self;
+}
+
+void swift_gst_allocator_get_statistics(GstAllocator* allocator, guint64* allocations, guint64* bytes,
+                                        guint64* huge_page_bytes) {
+    SwiftGstAllocator* self = (SwiftGstAllocator*)allocator;
+    GST_OBJECT_LOCK(self);
+    *allocations = self->allocations;
+    *bytes = self->bytes;
+    *huge_page_bytes = self->huge_page_bytes;
+    GST_OBJECT_UNLOCK(self);
+}
+
+GstBuffer* swift_gst_buffer_new_allocate_with(GstAllocator* allocator, gsize size) {
+    return gst_buffer_new_allocate(allocator, size, NULL);
+}
+
+GstBuffer* swift_gst_buffer_new_filled(GstAllocator* allocator, gconstpointer data, gsize size,
+                                       GstClockTime pts, GstClockTime duration) {
+    GstBuffer* buffer = gst_buffer_new_allocate(allocator, size, NULL);
+    if (buffer) {
+        gst_buffer_fill(buffer, 0, data, size);
+        GST_BUFFER_PTS(buffer) = pts;
+        GST_BUFFER_DURATION(buffer) = duration;
+    }
+    return buffer;
+}
+
+// MARK: - Buffer Pools
+
+GstBuffer* swift_gst_buffer_copy_deep_with(GstBuffer* buffer, GstAllocator* allocator) {
+    gsize size = gst_buffer_get_size(buffer);
+    GstBuffer* copy = gst_buffer_new_allocate(allocator, size, NULL);
+    if (!copy) {
+        return NULL;
+    }
+    GstMapInfo info;
+    if (!gst_buffer_map(copy, &info, GST_MAP_WRITE)) {
+        gst_buffer_unref(copy);
+        return NULL;
+    }
+    gst_buffer_extract(buffer, 0, info.data, size);
+    gst_buffer_unmap(copy, &info);
+    // Video metadata (strides, plane offsets) still describes the copied bytes.
+    gst_buffer_copy_into(copy, buffer, GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS | GST_BUFFER_COPY_META, 0,
+                         (gsize)-1);
+    return copy;
+}
+
+GstBufferPool* swift_gst_buffer_get_pool(GstBuffer* buffer) {
+    return buffer->pool;
+}
+
+guint swift_gst_buffer_pool_get_max_buffers(GstBufferPool* pool) {
+    GstStructure* config = gst_buffer_pool_get_config(pool);
+    guint max_buffers = 0;
+    gst_buffer_pool_config_get_params(config, NULL, NULL, NULL, &max_buffers);
+    gst_structure_free(config);
+    return max_buffers;
+}
+
 // MARK: - AppSrc additional functions
 
 void swift_gst_app_src_set_format(GstAppSrc* appsrc, GstFormat format) {
@@ -159,11 +477,5 @@ void swift_gst_app_src_set_latency(GstAppSrc* appsrc, guint64 min, guint64 max)
 }
 
 GstBuffer* swift_gst_buffer_new_wrapped_full(gconstpointer data, gsize size, GstClockTime pts, GstClockTime duration) {
-    GstBuffer* buffer = gst_buffer_new_allocate(NULL, size, NULL);
-    if (buffer) {
-        gst_buffer_fill(buffer, 0, data, size);
-        GST_BUFFER_PTS(buffer) = pts;
-        GST_BUFFER_DURATION(buffer) = duration;
-    }
-    return buffer;
+    return swift_gst_buffer_new_filled(NULL, data, size, pts, duration);
 }
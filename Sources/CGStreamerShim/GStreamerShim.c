@@ -75,6 +75,145 @@ GstState swift_gst_element_get_state(GstElement* element, GstClockTime timeout)
     return state;
 }
 
+typedef struct {
+    gboolean change_state;
+    GstState target;
+    GstClockTime timeout;
+    SwiftGstStateChangeCallback callback;
+    gpointer user_data;
+    GMutex lock;
+    gchar* error_message;
+    gchar* error_source;
+} SwiftGstStateChangeRequest;
+
+static void swift_gst_state_change_request_clear(gpointer data) {
+    SwiftGstStateChangeRequest* request = data;
+    g_mutex_clear(&request->lock);
+    g_free(request->error_message);
+    g_free(request->error_source);
+}
+
+static void swift_gst_state_change_request_release(gpointer data) {
+    g_atomic_rc_box_release_full(data, swift_gst_state_change_request_clear);
+}
+
+static void swift_gst_state_change_request_release_closure(gpointer data, GClosure* closure) {
+    (void)closure;
+    swift_gst_state_change_request_release(data);
+}
+
+static void swift_gst_state_change_on_error(GstBus* bus, GstMessage* message, gpointer data) {
+    (void)bus;
+    SwiftGstStateChangeRequest* request = data;
+    GError* error = NULL;
+    gst_message_parse_error(message, &error, NULL);
+
+    g_mutex_lock(&request->lock);
+    if (!request->error_message) {
+        request->error_message = g_strdup(error ? error->message : "Unknown error");
+        request->error_source = GST_MESSAGE_SRC(message) ? gst_object_get_name(GST_MESSAGE_SRC(message)) : NULL;
+    }
+    g_mutex_unlock(&request->lock);
+
+    g_clear_error(&error);
+}
+
+static gboolean swift_gst_state_change_has_error(SwiftGstStateChangeRequest* request) {
+    g_mutex_lock(&request->lock);
+    gboolean has_error = request->error_message != NULL;
+    g_mutex_unlock(&request->lock);
+    return has_error;
+}
+
+static void swift_gst_state_change_run(GstElement* element, gpointer data) {
+    SwiftGstStateChangeRequest* request = data;
+
+    // sync-message emission runs alongside any sync handler and never pops
+    // the bus, so application consumers still see every message.
+    GstBus* bus = gst_element_get_bus(element);
+    gulong handler = 0;
+    if (bus) {
+        gst_bus_enable_sync_message_emission(bus);
+        handler = g_signal_connect_data(bus, "sync-message::error",
+                                        G_CALLBACK(swift_gst_state_change_on_error),
+                                        g_atomic_rc_box_acquire(request),
+                                        swift_gst_state_change_request_release_closure, 0);
+    }
+
+    GstState current = GST_STATE_VOID_PENDING;
+    GstStateChangeReturn result = request->change_state
+        ? gst_element_set_state(element, request->target)
+        : GST_STATE_CHANGE_ASYNC;
+
+    if (result == GST_STATE_CHANGE_ASYNC) {
+        // Wait in short slices so an error posted during preroll ends the
+        // wait instead of running into the timeout.
+        const gint64 slice = 50 * G_TIME_SPAN_MILLISECOND;
+        gint64 deadline = GST_CLOCK_TIME_IS_VALID(request->timeout)
+            ? g_get_monotonic_time() + (gint64)(request->timeout / GST_USECOND)
+            : G_MAXINT64;
+
+        for (;;) {
+            gint64 remaining = deadline - g_get_monotonic_time();
+            gint64 wait = CLAMP(remaining, 0, slice);
+            result = gst_element_get_state(element, &current, NULL, (GstClockTime)wait * GST_USECOND);
+            if (result != GST_STATE_CHANGE_ASYNC) {
+                break;
+            }
+            if (swift_gst_state_change_has_error(request)) {
+                result = GST_STATE_CHANGE_FAILURE;
+                break;
+            }
+            if (remaining <= 0) {
+                break;
+            }
+        }
+    } else {
+        gst_element_get_state(element, &current, NULL, 0);
+    }
+
+    if (bus) {
+        g_signal_handler_disconnect(bus, handler);
+        gst_bus_disable_sync_message_emission(bus);
+        gst_object_unref(bus);
+    }
+
+    g_mutex_lock(&request->lock);
+    gchar* error_message = g_strdup(request->error_message);
+    gchar* error_source = g_strdup(request->error_source);
+    g_mutex_unlock(&request->lock);
+
+    request->callback(result, current, error_message, error_source, request->user_data);
+
+    g_free(error_message);
+    g_free(error_source);
+}
+
+static void swift_gst_state_change_submit(GstElement* element, gboolean change_state, GstState state,
+                                         GstClockTime timeout, SwiftGstStateChangeCallback callback,
+                                         gpointer user_data) {
+    SwiftGstStateChangeRequest* request = g_atomic_rc_box_new0(SwiftGstStateChangeRequest);
+    request->change_state = change_state;
+    request->target = state;
+    request->timeout = timeout;
+    request->callback = callback;
+    request->user_data = user_data;
+    g_mutex_init(&request->lock);
+
+    gst_element_call_async(element, swift_gst_state_change_run, request,
+                           swift_gst_state_change_request_release);
+}
+
+void swift_gst_element_set_state_async(GstElement* element, GstState state, GstClockTime timeout,
+                                       SwiftGstStateChangeCallback callback, gpointer user_data) {
+    swift_gst_state_change_submit(element, TRUE, state, timeout, callback, user_data);
+}
+
+void swift_gst_element_wait_state_async(GstElement* element, GstClockTime timeout,
+                                        SwiftGstStateChangeCallback callback, gpointer user_data) {
+    swift_gst_state_change_submit(element, FALSE, GST_STATE_VOID_PENDING, timeout, callback, user_data);
+}
+
 GstBus* swift_gst_element_get_bus(GstElement* element) {
     return gst_element_get_bus(element);
 }
@@ -91,6 +230,44 @@ GstMessage* swift_gst_bus_timed_pop_filtered(GstBus* bus, GstClockTime timeout,
     return gst_bus_timed_pop_filtered(bus, timeout, types);
 }
 
+typedef struct {
+    SwiftGstBusSyncObserver observer;
+    gpointer user_data;
+    GDestroyNotify destroy;
+} SwiftGstBusSyncObserverData;
+
+static void swift_gst_bus_sync_observer_trampoline(GstBus* bus, GstMessage* message, gpointer data) {
+    (void)bus;
+    SwiftGstBusSyncObserverData* observer = data;
+    observer->observer(message, observer->user_data);
+}
+
+static void swift_gst_bus_sync_observer_free(gpointer data, GClosure* closure) {
+    (void)closure;
+    SwiftGstBusSyncObserverData* observer = data;
+    if (observer->destroy) {
+        observer->destroy(observer->user_data);
+    }
+    g_free(observer);
+}
+
+gulong swift_gst_bus_add_sync_observer(GstBus* bus, SwiftGstBusSyncObserver observer,
+                                       gpointer user_data, GDestroyNotify destroy) {
+    SwiftGstBusSyncObserverData* data = g_new0(SwiftGstBusSyncObserverData, 1);
+    data->observer = observer;
+    data->user_data = user_data;
+    data->destroy = destroy;
+
+    gst_bus_enable_sync_message_emission(bus);
+    return g_signal_connect_data(bus, "sync-message", G_CALLBACK(swift_gst_bus_sync_observer_trampoline),
+                                 data, swift_gst_bus_sync_observer_free, 0);
+}
+
+void swift_gst_bus_remove_sync_observer(GstBus* bus, gulong handler) {
+    g_signal_handler_disconnect(bus, handler);
+    gst_bus_disable_sync_message_emission(bus);
+}
+
 GstMessageType swift_gst_message_type(GstMessage* message) {
     return GST_MESSAGE_TYPE(message);
 }
@@ -195,6 +372,77 @@ void swift_gst_caps_unref(GstCaps* caps) {
     gst_caps_unref(caps);
 }
 
+GstCaps* swift_gst_caps_ref(GstCaps* caps) {
+    return gst_caps_ref(caps);
+}
+
+GstCaps* swift_gst_caps_copy(GstCaps* caps) {
+    return gst_caps_copy(caps);
+}
+
+void swift_gst_structure_set_int(GstStructure* structure, const gchar* field, gint value) {
+    gst_structure_set(structure, field, G_TYPE_INT, value, NULL);
+}
+
+void swift_gst_structure_set_boolean(GstStructure* structure, const gchar* field, gboolean value) {
+    gst_structure_set(structure, field, G_TYPE_BOOLEAN, value, NULL);
+}
+
+void swift_gst_structure_set_string(GstStructure* structure, const gchar* field, const gchar* value) {
+    gst_structure_set(structure, field, G_TYPE_STRING, value, NULL);
+}
+
+void swift_gst_structure_set_fraction(GstStructure* structure, const gchar* field, gint numerator, gint denominator) {
+    gst_structure_set(structure, field, GST_TYPE_FRACTION, numerator, denominator, NULL);
+}
+
+void swift_gst_structure_set_int_range(GstStructure* structure, const gchar* field, gint min, gint max) {
+    gst_structure_set(structure, field, GST_TYPE_INT_RANGE, min, max, NULL);
+}
+
+void swift_gst_structure_set_fraction_range(GstStructure* structure, const gchar* field,
+                                            gint min_numerator, gint min_denominator,
+                                            gint max_numerator, gint max_denominator) {
+    gst_structure_set(structure, field, GST_TYPE_FRACTION_RANGE,
+                      min_numerator, min_denominator, max_numerator, max_denominator, NULL);
+}
+
+GValue* swift_gst_value_list_new(void) {
+    GValue* list = g_new0(GValue, 1);
+    g_value_init(list, GST_TYPE_LIST);
+    return list;
+}
+
+void swift_gst_value_list_append_int(GValue* list, gint value) {
+    GValue item = G_VALUE_INIT;
+    g_value_init(&item, G_TYPE_INT);
+    g_value_set_int(&item, value);
+    gst_value_list_append_and_take_value(list, &item);
+}
+
+void swift_gst_value_list_append_string(GValue* list, const gchar* value) {
+    GValue item = G_VALUE_INIT;
+    g_value_init(&item, G_TYPE_STRING);
+    g_value_set_string(&item, value);
+    gst_value_list_append_and_take_value(list, &item);
+}
+
+void swift_gst_value_list_append_fraction(GValue* list, gint numerator, gint denominator) {
+    GValue item = G_VALUE_INIT;
+    g_value_init(&item, GST_TYPE_FRACTION);
+    gst_value_set_fraction(&item, numerator, denominator);
+    gst_value_list_append_and_take_value(list, &item);
+}
+
+void swift_gst_structure_take_list(GstStructure* structure, const gchar* field, GValue* list) {
+    gst_structure_take_value(structure, field, list);
+    g_free(list);
+}
+
+void swift_gst_element_set_caps(GstElement* element, const gchar* name, GstCaps* caps) {
+    g_object_set(G_OBJECT(element), name, caps, NULL);
+}
+
 void swift_gst_element_set_bool(GstElement* element, const gchar* name, gboolean value) {
     g_object_set(G_OBJECT(element), name, value, NULL);
 }
@@ -581,3 +829,335 @@ const gchar* swift_gst_element_get_factory_name(GstElement* element) {
 gchar* swift_gst_pad_get_name(GstPad* pad) {
     return gst_pad_get_name(pad);
 }
+
+// MARK: - Plugin Loading
+
+gboolean swift_gst_plugin_load_file(const gchar* path) {
+    GError* error = NULL;
+    GstPlugin* plugin = gst_plugin_load_file(path, &error);
+    if (error) {
+        g_error_free(error);
+    }
+    if (!plugin) {
+        return FALSE;
+    }
+    gst_object_unref(plugin);
+    return TRUE;
+}
+
+gboolean swift_gst_element_factory_preload(const gchar* name) {
+    GstElementFactory* factory = gst_element_factory_find(name);
+    if (!factory) {
+        return FALSE;
+    }
+    GstPluginFeature* loaded = gst_plugin_feature_load(GST_PLUGIN_FEATURE(factory));
+    gst_object_unref(factory);
+    if (!loaded) {
+        return FALSE;
+    }
+    gst_object_unref(loaded);
+    return TRUE;
+}
+
+gboolean swift_g_file_exists(const gchar* path) {
+    return g_file_test(path, G_FILE_TEST_EXISTS);
+}
+
+// MARK: - Segment Tracking
+
+GstElement* swift_gst_bin_find_sink(GstElement* bin) {
+    if (!GST_IS_BIN(bin)) {
+        return NULL;
+    }
+
+    GstIterator* iterator = gst_bin_iterate_sinks(GST_BIN(bin));
+    GValue item = G_VALUE_INIT;
+    GstElement* sink = NULL;
+    if (gst_iterator_next(iterator, &item) == GST_ITERATOR_OK) {
+        sink = GST_ELEMENT(g_value_dup_object(&item));
+        g_value_unset(&item);
+    }
+    gst_iterator_free(iterator);
+    return sink;
+}
+
+typedef struct {
+    SwiftGstSegmentObserver observer;
+    gpointer user_data;
+    GDestroyNotify destroy;
+} SwiftGstSegmentObserverData;
+
+static GstPadProbeReturn swift_gst_segment_probe(GstPad* pad, GstPadProbeInfo* info, gpointer data) {
+    (void)pad;
+    GstEvent* event = GST_PAD_PROBE_INFO_EVENT(info);
+    if (event && GST_EVENT_TYPE(event) == GST_EVENT_SEGMENT) {
+        SwiftGstSegmentObserverData* observer = data;
+        const GstSegment* segment = NULL;
+        gst_event_parse_segment(event, &segment);
+        observer->observer(segment, observer->user_data);
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+static void swift_gst_segment_observer_free(gpointer data) {
+    SwiftGstSegmentObserverData* observer = data;
+    if (observer->destroy) {
+        observer->destroy(observer->user_data);
+    }
+    g_free(observer);
+}
+
+gulong swift_gst_pad_add_segment_observer(GstPad* pad, SwiftGstSegmentObserver observer,
+                                          gpointer user_data, GDestroyNotify destroy) {
+    SwiftGstSegmentObserverData* data = g_new0(SwiftGstSegmentObserverData, 1);
+    data->observer = observer;
+    data->user_data = user_data;
+    data->destroy = destroy;
+
+    gulong id = gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM, swift_gst_segment_probe,
+                                  data, swift_gst_segment_observer_free);
+
+    // A segment that already passed is kept on the pad as a sticky event.
+    GstEvent* sticky = gst_pad_get_sticky_event(pad, GST_EVENT_SEGMENT, 0);
+    if (sticky) {
+        const GstSegment* segment = NULL;
+        gst_event_parse_segment(sticky, &segment);
+        observer(segment, user_data);
+        gst_event_unref(sticky);
+    }
+    return id;
+}
+
+// MARK: - Auto-plugging Hooks
+
+typedef struct {
+    SwiftGstElementAddedCallback callback;
+    gpointer user_data;
+    GDestroyNotify destroy;
+} SwiftGstElementAddedData;
+
+static void swift_gst_deep_element_added(GstBin* bin, GstBin* sub_bin, GstElement* element, gpointer data) {
+    (void)bin;
+    (void)sub_bin;
+    SwiftGstElementAddedData* observer = data;
+    observer->callback(element, observer->user_data);
+}
+
+static void swift_gst_element_added_data_free(gpointer data, GClosure* closure) {
+    (void)closure;
+    SwiftGstElementAddedData* observer = data;
+    if (observer->destroy) {
+        observer->destroy(observer->user_data);
+    }
+    g_free(observer);
+}
+
+void swift_gst_bin_observe_added_elements(GstElement* bin, SwiftGstElementAddedCallback callback,
+                                          gpointer user_data, GDestroyNotify destroy) {
+    SwiftGstElementAddedData* data = g_new0(SwiftGstElementAddedData, 1);
+    data->callback = callback;
+    data->user_data = user_data;
+    data->destroy = destroy;
+
+    // deep-element-added is also emitted for direct children, so it alone
+    // sees every element exactly once. Disconnected when the bin is finalized.
+    g_signal_connect_data(bin, "deep-element-added", G_CALLBACK(swift_gst_deep_element_added),
+                          data, swift_gst_element_added_data_free, 0);
+}
+
+typedef struct {
+    GstElementFactory* factory;
+    gint rank;
+    guint position;
+} SwiftGstRankedFactory;
+
+static gint swift_gst_ranked_factory_compare(gconstpointer a, gconstpointer b) {
+    const SwiftGstRankedFactory* first = a;
+    const SwiftGstRankedFactory* second = b;
+    if (first->rank != second->rank) {
+        return second->rank - first->rank;
+    }
+    return (gint)first->position - (gint)second->position;
+}
+
+G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+static GValueArray* swift_gst_autoplug_sort(GstElement* bin, GstPad* pad, GstCaps* caps,
+                                            GValueArray* factories, gpointer data) {
+    (void)bin;
+    (void)pad;
+    (void)caps;
+    GHashTable* overrides = data;
+
+    GArray* ranked = g_array_sized_new(FALSE, FALSE, sizeof(SwiftGstRankedFactory), factories->n_values);
+    for (guint i = 0; i < factories->n_values; i++) {
+        GstElementFactory* factory = g_value_get_object(g_value_array_get_nth(factories, i));
+        const gchar* name = gst_plugin_feature_get_name(GST_PLUGIN_FEATURE(factory));
+        gint rank = (gint)gst_plugin_feature_get_rank(GST_PLUGIN_FEATURE(factory));
+
+        gpointer override = NULL;
+        if (g_hash_table_lookup_extended(overrides, name, NULL, &override)) {
+            rank = GPOINTER_TO_INT(override);
+            if (rank <= 0) {
+                continue;
+            }
+        }
+
+        SwiftGstRankedFactory entry = { factory, rank, i };
+        g_array_append_val(ranked, entry);
+    }
+    g_array_sort(ranked, swift_gst_ranked_factory_compare);
+
+    GValueArray* result = g_value_array_new(ranked->len);
+    for (guint i = 0; i < ranked->len; i++) {
+        GValue value = G_VALUE_INIT;
+        g_value_init(&value, GST_TYPE_ELEMENT_FACTORY);
+        g_value_set_object(&value, g_array_index(ranked, SwiftGstRankedFactory, i).factory);
+        g_value_array_append(result, &value);
+        g_value_unset(&value);
+    }
+    g_array_free(ranked, TRUE);
+    return result;
+}
+G_GNUC_END_IGNORE_DEPRECATIONS
+
+static void swift_gst_rank_overrides_free(gpointer data, GClosure* closure) {
+    (void)closure;
+    g_hash_table_unref(data);
+}
+
+gboolean swift_gst_decodebin_set_rank_overrides(GstElement* decodebin, const gchar* const* factories,
+                                                const gint* ranks, guint count) {
+    if (g_signal_lookup("autoplug-sort", G_OBJECT_TYPE(decodebin)) == 0) {
+        return FALSE;
+    }
+
+    GHashTable* overrides = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    for (guint i = 0; i < count; i++) {
+        g_hash_table_insert(overrides, g_strdup(factories[i]), GINT_TO_POINTER(ranks[i]));
+    }
+    g_signal_connect_data(decodebin, "autoplug-sort", G_CALLBACK(swift_gst_autoplug_sort),
+                          overrides, swift_gst_rank_overrides_free, 0);
+    return TRUE;
+}
+
+// MARK: - Element Lookup
+
+GstElement* swift_gst_bin_find_by_factory(GstElement* bin, const gchar* factory_name, guint index) {
+    if (!GST_IS_BIN(bin)) {
+        return NULL;
+    }
+
+    GstIterator* iterator = gst_bin_iterate_recurse(GST_BIN(bin));
+    GValue item = G_VALUE_INIT;
+    GstElement* found = NULL;
+    guint seen = 0;
+    gboolean done = FALSE;
+    while (!done) {
+        switch (gst_iterator_next(iterator, &item)) {
+        case GST_ITERATOR_OK: {
+            GstElement* element = g_value_get_object(&item);
+            GstElementFactory* factory = gst_element_get_factory(element);
+            if (factory && g_strcmp0(gst_plugin_feature_get_name(GST_PLUGIN_FEATURE(factory)), factory_name) == 0) {
+                if (seen++ == index) {
+                    found = gst_object_ref(element);
+                    done = TRUE;
+                }
+            }
+            g_value_reset(&item);
+            break;
+        }
+        case GST_ITERATOR_RESYNC:
+            gst_iterator_resync(iterator);
+            seen = 0;
+            break;
+        default:
+            done = TRUE;
+            break;
+        }
+    }
+    if (G_IS_VALUE(&item)) {
+        g_value_unset(&item);
+    }
+    gst_iterator_free(iterator);
+    return found;
+}
+
+GstStructure* swift_gst_element_get_structure(GstElement* element, const gchar* property) {
+    GParamSpec* spec = g_object_class_find_property(G_OBJECT_GET_CLASS(element), property);
+    if (!spec || spec->value_type != GST_TYPE_STRUCTURE) {
+        return NULL;
+    }
+    GstStructure* structure = NULL;
+    g_object_get(element, property, &structure, NULL);
+    return structure;
+}
+
+// MARK: - Flow Monitoring
+
+struct SwiftGstFlowMonitor {
+    GstPad* pad;
+    gulong probe;
+    gint buffers;
+    gint eos;
+};
+
+static GstPadProbeReturn swift_gst_flow_probe(GstPad* pad, GstPadProbeInfo* info, gpointer data) {
+    (void)pad;
+    SwiftGstFlowMonitor* monitor = data;
+    if (info->type & (GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST)) {
+        g_atomic_int_inc(&monitor->buffers);
+    } else if (info->type & GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM) {
+        switch (GST_EVENT_TYPE(GST_PAD_PROBE_INFO_EVENT(info))) {
+        case GST_EVENT_EOS:
+            g_atomic_int_set(&monitor->eos, 1);
+            break;
+        case GST_EVENT_FLUSH_STOP:
+        case GST_EVENT_STREAM_START:
+            g_atomic_int_set(&monitor->eos, 0);
+            break;
+        default:
+            break;
+        }
+    }
+    return GST_PAD_PROBE_OK;
+}
+
+SwiftGstFlowMonitor* swift_gst_pad_monitor_flow(GstPad* pad) {
+    // Shared by the caller and the probe; whichever lets go last frees it.
+    SwiftGstFlowMonitor* monitor = g_atomic_rc_box_new0(SwiftGstFlowMonitor);
+    monitor->pad = gst_object_ref(pad);
+    monitor->probe = gst_pad_add_probe(
+        pad, GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST | GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+        swift_gst_flow_probe, g_atomic_rc_box_acquire(monitor), (GDestroyNotify)g_atomic_rc_box_release);
+    return monitor;
+}
+
+guint swift_gst_flow_monitor_buffers(SwiftGstFlowMonitor* monitor) {
+    return (guint)g_atomic_int_get(&monitor->buffers);
+}
+
+gboolean swift_gst_flow_monitor_is_eos(SwiftGstFlowMonitor* monitor) {
+    return g_atomic_int_get(&monitor->eos) != 0;
+}
+
+void swift_gst_flow_monitor_free(SwiftGstFlowMonitor* monitor) {
+    gst_pad_remove_probe(monitor->pad, monitor->probe);
+    gst_object_unref(monitor->pad);
+    g_atomic_rc_box_release(monitor);
+}
+
+GstElement* swift_gst_bin_find_source(GstElement* bin) {
+    if (!GST_IS_BIN(bin)) {
+        return NULL;
+    }
+
+    GstIterator* iterator = gst_bin_iterate_sources(GST_BIN(bin));
+    GValue item = G_VALUE_INIT;
+    GstElement* source = NULL;
+    if (gst_iterator_next(iterator, &item) == GST_ITERATOR_OK) {
+        source = GST_ELEMENT(g_value_dup_object(&item));
+        g_value_unset(&item);
+    }
+    gst_iterator_free(iterator);
+    return source;
+}
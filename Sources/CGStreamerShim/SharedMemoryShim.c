@@ -0,0 +1,294 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "include/SharedMemoryShim.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// MARK: - Segments
+
+int swift_shm_segment_create(gsize size) {
+#ifdef __linux__
+    int fd = memfd_create("swift-gst-frames", MFD_CLOEXEC);
+#else
+    // No memfd: create a uniquely named object and unlink it at once so
+    // only descriptors keep it alive.
+    static gint counter = 0;
+    gchar* name = g_strdup_printf("/swift-gst-%d-%d", (int)getpid(), g_atomic_int_add(&counter, 1));
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+        shm_unlink(name);
+    }
+    g_free(name);
+#endif
+    if (fd < 0) {
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void* swift_shm_segment_map(int fd, gsize size, gboolean writable) {
+    int protection = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void* address = mmap(NULL, size, protection, MAP_SHARED, fd, 0);
+    return address == MAP_FAILED ? NULL : address;
+}
+
+void swift_shm_segment_unmap(void* address, gsize size) {
+    if (address) {
+        munmap(address, size);
+    }
+}
+
+gsize swift_shm_page_size(void) {
+    return (gsize)sysconf(_SC_PAGESIZE);
+}
+
+// MARK: - Control Socket
+
+static gboolean swift_shm_fill_address(const gchar* path, struct sockaddr_un* address) {
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address->sun_path)) {
+        return FALSE;
+    }
+    strncpy(address->sun_path, path, sizeof(address->sun_path) - 1);
+    return TRUE;
+}
+
+static int swift_shm_socket(void) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    return fd;
+}
+
+int swift_shm_listen(const gchar* path) {
+    struct sockaddr_un address;
+    if (!swift_shm_fill_address(path, &address)) {
+        return -1;
+    }
+    int fd = swift_shm_socket();
+    if (fd < 0) {
+        return -1;
+    }
+    unlink(path);
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 1) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static gint swift_shm_wait_readable(int fd, gint timeout_ms) {
+    struct pollfd poll_fd = { .fd = fd, .events = POLLIN };
+    int result;
+    do {
+        result = poll(&poll_fd, 1, timeout_ms);
+    } while (result < 0 && errno == EINTR);
+    return result;
+}
+
+int swift_shm_accept(int listen_fd, gint timeout_ms) {
+    gint ready = swift_shm_wait_readable(listen_fd, timeout_ms);
+    if (ready == 0) {
+        return -2;
+    }
+    if (ready < 0) {
+        return -1;
+    }
+    int fd = accept(listen_fd, NULL, NULL);
+    if (fd >= 0) {
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    }
+    return fd;
+}
+
+int swift_shm_connect(const gchar* path) {
+    struct sockaddr_un address;
+    if (!swift_shm_fill_address(path, &address)) {
+        return -1;
+    }
+    int fd = swift_shm_socket();
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+gboolean swift_shm_send(int socket_fd, const SwiftShmMessage* message, int fd, const void* payload,
+                        gsize payload_size) {
+    struct iovec parts[2] = {
+        { .iov_base = (void*)message, .iov_len = sizeof(*message) },
+        { .iov_base = (void*)payload, .iov_len = payload ? payload_size : 0 },
+    };
+    struct msghdr header = { 0 };
+    header.msg_iov = parts;
+    header.msg_iovlen = payload_size > 0 && payload ? 2 : 1;
+
+    char control[CMSG_SPACE(sizeof(int))];
+    if (fd >= 0) {
+        memset(control, 0, sizeof(control));
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+        struct cmsghdr* descriptor = CMSG_FIRSTHDR(&header);
+        descriptor->cmsg_level = SOL_SOCKET;
+        descriptor->cmsg_type = SCM_RIGHTS;
+        descriptor->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(descriptor), &fd, sizeof(int));
+    }
+
+    // Stream sockets may take a message in pieces; the descriptor goes with
+    // the first piece only.
+    while (header.msg_iovlen > 0) {
+        ssize_t sent = sendmsg(socket_fd, &header, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return FALSE;
+        }
+        header.msg_control = NULL;
+        header.msg_controllen = 0;
+        while (header.msg_iovlen > 0 && (size_t)sent >= header.msg_iov[0].iov_len) {
+            sent -= (ssize_t)header.msg_iov[0].iov_len;
+            header.msg_iov++;
+            header.msg_iovlen--;
+        }
+        if (header.msg_iovlen > 0) {
+            header.msg_iov[0].iov_base = (char*)header.msg_iov[0].iov_base + sent;
+            header.msg_iov[0].iov_len -= (size_t)sent;
+        }
+    }
+    return TRUE;
+}
+
+/// Read exactly size bytes, collecting a passed descriptor if one arrives.
+static gboolean swift_shm_read_exact(int socket_fd, void* data, gsize size, int* fd) {
+    gsize received = 0;
+    while (received < size) {
+        struct iovec part = { .iov_base = (char*)data + received, .iov_len = size - received };
+        char control[CMSG_SPACE(sizeof(int))];
+        struct msghdr header = { 0 };
+        header.msg_iov = &part;
+        header.msg_iovlen = 1;
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+
+        ssize_t count = recvmsg(socket_fd, &header, 0);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return FALSE;
+        }
+        for (struct cmsghdr* descriptor = CMSG_FIRSTHDR(&header); descriptor;
+             descriptor = CMSG_NXTHDR(&header, descriptor)) {
+            if (descriptor->cmsg_level == SOL_SOCKET && descriptor->cmsg_type == SCM_RIGHTS) {
+                int passed;
+                memcpy(&passed, CMSG_DATA(descriptor), sizeof(int));
+                if (fd && *fd < 0) {
+                    *fd = passed;
+                } else {
+                    close(passed);
+                }
+            }
+        }
+        received += (gsize)count;
+    }
+    return TRUE;
+}
+
+gint swift_shm_receive(int socket_fd, SwiftShmMessage* message, int* fd, gchar* payload,
+                       gsize payload_capacity, gint timeout_ms) {
+    if (fd) {
+        *fd = -1;
+    }
+    gint ready = swift_shm_wait_readable(socket_fd, timeout_ms);
+    if (ready == 0) {
+        return 0;
+    }
+    if (ready < 0 || !swift_shm_read_exact(socket_fd, message, sizeof(*message), fd)) {
+        return -1;
+    }
+
+    // The sender writes whole messages, so the payload is already on its way.
+    gsize length = message->caps_length;
+    gsize kept = payload && payload_capacity > 0 ? MIN(length, payload_capacity - 1) : 0;
+    if (kept > 0 && !swift_shm_read_exact(socket_fd, payload, kept, NULL)) {
+        return -1;
+    }
+    if (payload && payload_capacity > 0) {
+        payload[kept] = '\0';
+    }
+    char discard[256];
+    for (gsize left = length - kept; left > 0;) {
+        gsize chunk = MIN(left, sizeof(discard));
+        if (!swift_shm_read_exact(socket_fd, discard, chunk, NULL)) {
+            return -1;
+        }
+        left -= chunk;
+    }
+    return 1;
+}
+
+void swift_shm_close(int fd) {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+void swift_shm_unlink(const gchar* path) {
+    unlink(path);
+}
+
+// MARK: - Threads
+
+typedef struct {
+    SwiftShmThreadFunc func;
+    gpointer user_data;
+} SwiftShmThread;
+
+static gpointer swift_shm_thread_main(gpointer data) {
+    SwiftShmThread* thread = data;
+    thread->func(thread->user_data);
+    g_free(thread);
+    return NULL;
+}
+
+void swift_shm_thread_start(const gchar* name, SwiftShmThreadFunc func, gpointer user_data) {
+    SwiftShmThread* thread = g_new(SwiftShmThread, 1);
+    thread->func = func;
+    thread->user_data = user_data;
+    // Detached: nobody joins, the thread frees its own bookkeeping.
+    g_thread_unref(g_thread_new(name, swift_shm_thread_main, thread));
+}
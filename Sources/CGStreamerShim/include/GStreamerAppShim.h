@@ -17,6 +17,9 @@ GstSample* swift_gst_app_sink_pull_sample(GstAppSink* appsink);
 /// Try to pull a sample from appsink (non-blocking)
 GstSample* swift_gst_app_sink_try_pull_sample(GstAppSink* appsink, GstClockTime timeout);
 
+/// Try to pull the preroll sample from appsink (non-blocking)
+GstSample* swift_gst_app_sink_try_pull_preroll(GstAppSink* appsink, GstClockTime timeout);
+
 /// Check if appsink is at EOS
 gboolean swift_gst_app_sink_is_eos(GstAppSink* appsink);
 
@@ -35,6 +38,9 @@ void swift_gst_app_sink_set_max_buffers(GstAppSink* appsink, guint max);
 /// Set appsink drop property
 void swift_gst_app_sink_set_drop(GstAppSink* appsink, gboolean drop);
 
+/// Get a sink's last-sample property (NULL if disabled, empty or not a sink)
+GstSample* swift_gst_base_sink_get_last_sample(GstElement* sink);
+
 // MARK: - AppSrc
 
 /// Push a buffer to appsrc
@@ -116,6 +122,93 @@ GstClockTime swift_gst_clock_time_none(void);
 /// Get GST_SECOND value (nanoseconds per second)
 GstClockTime swift_gst_second(void);
 
+// MARK: - Buffer Flags and Regions
+
+/// Whether the buffer is marked GST_BUFFER_FLAG_DELTA_UNIT (not decodable on its own)
+gboolean swift_gst_buffer_is_delta_unit(GstBuffer* buffer);
+
+/// Create a buffer covering part of another, sharing its memory (no copy)
+/// Flags and timestamps are copied; returns NULL if the region is out of range
+GstBuffer* swift_gst_buffer_share_region(GstBuffer* buffer, gsize offset, gsize size);
+
+/// Whether the buffer may be modified in place (a single reference)
+gboolean swift_gst_buffer_is_writable(GstBuffer* buffer);
+
+/// Consume a reference and return a writable buffer: the same buffer when it
+/// has no other references, else a copy sharing its memory
+GstBuffer* swift_gst_buffer_make_writable(GstBuffer* buffer);
+
+/// Create a buffer with no memory
+GstBuffer* swift_gst_buffer_new_empty(void);
+
+/// Number of memory blocks in the buffer
+guint swift_gst_buffer_n_memory(GstBuffer* buffer);
+
+/// Largest number of memory blocks a buffer holds before GStreamer merges them into one
+guint swift_gst_buffer_get_max_memory(void);
+
+/// Add the memory blocks of source to the end (or start) of a writable buffer, sharing them
+void swift_gst_buffer_add_memories(GstBuffer* buffer, GstBuffer* source, gboolean prepend);
+
+/// Borrow the codec_data buffer from the first structure of caps, or NULL
+GstBuffer* swift_gst_caps_get_codec_data(GstCaps* caps);
+
+// MARK: - Allocators
+
+/// Where a Swift allocator takes its memory from
+typedef enum {
+    /// posix_memalign with the allocator's alignment
+    SWIFT_GST_MEMORY_ALIGNED = 0,
+    /// Anonymous mappings backed by huge pages (MAP_HUGETLB, else transparent huge pages)
+    SWIFT_GST_MEMORY_HUGE_PAGES = 1,
+    /// Caller-supplied allocate/deallocate callbacks
+    SWIFT_GST_MEMORY_PROVIDED = 2,
+} SwiftGstMemorySource;
+
+/// Callback returning at least size bytes aligned to alignment, or NULL
+typedef gpointer (*SwiftGstAllocateCallback)(gsize size, gsize alignment, gpointer user_data);
+
+/// Callback returning memory obtained from SwiftGstAllocateCallback
+typedef void (*SwiftGstDeallocateCallback)(gpointer data, gsize size, gpointer user_data);
+
+/// Create an allocator whose memory starts on an alignment-byte boundary (a power of two)
+GstAllocator* swift_gst_allocator_new_aligned(gsize alignment);
+
+/// Create an allocator backed by 2 MiB huge pages
+/// Uses reserved hugetlbfs pages when available, otherwise a 2 MiB-aligned mapping
+/// advised with MADV_HUGEPAGE. Every allocation is rounded up to whole huge pages.
+GstAllocator* swift_gst_allocator_new_huge_pages(void);
+
+/// Create an allocator that takes memory from callbacks
+/// destroy is called with user_data when the allocator and all of its memory are gone
+GstAllocator* swift_gst_allocator_new_provided(gsize alignment, SwiftGstAllocateCallback allocate,
+                                               SwiftGstDeallocateCallback deallocate, gpointer user_data,
+                                               GDestroyNotify destroy);
+
+/// Allocation counters: live allocations, live bytes, and live bytes on reserved huge pages
+void swift_gst_allocator_get_statistics(GstAllocator* allocator, guint64* allocations, guint64* bytes,
+                                        guint64* huge_page_bytes);
+
+/// Create a buffer of size bytes from an allocator (NULL for the system allocator)
+GstBuffer* swift_gst_buffer_new_allocate_with(GstAllocator* allocator, gsize size);
+
+/// Create a buffer from an allocator (NULL for the system allocator) holding a copy of data,
+/// with PTS and duration set
+GstBuffer* swift_gst_buffer_new_filled(GstAllocator* allocator, gconstpointer data, gsize size,
+                                       GstClockTime pts, GstClockTime duration);
+
+// MARK: - Buffer Pools
+
+/// Copy a buffer into new memory from an allocator (NULL for the system allocator)
+/// Flags, timestamps and metadata are copied; the copy shares nothing with buffer
+GstBuffer* swift_gst_buffer_copy_deep_with(GstBuffer* buffer, GstAllocator* allocator);
+
+/// Borrow the pool a buffer came from, or NULL
+GstBufferPool* swift_gst_buffer_get_pool(GstBuffer* buffer);
+
+/// Maximum number of buffers a pool hands out (0 = unlimited)
+guint swift_gst_buffer_pool_get_max_buffers(GstBufferPool* pool);
+
 // MARK: - AppSrc additional functions
 
 /// Set appsrc format
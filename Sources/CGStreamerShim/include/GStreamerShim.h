@@ -42,6 +42,23 @@ GstStateChangeReturn swift_gst_element_set_state(GstElement* element, GstState s
 /// Get pipeline state
 GstState swift_gst_element_get_state(GstElement* element, GstClockTime timeout);
 
+/// Completion callback for swift_gst_element_set_state_async
+/// result is GST_STATE_CHANGE_ASYNC if the timeout expired; error_message and
+/// error_source describe the first bus error seen during the change, if any
+typedef void (*SwiftGstStateChangeCallback)(GstStateChangeReturn result, GstState current,
+                                            const gchar* error_message, const gchar* error_source,
+                                            gpointer user_data);
+
+/// Change state on GStreamer's thread pool and wait there for async completion
+/// Bus messages are observed via sync-message emission, so none are consumed
+void swift_gst_element_set_state_async(GstElement* element, GstState state, GstClockTime timeout,
+                                       SwiftGstStateChangeCallback callback, gpointer user_data);
+
+/// Wait on GStreamer's thread pool for a pending async state change (e.g. the
+/// preroll after a flushing seek) without requesting a new state
+void swift_gst_element_wait_state_async(GstElement* element, GstClockTime timeout,
+                                        SwiftGstStateChangeCallback callback, gpointer user_data);
+
 /// Get the bus from an element
 GstBus* swift_gst_element_get_bus(GstElement* element);
 
@@ -54,6 +71,19 @@ GstMessage* swift_gst_bus_timed_pop(GstBus* bus, GstClockTime timeout);
 /// Pop a message from the bus filtered by type
 GstMessage* swift_gst_bus_timed_pop_filtered(GstBus* bus, GstClockTime timeout, GstMessageType types);
 
+/// Callback for swift_gst_bus_add_sync_observer
+/// Runs on the thread that posted the message; the message is borrowed
+typedef void (*SwiftGstBusSyncObserver)(GstMessage* message, gpointer user_data);
+
+/// Observe every message as it is posted, without removing it from the bus
+/// destroy is called with user_data once the observer is removed
+/// Returns a handler id for swift_gst_bus_remove_sync_observer
+gulong swift_gst_bus_add_sync_observer(GstBus* bus, SwiftGstBusSyncObserver observer,
+                                       gpointer user_data, GDestroyNotify destroy);
+
+/// Remove an observer added with swift_gst_bus_add_sync_observer
+void swift_gst_bus_remove_sync_observer(GstBus* bus, gulong handler);
+
 /// Get message type
 GstMessageType swift_gst_message_type(GstMessage* message);
 
@@ -93,6 +123,50 @@ gchar* swift_gst_caps_to_string(GstCaps* caps);
 /// Unref caps
 void swift_gst_caps_unref(GstCaps* caps);
 
+/// Add a reference to caps
+GstCaps* swift_gst_caps_ref(GstCaps* caps);
+
+/// Create a writable copy of caps
+GstCaps* swift_gst_caps_copy(GstCaps* caps);
+
+/// Set a structure field (integer)
+void swift_gst_structure_set_int(GstStructure* structure, const gchar* field, gint value);
+
+/// Set a structure field (boolean)
+void swift_gst_structure_set_boolean(GstStructure* structure, const gchar* field, gboolean value);
+
+/// Set a structure field (string)
+void swift_gst_structure_set_string(GstStructure* structure, const gchar* field, const gchar* value);
+
+/// Set a structure field (fraction)
+void swift_gst_structure_set_fraction(GstStructure* structure, const gchar* field, gint numerator, gint denominator);
+
+/// Set a structure field (integer range, inclusive)
+void swift_gst_structure_set_int_range(GstStructure* structure, const gchar* field, gint min, gint max);
+
+/// Set a structure field (fraction range, inclusive)
+void swift_gst_structure_set_fraction_range(GstStructure* structure, const gchar* field,
+                                            gint min_numerator, gint min_denominator,
+                                            gint max_numerator, gint max_denominator);
+
+/// Allocate an empty GST_TYPE_LIST value (free with swift_gst_structure_take_list)
+GValue* swift_gst_value_list_new(void);
+
+/// Append an integer to a list value
+void swift_gst_value_list_append_int(GValue* list, gint value);
+
+/// Append a string to a list value
+void swift_gst_value_list_append_string(GValue* list, const gchar* value);
+
+/// Append a fraction to a list value
+void swift_gst_value_list_append_fraction(GValue* list, gint numerator, gint denominator);
+
+/// Set a structure field to a list value, consuming and freeing the list
+void swift_gst_structure_take_list(GstStructure* structure, const gchar* field, GValue* list);
+
+/// Set element property (GstCaps); the element takes its own reference
+void swift_gst_element_set_caps(GstElement* element, const gchar* name, GstCaps* caps);
+
 /// Set element property (boolean)
 void swift_gst_element_set_bool(GstElement* element, const gchar* name, gboolean value);
 
@@ -366,6 +440,83 @@ const gchar* swift_gst_element_get_factory_name(GstElement* element);
 /// Get pad name (caller must g_free)
 gchar* swift_gst_pad_get_name(GstPad* pad);
 
+// MARK: - Plugin Loading
+
+/// Load a plugin file into the default registry
+/// Returns TRUE on success
+gboolean swift_gst_plugin_load_file(const gchar* path);
+
+/// Load the plugin that provides an element factory without creating an element
+/// Returns TRUE if the factory exists and its plugin is loaded
+gboolean swift_gst_element_factory_preload(const gchar* name);
+
+/// Check whether a file exists
+gboolean swift_g_file_exists(const gchar* path);
+
+// MARK: - Segment Tracking
+
+/// Find the first sink element in a bin (caller must unref), or NULL
+GstElement* swift_gst_bin_find_sink(GstElement* bin);
+
+/// Callback for swift_gst_pad_add_segment_observer
+/// Runs on the streaming thread; the segment is borrowed
+typedef void (*SwiftGstSegmentObserver)(const GstSegment* segment, gpointer user_data);
+
+/// Observe SEGMENT events flowing downstream through a pad
+/// The pad's current sticky segment, if any, is reported immediately
+/// destroy is called with user_data once the probe is removed
+/// Returns the probe id for gst_pad_remove_probe
+gulong swift_gst_pad_add_segment_observer(GstPad* pad, SwiftGstSegmentObserver observer,
+                                          gpointer user_data, GDestroyNotify destroy);
+
+// MARK: - Auto-plugging Hooks
+
+/// Callback for swift_gst_bin_observe_added_elements
+/// Runs on the thread that added the element; the element is borrowed
+typedef void (*SwiftGstElementAddedCallback)(GstElement* element, gpointer user_data);
+
+/// Call back once for every element added to a bin or any bin inside it
+/// (deep-element-added), before the element changes state
+/// destroy is called with user_data when the bin is finalized
+void swift_gst_bin_observe_added_elements(GstElement* bin, SwiftGstElementAddedCallback callback,
+                                          gpointer user_data, GDestroyNotify destroy);
+
+/// Reorder a (uri)decodebin's auto-plugging candidates by overridden ranks
+/// Factories not listed keep their registry rank; a rank of 0 removes the factory
+/// Returns FALSE if the element has no autoplug-sort signal (e.g. decodebin3)
+gboolean swift_gst_decodebin_set_rank_overrides(GstElement* decodebin, const gchar* const* factories,
+                                                const gint* ranks, guint count);
+
+// MARK: - Element Lookup
+
+/// Find the nth element created by a factory anywhere inside a bin,
+/// searching nested bins (caller must unref), or NULL
+GstElement* swift_gst_bin_find_by_factory(GstElement* bin, const gchar* factory_name, guint index);
+
+/// Get a copy of a GstStructure-typed property (caller must free with gst_structure_free), or NULL
+GstStructure* swift_gst_element_get_structure(GstElement* element, const gchar* property);
+
+// MARK: - Flow Monitoring
+
+/// Counts buffers passing a pad; see swift_gst_pad_monitor_flow
+typedef struct SwiftGstFlowMonitor SwiftGstFlowMonitor;
+
+/// Start counting buffers and buffer lists on a pad
+/// The monitor keeps a reference to the pad; free with swift_gst_flow_monitor_free
+SwiftGstFlowMonitor* swift_gst_pad_monitor_flow(GstPad* pad);
+
+/// Number of buffers seen so far (wraps around)
+guint swift_gst_flow_monitor_buffers(SwiftGstFlowMonitor* monitor);
+
+/// Whether EOS has passed the pad since the last flush or stream start
+gboolean swift_gst_flow_monitor_is_eos(SwiftGstFlowMonitor* monitor);
+
+/// Remove the probe and release the monitor
+void swift_gst_flow_monitor_free(SwiftGstFlowMonitor* monitor);
+
+/// Find the first source element in a bin (caller must unref), or NULL
+GstElement* swift_gst_bin_find_source(GstElement* bin);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,93 @@
+#ifndef SHARED_MEMORY_SHIM_H
+#define SHARED_MEMORY_SHIM_H
+
+#include <glib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MARK: - Messages
+
+/// Message kinds exchanged over the control socket
+typedef enum {
+    /// Publisher -> subscriber, carries the segment fd: slot_count in slot, slot_size in size
+    SWIFT_SHM_MESSAGE_HELLO = 1,
+    /// Publisher -> subscriber, followed by caps_length bytes of caps string
+    SWIFT_SHM_MESSAGE_CAPS = 2,
+    /// Publisher -> subscriber, a filled slot
+    SWIFT_SHM_MESSAGE_FRAME = 3,
+    /// Subscriber -> publisher, a slot may be reused
+    SWIFT_SHM_MESSAGE_RELEASE = 4,
+    /// Publisher -> subscriber, no more frames
+    SWIFT_SHM_MESSAGE_EOS = 5,
+} SwiftShmMessageKind;
+
+/// Fixed-size control message; frame data stays in the shared segment
+typedef struct {
+    guint32 kind;
+    guint32 slot;
+    guint64 size;
+    guint64 pts;
+    guint64 dts;
+    guint64 duration;
+    guint64 sequence;
+    guint32 flags;
+    guint32 caps_length;
+} SwiftShmMessage;
+
+// MARK: - Segments
+
+/// Create an anonymous shared memory segment of size bytes
+/// Returns a file descriptor, or -1 (memfd on Linux, unlinked shm_open elsewhere)
+int swift_shm_segment_create(gsize size);
+
+/// Map a segment read-write (publisher) or read-only (subscriber), or NULL
+void* swift_shm_segment_map(int fd, gsize size, gboolean writable);
+
+/// Unmap a segment
+void swift_shm_segment_unmap(void* address, gsize size);
+
+/// Page size used to align slots
+gsize swift_shm_page_size(void);
+
+// MARK: - Control Socket
+
+/// Listen on a Unix socket path, replacing a stale socket file; returns fd or -1
+int swift_shm_listen(const gchar* path);
+
+/// Accept a connection, waiting at most timeout_ms; returns fd, -1 on error, -2 on timeout
+int swift_shm_accept(int listen_fd, gint timeout_ms);
+
+/// Connect to a Unix socket path; returns fd or -1
+int swift_shm_connect(const gchar* path);
+
+/// Send a message, with a file descriptor attached when fd >= 0, and extra payload bytes
+gboolean swift_shm_send(int socket_fd, const SwiftShmMessage* message, int fd, const void* payload,
+                        gsize payload_size);
+
+/// Receive a message, waiting at most timeout_ms
+/// A received descriptor is stored in fd (or -1); payload (caps) is written up to payload_capacity
+/// and NUL-terminated. Returns 1 on success, 0 on timeout, -1 when the peer closed or on error
+gint swift_shm_receive(int socket_fd, SwiftShmMessage* message, int* fd, gchar* payload,
+                       gsize payload_capacity, gint timeout_ms);
+
+/// Close a descriptor
+void swift_shm_close(int fd);
+
+/// Remove a socket file
+void swift_shm_unlink(const gchar* path);
+
+// MARK: - Threads
+
+/// Body of a thread started with swift_shm_thread_start
+typedef void (*SwiftShmThreadFunc)(gpointer user_data);
+
+/// Run func(user_data) on a new detached thread, so blocking socket waits stay off the caller's threads
+void swift_shm_thread_start(const gchar* name, SwiftShmThreadFunc func, gpointer user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHARED_MEMORY_SHIM_H */
@@ -0,0 +1,185 @@
+import CGStreamer
+import CGStreamerShim
+import Synchronization
+
+/// Frames an ``AppSink`` has handed out that may still hold upstream buffers.
+internal struct FrameTracker {
+    struct Entry {
+        weak var storage: VideoFrame.Storage?
+        let handedOut: ContinuousClock.Instant
+    }
+
+    var entries: [Entry] = []
+    var policy: AppSink.DetachPolicy?
+    var task: Task<Void, Never>?
+    var pressure = AppSink.PoolPressure()
+    /// Address of the pool the last frame came from, to notice a new pool.
+    var pool: UInt = 0
+
+    /// Forget frames that are gone or no longer hold an upstream buffer.
+    mutating func prune() {
+        entries.removeAll { entry in
+            guard let storage = entry.storage else { return true }
+            return storage.isDetached
+        }
+        pressure.outstanding = entries.count
+    }
+}
+
+extension AppSink {
+    /// How many upstream buffers the application is holding through frames.
+    ///
+    /// Cameras and decoders allocate from small pools. When the frames the
+    /// application holds account for the whole pool, the upstream element
+    /// blocks and capture stalls. Watch ``outstanding`` against
+    /// ``poolCapacity``, or let ``setDetachPolicy(_:)`` copy frames off the
+    /// pool before that happens.
+    public struct PoolPressure: Sendable, Hashable {
+        /// Frames handed out and alive that still hold an upstream buffer.
+        public var outstanding = 0
+        /// Most frames outstanding at once.
+        public var peakOutstanding = 0
+        /// Size of the upstream pool the latest frame came from, when the
+        /// pool is bounded.
+        public var poolCapacity: Int?
+        /// Frames copied off the pool by the detach policy.
+        public var detached = 0
+        /// Bytes copied by the detach policy.
+        public var detachedBytes = 0
+        /// Detach attempts that failed because the copy couldn't be
+        /// allocated, typically because the policy's arena is full. A frame
+        /// is retried, and counted again, on every check.
+        public var detachFailures = 0
+
+        /// Fraction of the upstream pool held by the application, when the
+        /// pool is bounded.
+        public var utilization: Double? {
+            poolCapacity.map { Double(outstanding) / Double($0) }
+        }
+    }
+
+    /// When to copy held frames off upstream buffers.
+    public struct DetachPolicy: Sendable {
+        /// How long a frame may hold its upstream buffer.
+        public var after: Duration
+        /// Memory for the copies, or `nil` for the system allocator.
+        public var arena: FrameArena?
+
+        /// Create a policy.
+        ///
+        /// - Parameters:
+        ///   - after: How long a frame may hold its upstream buffer. Frames
+        ///     processed and released within this time are never copied.
+        ///   - arena: Memory for the copies, or `nil` for the system allocator.
+        public init(after: Duration, arena: FrameArena? = nil) {
+            self.after = after
+            self.arena = arena
+        }
+    }
+
+    /// Current pool pressure counters.
+    public var poolPressure: PoolPressure {
+        frameTracker.withLock {
+            $0.prune()
+            return $0.pressure
+        }
+    }
+
+    /// Copy frames held past a deadline off their upstream buffers.
+    ///
+    /// Frames from this sink are checked in the background. One that is
+    /// still alive `policy.after` after it was handed out is copied, into
+    /// the policy's arena if it has one, and the upstream buffer goes back
+    /// to its pool. The frame value is unchanged for its holder: the same
+    /// pixels, timestamps and metadata, now in memory of its own.
+    ///
+    /// A frame is never swapped while its bytes are being accessed; it is
+    /// retried on the next check. Frames whose buffer was handed to other
+    /// GStreamer APIs by pointer are left alone.
+    ///
+    /// ```swift
+    /// let arena = FrameArena(capacity: 90 * 1920 * 1080 * 4)
+    /// sink.setDetachPolicy(AppSink.DetachPolicy(after: .milliseconds(250), arena: arena))
+    ///
+    /// // Keep a three-second window without starving the camera
+    /// for await frame in sink.frames() {
+    ///     window.append(frame)
+    ///     if window.count > 90 { window.removeFirst() }
+    /// }
+    /// ```
+    ///
+    /// - Parameter policy: The policy, or `nil` to stop detaching frames.
+    public func setDetachPolicy(_ policy: DetachPolicy?) {
+        let task = policy.map { policy in
+            // Check often enough that no frame overstays by more than a quarter.
+            let interval = max(policy.after / 4, .milliseconds(5))
+            return Task.detached { [weak self] in
+                while !Task.isCancelled {
+                    try? await Task.sleep(for: interval)
+                    guard let self else { return }
+                    self.detachExpiredFrames()
+                }
+            }
+        }
+        let previous = frameTracker.withLock { tracker -> Task<Void, Never>? in
+            defer {
+                tracker.policy = policy
+                tracker.task = task
+            }
+            return tracker.task
+        }
+        previous?.cancel()
+    }
+
+    /// Record a frame as handed out.
+    internal func track(_ frame: VideoFrame, pool: UnsafeMutablePointer<GstBufferPool>?) {
+        let now = ContinuousClock.now
+        let address = UInt(bitPattern: pool)
+        frameTracker.withLock { tracker in
+            if address != tracker.pool {
+                tracker.pool = address
+                let capacity = pool.map { Int(swift_gst_buffer_pool_get_max_buffers($0)) } ?? 0
+                tracker.pressure.poolCapacity = capacity > 0 ? capacity : nil
+            }
+            tracker.prune()
+            tracker.entries.append(FrameTracker.Entry(storage: frame.storage, handedOut: now))
+            tracker.pressure.outstanding = tracker.entries.count
+            tracker.pressure.peakOutstanding = max(tracker.pressure.peakOutstanding, tracker.entries.count)
+        }
+    }
+
+    /// Detach every frame held longer than the policy allows.
+    internal func detachExpiredFrames() {
+        let now = ContinuousClock.now
+        let (expired, policy) = frameTracker.withLock { tracker -> ([VideoFrame.Storage], DetachPolicy?) in
+            guard let policy = tracker.policy else { return ([], nil) }
+            let expired = tracker.entries.compactMap { entry in
+                entry.handedOut.advanced(by: policy.after) <= now ? entry.storage : nil
+            }
+            return (expired, policy)
+        }
+        guard let policy, !expired.isEmpty else { return }
+
+        var detached = 0
+        var bytes = 0
+        var failures = 0
+        for storage in expired {
+            switch storage.detach(allocator: policy.arena?.allocator) {
+            case .detached(let size):
+                detached += 1
+                bytes += size
+            case .failed:
+                failures += 1
+            case .skipped:
+                break
+            }
+        }
+
+        frameTracker.withLock { tracker in
+            tracker.pressure.detached += detached
+            tracker.pressure.detachedBytes += bytes
+            tracker.pressure.detachFailures += failures
+            tracker.prune()
+        }
+    }
+}
@@ -24,6 +24,19 @@ import Synchronization
 /// ### Receiving Frames
 ///
 /// - ``frames()``
+/// - ``preroll(timeout:)``
+///
+/// ### On-Demand Snapshots
+///
+/// - ``latestFrame()``
+/// - ``setLastSampleEnabled(_:)``
+///
+/// ### Holding Frames
+///
+/// - ``setDetachPolicy(_:)``
+/// - ``DetachPolicy``
+/// - ``poolPressure``
+/// - ``PoolPressure``
 ///
 /// ## Example
 ///
@@ -82,21 +95,23 @@ import Synchronization
 ///   making them safe to process concurrently.
 public final class AppSink: @unchecked Sendable {
     /// The underlying element.
-    private let element: Element
+    internal let element: Element
 
     /// The GstAppSink pointer (cast from GstElement).
-    private var appSink: UnsafeMutablePointer<GstAppSink> {
+    internal var appSink: UnsafeMutablePointer<GstAppSink> {
         UnsafeMutableRawPointer(element.element).assumingMemoryBound(to: GstAppSink.self)
     }
 
     /// Cached video info from caps (thread-safe).
-    private struct VideoInfo: Sendable {
-        var width: Int = 0
-        var height: Int = 0
-        var format: PixelFormat = .unknown("")
-    }
     private let cachedInfo = Mutex(VideoInfo())
 
+    /// Frames handed out, for pool pressure and the detach policy.
+    internal let frameTracker = Mutex(FrameTracker())
+
+    /// Restarts of the owning pipeline, during which the stopped sink reads
+    /// as end-of-stream.
+    private let restarts: Pipeline.Restarts
+
     /// Create an AppSink from a pipeline by element name.
     ///
     /// The element must be an `appsink` element in the pipeline.
@@ -117,6 +132,13 @@ public final class AppSink: @unchecked Sendable {
             throw GStreamerError.elementNotFound(name)
         }
         self.element = element
+        self.restarts = pipeline.restarts
+    }
+
+    /// Whether the pipeline is being restarted, so an end-of-stream reading
+    /// means the sink is about to start again rather than that it finished.
+    internal var isRestarting: Bool {
+        restarts.inProgress
     }
     public struct Frames: AsyncSequence {
         let sink: AppSink
@@ -131,71 +153,17 @@ public final class AppSink: @unchecked Sendable {
                     if let sample = swift_gst_app_sink_try_pull_sample(sink.appSink, 100_000_000) {
                         defer { swift_gst_sample_unref(UnsafeMutableRawPointer(sample)) }
 
-                        // Get buffer from sample
-                        guard let buffer = swift_gst_sample_get_buffer(UnsafeMutableRawPointer(sample)) else {
+                        guard let frame = sink.makeFrame(from: sample) else {
                             continue
                         }
-
-                        // Get current cached info
-                        var info = sink.cachedInfo.withLock { $0 }
-
-                        // Parse video info from caps - always try until we have valid values
-                        if info.width == 0 || info.height == 0 {
-                            if let caps = swift_gst_sample_get_caps(UnsafeMutableRawPointer(sample)) {
-                                info = sink.parseVideoInfo(from: caps)
-                            }
-                        }
-
-                        // Get buffer size to validate
-                        let bufferSize = swift_gst_buffer_get_size(buffer)
-                        guard bufferSize > 0 else { continue }
-
-                        // If we still don't have dimensions, try to infer from buffer size and format
-                        var width = info.width
-                        var height = info.height
-                        let format = info.format
-
-                        if width == 0 || height == 0 {
-                            // Try to infer dimensions from buffer size
-                            let bytesPerPixel = format.bytesPerPixel
-                            if bytesPerPixel > 0 {
-                                let totalPixels = Int(bufferSize) / bytesPerPixel
-                                // Common aspect ratios to try
-                                let aspectRatios: [(Int, Int)] = [(16, 9), (4, 3), (1, 1)]
-                                for (w, h) in aspectRatios {
-                                    let testWidth = isqrt(totalPixels * w / h)
-                                    let testHeight = totalPixels / testWidth
-                                    if testWidth * testHeight == totalPixels {
-                                        width = testWidth
-                                        height = testHeight
-                                        // Cache for subsequent frames
-                                        sink.cachedInfo.withLock {
-                                            $0.width = width
-                                            $0.height = height
-                                        }
-                                        break
-                                    }
-                                }
-                            }
-                        }
-
-                        // Ref the buffer so VideoFrame can own it
-                        _ = swift_gst_buffer_ref(buffer)
-
-                        let frame = VideoFrame(
-                            buffer: buffer,
-                            width: width,
-                            height: height,
-                            format: format,
-                            ownsReference: true
-                        )
-
                         return frame
                     }
 
-                    // Check for EOS
+                    // Check for EOS; a sink stopped by a restart reads the same
                     if swift_gst_app_sink_is_eos(sink.appSink) != 0 {
-                        break
+                        guard sink.isRestarting else { break }
+                        try? await Task.sleep(for: .milliseconds(10))
+                        continue
                     }
 
                     await Task.yield()
@@ -256,56 +224,180 @@ public final class AppSink: @unchecked Sendable {
         Frames(sink: self)
     }
 
-    /// Parse video info from caps and update cache.
-    private func parseVideoInfo(from caps: UnsafeMutablePointer<GstCaps>) -> VideoInfo {
-        guard let string = GLibString.takeOwnership(swift_gst_caps_to_string(caps)) else {
-            return cachedInfo.withLock { $0 }
-        }
-        let components = string.split(separator: ",")
-
-        var info = VideoInfo()
-
-        for component in components {
-            let trimmed = component.trimmingWhitespace()
-            if trimmed.hasPrefix("width=") {
-                // Handle both "width=320" and "width=(int)320"
-                let value = extractValue(from: String(trimmed.dropFirst(6)))
-                info.width = Int(value) ?? 0
-            } else if trimmed.hasPrefix("height=") {
-                let value = extractValue(from: String(trimmed.dropFirst(7)))
-                info.height = Int(value) ?? 0
-            } else if trimmed.hasPrefix("format=") {
-                let value = extractValue(from: String(trimmed.dropFirst(7)))
-                info.format = PixelFormat(string: value)
+    /// Pull the frame the sink prerolled on.
+    ///
+    /// When a pipeline reaches `PAUSED`, the sink holds the first frame after
+    /// the current position without consuming it. This is how a single frame
+    /// is fetched after a flushing seek in the paused state, without playing
+    /// the pipeline.
+    ///
+    /// - Parameter timeout: Maximum time to wait for a preroll frame.
+    /// - Returns: The preroll frame, or `nil` if none arrived before the timeout
+    ///   or the sink is at end-of-stream.
+    ///
+    /// ## Example
+    ///
+    /// ```swift
+    /// try pipeline.pause()
+    /// try pipeline.seek(to: 30_000_000_000, flags: [.flush, .keyUnit])
+    /// if let frame = try await sink.preroll(timeout: .seconds(2)) {
+    ///     print("Keyframe at \(frame.pts ?? 0)")
+    /// }
+    /// ```
+    @concurrent
+    public func preroll(timeout: Duration) async throws -> VideoFrame? {
+        let clock = ContinuousClock()
+        let deadline = clock.now.advanced(by: timeout)
+
+        while clock.now < deadline {
+            try Task.checkCancellation()
+
+            if let sample = swift_gst_app_sink_try_pull_preroll(appSink, 100_000_000) {
+                defer { swift_gst_sample_unref(UnsafeMutableRawPointer(sample)) }
+                return makeFrame(from: sample)
             }
+
+            if swift_gst_app_sink_is_eos(appSink) != 0 {
+                return nil
+            }
+
+            await Task.yield()
+        }
+
+        return nil
+    }
+
+    /// The most recent frame that reached the sink, without consuming anything.
+    ///
+    /// Reads the sink's `last-sample` property, so it returns immediately and
+    /// needs no streaming consumer. Combined with `max-buffers=1 drop=true`,
+    /// an idle camera costs no Swift wakeups at all until someone asks for a
+    /// frame.
+    ///
+    /// The sink must have `enable-last-sample=true`, either in the pipeline
+    /// description or via ``setLastSampleEnabled(_:)``.
+    ///
+    /// - Returns: The latest frame, or `nil` if none has arrived yet or
+    ///   last-sample is disabled.
+    ///
+    /// ## Example
+    ///
+    /// ```swift
+    /// let pipeline = try Pipeline("""
+    ///     v4l2src ! videoconvert ! video/x-raw,format=BGRA ! \
+    ///     appsink name=sink enable-last-sample=true max-buffers=1 drop=true sync=false
+    ///     """)
+    /// let sink = try pipeline.appSink(named: "sink")
+    /// try pipeline.play()
+    ///
+    /// // Later, when a dashboard opens:
+    /// if let frame = sink.latestFrame() {
+    ///     let jpeg = try await encoder.encode(frame)
+    /// }
+    /// ```
+    public func latestFrame() -> VideoFrame? {
+        guard let sample = swift_gst_base_sink_get_last_sample(element.element) else {
+            return nil
         }
+        defer { swift_gst_sample_unref(UnsafeMutableRawPointer(sample)) }
+        return makeFrame(from: sample)
+    }
 
-        // Update cache atomically
-        cachedInfo.withLock { $0 = info }
-        return info
+    /// Keep a reference to the last frame for ``latestFrame()``.
+    ///
+    /// - Parameter enabled: Whether the sink retains its last sample.
+    public func setLastSampleEnabled(_ enabled: Bool) {
+        element.set("enable-last-sample", enabled)
     }
 
-    /// Extract value from a GStreamer caps value that may have type annotation.
-    /// Handles both "BGRA" and "(string)BGRA" and "(int)320".
-    private func extractValue(from string: String) -> String {
-        // Check for type annotation pattern like "(type)value"
-        if let closeParenIndex = string.firstIndex(of: ")"),
-           string.hasPrefix("(") {
-            return String(string[string.index(after: closeParenIndex)...])
+    /// Pull the next frame, giving up after `timeout`.
+    ///
+    /// Used by request/response pipelines (such as the JPEG decoder pool)
+    /// where a missing frame means the pipeline failed rather than that the
+    /// stream is slow.
+    ///
+    /// - Returns: The frame, or `nil` on timeout or end-of-stream.
+    @concurrent
+    internal func pull(timeout: Duration) async throws -> VideoFrame? {
+        let clock = ContinuousClock()
+        let deadline = clock.now.advanced(by: timeout)
+
+        while clock.now < deadline {
+            try Task.checkCancellation()
+
+            if let sample = swift_gst_app_sink_try_pull_sample(appSink, 100_000_000) {
+                defer { swift_gst_sample_unref(UnsafeMutableRawPointer(sample)) }
+                if let frame = makeFrame(from: sample) {
+                    return frame
+                }
+                continue
+            }
+
+            if swift_gst_app_sink_is_eos(appSink) != 0 {
+                return nil
+            }
+
+            await Task.yield()
         }
-        return string
+
+        return nil
     }
-}
 
-/// Integer square root using Newton's method.
-/// Avoids Foundation/floating-point dependencies for cross-compilation.
-private func isqrt(_ n: Int) -> Int {
-    guard n > 0 else { return 0 }
-    var x = n
-    var y = (x + 1) / 2
-    while y < x {
-        x = y
-        y = (x + n / x) / 2
+    /// Wrap a pulled sample's buffer in a ``VideoFrame``.
+    ///
+    /// The sample is borrowed; the frame takes its own reference on the buffer.
+    private func makeFrame(from sample: OpaquePointer) -> VideoFrame? {
+        // Get buffer from sample
+        guard let buffer = swift_gst_sample_get_buffer(UnsafeMutableRawPointer(sample)) else {
+            return nil
+        }
+
+        // Get current cached info
+        var info = cachedInfo.withLock { $0 }
+
+        // Parse video info from caps - always try until we have valid values
+        if info.width == 0 || info.height == 0 {
+            if let caps = swift_gst_sample_get_caps(UnsafeMutableRawPointer(sample)),
+               let parsed = VideoInfo(caps: caps) {
+                info = parsed
+                cachedInfo.withLock { $0 = parsed }
+            }
+        }
+
+        // Get buffer size to validate
+        let bufferSize = swift_gst_buffer_get_size(buffer)
+        guard bufferSize > 0 else { return nil }
+
+        // If we still don't have dimensions, try to infer from buffer size and format
+        var width = info.width
+        var height = info.height
+        let format = info.format
+
+        if width == 0 || height == 0 {
+            // Infer dimensions from the exact frame size of the format's
+            // plane layout, then cache them for subsequent frames
+            if let inferred = format.inferDimensions(frameSize: Int(bufferSize)) {
+                width = inferred.width
+                height = inferred.height
+                cachedInfo.withLock {
+                    $0.width = width
+                    $0.height = height
+                }
+            }
+        }
+
+        // Ref the buffer so VideoFrame can own it
+        _ = swift_gst_buffer_ref(buffer)
+
+        let frame = VideoFrame(
+            buffer: buffer,
+            width: width,
+            height: height,
+            format: format,
+            ownsReference: true
+        )
+        track(frame, pool: swift_gst_buffer_get_pool(buffer))
+
+        return frame
     }
-    return x
 }
@@ -1,6 +1,7 @@
 import CGStreamer
 import CGStreamerApp
 import CGStreamerShim
+import Synchronization
 
 /// A wrapper for GStreamer's appsrc element for pushing data into a pipeline.
 ///
@@ -27,11 +28,13 @@ import CGStreamerShim
 /// - ``setCaps(_:)``
 /// - ``setLive(_:)``
 /// - ``setMaxBytes(_:)``
+/// - ``setAllocator(_:)``
 /// - ``StreamType``
 ///
 /// ### Pushing Data
 ///
 /// - ``push(data:pts:duration:)``
+/// - ``push(_:)``
 /// - ``pushVideoFrame(data:width:height:format:pts:duration:)``
 /// - ``endOfStream()``
 ///
@@ -110,6 +113,9 @@ public final class AppSource: @unchecked Sendable {
     /// The underlying element.
     private let element: Element
 
+    /// Allocator for buffers made from pushed bytes, or `nil` for the system allocator.
+    private let allocator = Mutex<BufferAllocator?>(nil)
+
     /// The GstAppSrc pointer (cast from GstElement).
     private var appSrc: UnsafeMutablePointer<GstAppSrc> {
         UnsafeMutableRawPointer(element.element).assumingMemoryBound(to: GstAppSrc.self)
@@ -158,6 +164,15 @@ public final class AppSource: @unchecked Sendable {
         swift_gst_caps_unref(caps)
     }
 
+    /// Set the caps (media type) for data pushed by this source.
+    ///
+    /// Avoids re-parsing when the caps already exist, e.g. from ``Caps/intersect(_:)``.
+    ///
+    /// - Parameter caps: The caps describing pushed buffers.
+    public func setCaps(_ caps: Caps) {
+        swift_gst_app_src_set_caps(appSrc, caps.caps)
+    }
+
     /// Set whether this source behaves as a live source.
     ///
     /// Live sources (webcams, microphones) produce data in real-time.
@@ -191,6 +206,18 @@ public final class AppSource: @unchecked Sendable {
         swift_gst_app_src_set_stream_type(appSrc, gstType)
     }
 
+    /// Set the allocator for buffers created from pushed data.
+    ///
+    /// Data pushed as bytes is copied into a new buffer; with an allocator
+    /// that copy lands in aligned or huge-page memory, ready for SIMD code
+    /// downstream. To avoid the copy entirely, create the ``Buffer`` from
+    /// the allocator, fill it, and ``push(_:)`` it.
+    ///
+    /// - Parameter allocator: The allocator, or `nil` for the system allocator.
+    public func setAllocator(_ allocator: BufferAllocator?) {
+        self.allocator.withLock { $0 = allocator }
+    }
+
     /// Push raw data into the pipeline.
     ///
     /// The data is copied into a GStreamer buffer and pushed to downstream elements.
@@ -278,7 +305,9 @@ public final class AppSource: @unchecked Sendable {
         let gstPts = pts.map { GstClockTime($0) } ?? swift_gst_clock_time_none()
         let gstDuration = duration.map { GstClockTime($0) } ?? swift_gst_clock_time_none()
 
-        guard let buffer = swift_gst_buffer_new_wrapped_full(bytes, gsize(count), gstPts, gstDuration) else {
+        let allocator = self.allocator.withLock { $0 }
+        guard let buffer = swift_gst_buffer_new_filled(
+            allocator?.allocator, bytes, gsize(count), gstPts, gstDuration) else {
             throw GStreamerError.bufferMapFailed
         }
 
@@ -289,6 +318,37 @@ public final class AppSource: @unchecked Sendable {
         }
     }
 
+    /// Push a buffer without copying its memory.
+    ///
+    /// The buffer's memory is shared with the pipeline, so fill it before
+    /// pushing. Its timestamps are used as they are.
+    ///
+    /// - Parameter buffer: The buffer to push.
+    /// - Throws: ``GStreamerError/pushFailed`` if the push fails.
+    ///
+    /// ## Example
+    ///
+    /// ```swift
+    /// let allocator = BufferAllocator.hugePages()
+    /// var buffer = try Buffer(size: frameSize, pts: pts, duration: frameDuration, allocator: allocator)
+    /// try buffer.withUnsafeMutableBytes { render(into: $0) }
+    /// try src.push(buffer)
+    /// ```
+    public func push(_ buffer: Buffer) throws {
+        try push(buffer: buffer.buffer)
+    }
+
+    /// Push an existing buffer without copying its memory.
+    ///
+    /// The buffer is referenced, so the caller keeps its own reference.
+    internal func push(buffer: UnsafeMutablePointer<GstBuffer>) throws {
+        // push_buffer takes ownership of the extra reference
+        let result = swift_gst_app_src_push_buffer(appSrc, swift_gst_buffer_ref(buffer))
+        if result.rawValue < 0 {
+            throw GStreamerError.pushFailed
+        }
+    }
+
     /// Push a video frame with explicit dimensions.
     ///
     /// Convenience method for pushing video frame data with format information.
@@ -335,8 +395,9 @@ public final class AppSource: @unchecked Sendable {
         pts: UInt64? = nil,
         duration: UInt64? = nil
     ) throws {
-        // Verify data size matches expected size
-        let expectedSize = width * height * format.bytesPerPixel
+        // Verify data size matches the format's plane layout; compressed
+        // frames have no fixed size
+        let expectedSize = format.frameSize(width: width, height: height) ?? 0
         guard data.count >= expectedSize else {
             throw GStreamerError.bufferMapFailed
         }
@@ -380,8 +441,9 @@ public final class AppSource: @unchecked Sendable {
         pts: UInt64? = nil,
         duration: UInt64? = nil
     ) throws {
-        // Verify data size matches expected size
-        let expectedSize = width * height * format.bytesPerPixel
+        // Verify data size matches the format's plane layout; compressed
+        // frames have no fixed size
+        let expectedSize = format.frameSize(width: width, height: height) ?? 0
         guard data.count >= expectedSize else {
             throw GStreamerError.bufferMapFailed
         }
@@ -428,8 +490,9 @@ public final class AppSource: @unchecked Sendable {
         pts: UInt64? = nil,
         duration: UInt64? = nil
     ) throws {
-        // Verify data size matches expected size
-        let expectedSize = width * height * format.bytesPerPixel
+        // Verify data size matches the format's plane layout; compressed
+        // frames have no fixed size
+        let expectedSize = format.frameSize(width: width, height: height) ?? 0
         guard data.byteCount >= expectedSize else {
             throw GStreamerError.bufferMapFailed
         }
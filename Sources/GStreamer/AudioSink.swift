@@ -291,8 +291,10 @@ public struct AudioSinkBuilder: Sendable {
       do {
         let pipeline = try Pipeline(description)
         let appSource = try pipeline.appSource(named: sourceName)
+        let caps = buildCaps()
+        pipeline.element(named: "\(sourceName)_caps")?.set("caps", caps)
 
-        appSource.setCaps(buildCaps())
+        appSource.setCaps(caps)
         appSource.setLive(true)
         appSource.setStreamType(.stream)
 
@@ -366,12 +368,12 @@ public struct AudioSinkBuilder: Sendable {
       "appsrc name=\(sourceName) is-live=true format=time",
       "audioconvert",
       "audioresample",
-      buildCaps(),
+      "capsfilter name=\(sourceName)_caps",
       sink,
     ].joined(separator: " ! ")
   }
 
-  private func buildCaps() -> String {
+  private func buildCaps() -> Caps {
     var builder = CapsBuilder.audio()
 
     if let format {
@@ -388,7 +390,7 @@ public struct AudioSinkBuilder: Sendable {
       builder = builder.channels(channels)
     }
 
-    return builder.build()
+    return builder.buildCaps()
   }
 }
 
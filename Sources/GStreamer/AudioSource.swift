@@ -106,11 +106,27 @@ public final class AudioSource: @unchecked Sendable {
   /// An async stream of encoded (or raw) audio packets.
   ///
   /// For raw capture, this returns an empty stream. Prefer ``buffers()``.
+  /// Use ``encodedPackets()`` when the codec caps or `codec_data` are needed.
   public func packets() -> AsyncStream<Buffer> {
     guard let packetSink else {
       return AsyncStream { $0.finish() }
     }
-    return packetSink.packets()
+    return packetSink.packets { $0.buffer }
+  }
+
+  /// An async stream of encoded audio packets with the stream's caps.
+  ///
+  /// Each packet is an ``EncodedFrame`` whose ``EncodedFrame/caps`` describe
+  /// the codec (such as `audio/mpeg` or `audio/x-opus`) and whose
+  /// ``EncodedFrame/codecData`` holds the decoder configuration muxers need,
+  /// such as the AAC AudioSpecificConfig.
+  ///
+  /// For raw capture, this returns an empty stream. Prefer ``buffers()``.
+  public func encodedPackets() -> AsyncStream<EncodedFrame> {
+    guard let packetSink else {
+      return AsyncStream { $0.finish() }
+    }
+    return packetSink.packets { $0 }
   }
 
   /// Stop the underlying pipeline.
@@ -354,6 +370,7 @@ public struct AudioSourceBuilder: Sendable {
 
         do {
           let pipeline = try Pipeline(description)
+          pipeline.element(named: "\(sinkName)_caps")?.set("caps", buildCaps())
           let audioSink: AudioBufferSink?
           let packetSink: AudioPacketSink?
 
@@ -457,10 +474,9 @@ public struct AudioSourceBuilder: Sendable {
   ) -> String {
     var parts: [String] = [source, "audioconvert", "audioresample"]
 
-    let caps = buildCaps()
-    if !caps.isEmpty {
-      parts.append(caps)
-    }
+    // Caps are set on the filter as a GstCaps after parsing rather than
+    // being printed into the description and parsed again.
+    parts.append("capsfilter name=\(sinkName)_caps")
 
     if let encoder {
       parts.append(encoder)
@@ -471,7 +487,7 @@ public struct AudioSourceBuilder: Sendable {
     return parts.joined(separator: " ! ")
   }
 
-  private func buildCaps() -> String {
+  private func buildCaps() -> Caps {
     var builder = CapsBuilder.audio()
 
     if let format {
@@ -492,7 +508,7 @@ public struct AudioSourceBuilder: Sendable {
       builder = builder.channels(2)
     }
 
-    return builder.build()
+    return builder.buildCaps()
   }
 }
 
@@ -515,8 +531,13 @@ private final class AudioPacketSink: @unchecked Sendable {
 
     struct AsyncIterator: AsyncIteratorProtocol {
       let sink: AudioPacketSink
+      private var caps: Caps?
+
+      init(sink: AudioPacketSink) {
+        self.sink = sink
+      }
 
-      mutating func next() async -> Buffer? {
+      mutating func next() async -> EncodedFrame? {
         while !Task.isCancelled {
           if let sample = swift_gst_app_sink_try_pull_sample(sink.appSink, 100_000_000) {
             defer { swift_gst_sample_unref(UnsafeMutableRawPointer(sample)) }
@@ -529,9 +550,16 @@ private final class AudioPacketSink: @unchecked Sendable {
             let bufferSize = swift_gst_buffer_get_size(gstBuffer)
             guard bufferSize > 0 else { continue }
 
+            // Caps rarely change mid-stream; reuse the previous packet's.
+            if let sampleCaps = swift_gst_sample_get_caps(UnsafeMutableRawPointer(sample)),
+              caps?.caps != sampleCaps
+            {
+              caps = Caps(caps: swift_gst_caps_ref(sampleCaps), ownsReference: true)
+            }
+
             _ = swift_gst_buffer_ref(gstBuffer)
 
-            return Buffer(buffer: gstBuffer, ownsReference: true)
+            return EncodedFrame(buffer: Buffer(buffer: gstBuffer, ownsReference: true), caps: caps)
           }
 
           if swift_gst_app_sink_is_eos(sink.appSink) != 0 {
@@ -550,7 +578,9 @@ private final class AudioPacketSink: @unchecked Sendable {
     }
   }
 
-  func packets() -> AsyncStream<Buffer> {
+  func packets<Packet: Sendable>(
+    _ transform: @escaping @Sendable (EncodedFrame) -> Packet
+  ) -> AsyncStream<Packet> {
     AsyncStream { continuation in
       let task = Task.detached { [weak self] in
         guard let self else {
@@ -560,7 +590,7 @@ private final class AudioPacketSink: @unchecked Sendable {
 
         var iterator = Packets(sink: self).makeAsyncIterator()
         while let packet = await iterator.next() {
-          continuation.yield(packet)
+          continuation.yield(transform(packet))
         }
         continuation.finish()
       }
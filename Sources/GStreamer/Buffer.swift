@@ -18,6 +18,9 @@ import CGStreamerShim
 ///
 /// // Create a buffer with timestamps
 /// var buffer = try Buffer(size: frameSize, pts: 0, duration: 33_333_333)
+///
+/// // Create a buffer on a 64-byte boundary for SIMD code
+/// var buffer = try Buffer(size: frameSize, allocator: .aligned(to: 64))
 /// ```
 ///
 /// ## Copy-on-Write Behavior
@@ -51,7 +54,7 @@ import CGStreamerShim
 public struct Buffer: @unchecked Sendable {
     /// Internal storage class for copy-on-write semantics.
     private final class Storage: @unchecked Sendable {
-        let buffer: UnsafeMutablePointer<GstBuffer>
+        private(set) var buffer: UnsafeMutablePointer<GstBuffer>
         let ownsReference: Bool
 
         init(buffer: UnsafeMutablePointer<GstBuffer>, ownsReference: Bool) {
@@ -66,34 +69,55 @@ public struct Buffer: @unchecked Sendable {
         }
 
         /// Create a copy of this storage.
+        ///
+        /// The copy shares the memory blocks; GStreamer copies a block when
+        /// it is first mapped for writing.
         func copy() -> Storage? {
             guard let copied = gst_buffer_copy(buffer) else {
                 return nil
             }
             return Storage(buffer: copied, ownsReference: true)
         }
+
+        /// Make the GstBuffer writable in place, replacing it with a copy if
+        /// anything else holds a reference. Returns false for borrowed buffers.
+        func makeWritable() -> Bool {
+            if swift_gst_buffer_is_writable(buffer) != 0 {
+                return true
+            }
+            guard ownsReference else { return false }
+            buffer = swift_gst_buffer_make_writable(buffer)
+            return true
+        }
     }
 
     private var storage: Storage
 
-    /// Ensure unique ownership of storage before mutation.
-    /// Returns true if we have unique access, false if copy failed.
+    /// Ensure the buffer can be modified before mutation.
+    ///
+    /// Both Swift and GStreamer may share a buffer: other `Buffer` values
+    /// share the storage, and the pipeline or a sample may hold references
+    /// to the GstBuffer. Returns true once neither does, false if the copy
+    /// failed.
     private mutating func ensureUnique() -> Bool {
-        if !isKnownUniquelyReferenced(&storage) {
-            guard let newStorage = storage.copy() else {
-                return false
-            }
-            storage = newStorage
+        if isKnownUniquelyReferenced(&storage), storage.makeWritable() {
+            return true
         }
+        guard let newStorage = storage.copy() else {
+            return false
+        }
+        storage = newStorage
         return true
     }
 
     /// Create a new buffer with the specified size.
     ///
-    /// - Parameter size: The size of the buffer in bytes.
+    /// - Parameters:
+    ///   - size: The size of the buffer in bytes.
+    ///   - allocator: Where the memory comes from, or `nil` for the system allocator.
     /// - Throws: ``GStreamerError/bufferMapFailed`` if allocation fails.
-    public init(size: Int) throws {
-        guard let buffer = swift_gst_buffer_new_allocate(gsize(size)) else {
+    public init(size: Int, allocator: BufferAllocator? = nil) throws {
+        guard let buffer = swift_gst_buffer_new_allocate_with(allocator?.allocator, gsize(size)) else {
             throw GStreamerError.bufferMapFailed
         }
         self.storage = Storage(buffer: buffer, ownsReference: true)
@@ -106,9 +130,12 @@ public struct Buffer: @unchecked Sendable {
     ///   - pts: Presentation timestamp in nanoseconds.
     ///   - dts: Decode timestamp in nanoseconds (optional).
     ///   - duration: Duration in nanoseconds (optional).
+    ///   - allocator: Where the memory comes from, or `nil` for the system allocator.
     /// - Throws: ``GStreamerError/bufferMapFailed`` if allocation fails.
-    public init(size: Int, pts: UInt64, dts: UInt64? = nil, duration: UInt64? = nil) throws {
-        guard let buffer = swift_gst_buffer_new_allocate(gsize(size)) else {
+    public init(
+        size: Int, pts: UInt64, dts: UInt64? = nil, duration: UInt64? = nil, allocator: BufferAllocator? = nil
+    ) throws {
+        guard let buffer = swift_gst_buffer_new_allocate_with(allocator?.allocator, gsize(size)) else {
             throw GStreamerError.bufferMapFailed
         }
         self.storage = Storage(buffer: buffer, ownsReference: true)
@@ -256,12 +283,9 @@ public struct Buffer: @unchecked Sendable {
             fatalError("Cannot read mutableBytes")
         }
         _modify {
-            guard isKnownUniquelyReferenced(&storage) || storage.copy() != nil else {
+            guard ensureUnique() else {
                 fatalError("Failed to ensure unique buffer ownership")
             }
-            if !isKnownUniquelyReferenced(&storage) {
-                storage = storage.copy()!
-            }
             var mapInfo = GstMapInfo()
             guard swift_gst_buffer_map_write(storage.buffer, &mapInfo) != 0 else {
                 fatalError("Failed to map buffer for writing")
@@ -347,4 +371,118 @@ public struct Buffer: @unchecked Sendable {
             Int(swift_gst_buffer_fill(storage.buffer, gsize(offset), bytes.baseAddress, gsize(bytes.count)))
         }
     }
+
+    // MARK: - Writability
+
+    /// Whether the buffer can be modified without a copy.
+    ///
+    /// A buffer is writable when no other `Buffer` shares it and GStreamer
+    /// holds no other reference to it, such as one queued in a pipeline.
+    public var isWritable: Bool {
+        mutating get {
+            isKnownUniquelyReferenced(&storage) && storage.ownsReference
+                && swift_gst_buffer_is_writable(storage.buffer) != 0
+        }
+    }
+
+    /// Make the buffer writable, copying it if it is shared.
+    ///
+    /// Mutating methods do this themselves; call it to pay for the copy at
+    /// a time of your choosing. The copy shares memory blocks with the
+    /// original, and a block is only copied when it is first written to.
+    ///
+    /// - Throws: ``GStreamerError/bufferMapFailed`` if the copy fails.
+    public mutating func makeWritable() throws {
+        guard ensureUnique() else {
+            throw GStreamerError.bufferMapFailed
+        }
+    }
+
+    // MARK: - Scatter-Gather
+
+    /// Create a buffer from the memory of other buffers, without copying.
+    ///
+    /// The new buffer shares the memory blocks of each part, in order. Use
+    /// it to assemble a packet from a header and a payload. Timestamps are
+    /// not set.
+    ///
+    /// ```swift
+    /// let header = try Buffer(data: rtpHeader)
+    /// let packet = try Buffer(joining: [header, payload])
+    /// ```
+    ///
+    /// - Parameter parts: The buffers to join.
+    /// - Throws: ``GStreamerError/bufferMapFailed`` if the buffer can't be created.
+    public init(joining parts: [Buffer]) throws {
+        guard let buffer = swift_gst_buffer_new_empty() else {
+            throw GStreamerError.bufferMapFailed
+        }
+        for part in parts {
+            swift_gst_buffer_add_memories(buffer, part.buffer, 0)
+        }
+        self.storage = Storage(buffer: buffer, ownsReference: true)
+    }
+
+    /// The number of separate memory blocks holding the buffer's data.
+    ///
+    /// Reading ``bytes`` from a buffer with more than one block copies them
+    /// into one; elements that handle scatter-gather buffers read the
+    /// blocks directly.
+    public var memoryCount: Int {
+        Int(swift_gst_buffer_n_memory(storage.buffer))
+    }
+
+    /// Add another buffer's memory to the end of this one, without copying.
+    ///
+    /// GStreamer holds at most 16 blocks per buffer; adding beyond that
+    /// merges the blocks into one, which copies them.
+    ///
+    /// - Parameter other: The buffer whose memory to share.
+    /// - Throws: ``GStreamerError/bufferMapFailed`` if this buffer can't be
+    ///   made writable.
+    public mutating func append(_ other: Buffer) throws {
+        guard ensureUnique() else {
+            throw GStreamerError.bufferMapFailed
+        }
+        swift_gst_buffer_add_memories(storage.buffer, other.buffer, 0)
+    }
+
+    /// Add another buffer's memory to the start of this one, without copying.
+    ///
+    /// Timestamps and flags stay those of this buffer.
+    ///
+    /// - Parameter other: The buffer whose memory to share.
+    /// - Throws: ``GStreamerError/bufferMapFailed`` if this buffer can't be
+    ///   made writable.
+    public mutating func prepend(_ other: Buffer) throws {
+        guard ensureUnique() else {
+            throw GStreamerError.bufferMapFailed
+        }
+        swift_gst_buffer_add_memories(storage.buffer, other.buffer, 1)
+    }
+
+    /// A buffer covering part of this one, sharing its memory.
+    ///
+    /// Timestamps and flags are copied. Writing to the slice copies the
+    /// affected memory first, so this buffer is never changed through it.
+    ///
+    /// ```swift
+    /// // Send the payload on without the 12-byte header
+    /// if let payload = packet.slice(offset: 12, size: packet.size - 12) {
+    ///     try src.push(payload)
+    /// }
+    /// ```
+    ///
+    /// - Parameters:
+    ///   - offset: The first byte of the slice.
+    ///   - size: The number of bytes.
+    /// - Returns: The slice, or `nil` if the range is outside the buffer.
+    public func slice(offset: Int, size: Int) -> Buffer? {
+        guard offset >= 0, size >= 0,
+            let region = swift_gst_buffer_share_region(storage.buffer, gsize(offset), gsize(size))
+        else {
+            return nil
+        }
+        return Buffer(buffer: region, ownsReference: true)
+    }
 }
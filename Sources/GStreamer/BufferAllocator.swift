@@ -0,0 +1,141 @@
+import CGStreamer
+import CGStreamerShim
+
+/// Supplies the memory behind buffers from a ``BufferAllocator``.
+///
+/// Implement this to place buffers in memory you manage: a preallocated
+/// arena, memory shared with an accelerator, or pinned DMA memory.
+/// Both methods may be called from any thread, including GStreamer's
+/// streaming threads.
+public protocol MemoryProvider: AnyObject, Sendable {
+    /// Return at least `byteCount` bytes starting on an `alignment`-byte
+    /// boundary, or `nil` if the memory isn't available.
+    func allocate(byteCount: Int, alignment: Int) -> UnsafeMutableRawPointer?
+
+    /// Take back memory returned by ``allocate(byteCount:alignment:)``.
+    ///
+    /// Called once the last buffer using the memory is released, which may
+    /// be long after the buffer was pushed.
+    func deallocate(_ pointer: UnsafeMutableRawPointer, byteCount: Int)
+}
+
+/// A GStreamer allocator that controls where buffer memory comes from.
+///
+/// Buffers from the default allocator have whatever alignment the system
+/// `malloc` gives them, which sends SIMD code down its unaligned paths,
+/// and large frames spread over thousands of 4 KiB pages. A buffer
+/// allocator fixes the placement:
+///
+/// - ``aligned(to:)`` starts every buffer on a chosen boundary, such as
+///   64 bytes for AVX-512 or a cache line.
+/// - ``hugePages()`` backs buffers with 2 MiB pages, so a 4K frame needs
+///   a handful of TLB entries instead of thousands.
+/// - ``init(alignment:provider:)`` takes memory from a ``MemoryProvider``.
+///
+/// Use it for ``Buffer`` or set it on an ``AppSource``:
+///
+/// ```swift
+/// let allocator = BufferAllocator.aligned(to: 64)
+/// src.setAllocator(allocator)
+///
+/// // Render straight into an aligned buffer and push it without a copy
+/// var buffer = try Buffer(size: frameSize, allocator: allocator)
+/// try buffer.withUnsafeMutableBytes { render(into: $0) }
+/// try src.push(buffer)
+/// ```
+///
+/// Memory stays valid until the last buffer using it is released, even
+/// after the allocator itself is gone.
+public final class BufferAllocator: @unchecked Sendable {
+    /// Live memory handed out by an allocator.
+    public struct Statistics: Sendable, Hashable {
+        /// Blocks not yet released.
+        public var allocations: Int
+        /// Bytes in those blocks, including any rounding up to page size.
+        public var bytes: Int
+        /// Bytes on reserved (hugetlbfs) huge pages. Transparent huge pages
+        /// aren't counted; the kernel decides those on its own.
+        public var hugePageBytes: Int
+    }
+
+    /// The underlying GstAllocator.
+    internal let allocator: UnsafeMutablePointer<GstAllocator>
+
+    /// The boundary every buffer's data starts on, in bytes.
+    public let alignment: Int
+
+    private init(allocator: UnsafeMutablePointer<GstAllocator>, alignment: Int) {
+        self.allocator = allocator
+        self.alignment = alignment
+    }
+
+    deinit {
+        swift_gst_object_unref(allocator)
+    }
+
+    /// An allocator whose buffers start on an `alignment`-byte boundary.
+    ///
+    /// - Parameter alignment: A power of two, such as 64 for cache-line or
+    ///   AVX-512 alignment, or 4096 for page alignment.
+    public static func aligned(to alignment: Int) -> BufferAllocator {
+        precondition(alignment > 0 && alignment & (alignment - 1) == 0, "Alignment must be a power of two")
+        return BufferAllocator(allocator: swift_gst_allocator_new_aligned(gsize(alignment)), alignment: alignment)
+    }
+
+    /// An allocator backed by 2 MiB huge pages.
+    ///
+    /// Uses pages reserved in hugetlbfs (`vm.nr_hugepages`) when there are
+    /// any, and otherwise asks for transparent huge pages. Every buffer is
+    /// rounded up to whole 2 MiB pages, so use this for large frames only.
+    /// On systems without huge pages buffers still work, on normal pages.
+    public static func hugePages() -> BufferAllocator {
+        BufferAllocator(allocator: swift_gst_allocator_new_huge_pages(), alignment: 2 * 1024 * 1024)
+    }
+
+    private final class Context: Sendable {
+        let provider: any MemoryProvider
+
+        init(_ provider: any MemoryProvider) {
+            self.provider = provider
+        }
+    }
+
+    /// An allocator that takes memory from a provider.
+    ///
+    /// The provider is retained until the allocator and every buffer it
+    /// allocated have been released.
+    ///
+    /// - Parameters:
+    ///   - alignment: The smallest alignment to request, a power of two.
+    ///     GStreamer may ask for more.
+    ///   - provider: Supplies and takes back the memory.
+    public init(alignment: Int = 64, provider: any MemoryProvider) {
+        precondition(alignment > 0 && alignment & (alignment - 1) == 0, "Alignment must be a power of two")
+        let allocate: SwiftGstAllocateCallback = { size, alignment, userData in
+            guard let userData else { return nil }
+            let provider = Unmanaged<Context>.fromOpaque(userData).takeUnretainedValue().provider
+            return provider.allocate(byteCount: Int(size), alignment: Int(alignment))
+        }
+        let deallocate: SwiftGstDeallocateCallback = { data, size, userData in
+            guard let data, let userData else { return }
+            let provider = Unmanaged<Context>.fromOpaque(userData).takeUnretainedValue().provider
+            provider.deallocate(data, byteCount: Int(size))
+        }
+        let release: GDestroyNotify = { userData in
+            guard let userData else { return }
+            Unmanaged<Context>.fromOpaque(userData).release()
+        }
+        self.allocator = swift_gst_allocator_new_provided(
+            gsize(alignment), allocate, deallocate, Unmanaged.passRetained(Context(provider)).toOpaque(), release)
+        self.alignment = alignment
+    }
+
+    /// Memory currently handed out.
+    public var statistics: Statistics {
+        var allocations: guint64 = 0
+        var bytes: guint64 = 0
+        var hugePageBytes: guint64 = 0
+        swift_gst_allocator_get_statistics(allocator, &allocations, &bytes, &hugePageBytes)
+        return Statistics(allocations: Int(allocations), bytes: Int(bytes), hugePageBytes: Int(hugePageBytes))
+    }
+}
@@ -252,6 +252,7 @@ extension BusMessage: CustomStringConvertible {
 /// ### Receiving Messages
 ///
 /// - ``messages(filter:)``
+/// - ``rawMessages(filter:)``
 /// - ``Filter``
 ///
 /// ## Example
@@ -371,6 +372,11 @@ public final class Bus: @unchecked Sendable {
         /// Filter for info messages.
         public static let info = Filter(rawValue: UInt32(bitPattern: GST_MESSAGE_INFO.rawValue))
 
+        /// Filter for stream status messages.
+        ///
+        /// Only delivered through ``Bus/rawMessages(filter:)``.
+        public static let streamStatus = Filter(rawValue: UInt32(bitPattern: GST_MESSAGE_STREAM_STATUS.rawValue))
+
         /// All message types.
         public static let all: Filter = [
             .error, .warning, .info, .eos, .stateChanged, .element,
@@ -476,6 +482,65 @@ public final class Bus: @unchecked Sendable {
         }
     }
 
+    /// An async stream of retained messages, decoded lazily.
+    ///
+    /// Unlike ``messages(filter:)``, nothing is parsed when a message arrives:
+    /// each ``Message`` holds a reference to the underlying `GstMessage` and
+    /// decodes its source name, structure fields or QoS counters only when
+    /// accessed. Use this for high-rate element messages (e.g. `level`,
+    /// `motioncells`) or when you need payloads ``BusMessage`` doesn't carry.
+    ///
+    /// The stream ends when EOS is received or the task is cancelled.
+    ///
+    /// - Parameter filter: Message types to receive.
+    /// - Returns: An `AsyncStream` of ``Message`` values.
+    ///
+    /// ## Example
+    ///
+    /// ```swift
+    /// for await message in pipeline.bus.rawMessages(filter: [.qos, .element]) {
+    ///     if let qos = message.qos {
+    ///         print("\(message.sourceName ?? "?"): dropped \(qos.dropped) of \(qos.processed)")
+    ///     } else if let structure = message.structure, structure.name == "level" {
+    ///         print("RMS: \(structure.serializedValue("rms") ?? "")")
+    ///     }
+    /// }
+    /// ```
+    public func rawMessages(filter: Filter = [.error, .eos, .stateChanged]) -> AsyncStream<Message> {
+        AsyncStream { continuation in
+            let task = Task.detached { [weak self] in
+                guard let self else {
+                    continuation.finish()
+                    return
+                }
+
+                while !Task.isCancelled {
+                    guard let msg = swift_gst_bus_timed_pop_filtered(
+                        self._bus,
+                        100_000_000, // 100ms in nanoseconds
+                        filter.gstMessageType
+                    ) else {
+                        continue
+                    }
+
+                    let isEOS = swift_gst_message_type(msg) == GST_MESSAGE_EOS
+                    continuation.yield(Message(message: msg))
+
+                    // Stop on EOS
+                    if isEOS {
+                        break
+                    }
+                }
+
+                continuation.finish()
+            }
+
+            continuation.onTermination = { _ in
+                task.cancel()
+            }
+        }
+    }
+
     /// Parse a GstMessage into a BusMessage.
     private func parseMessage(_ msg: UnsafeMutablePointer<GstMessage>) -> BusMessage? {
         let messageType = swift_gst_message_type(msg)
@@ -516,7 +581,9 @@ public final class Bus: @unchecked Sendable {
 
         case GST_MESSAGE_ELEMENT:
             let sourceName = GLibString.takeOwnership(swift_gst_message_src(msg).flatMap { gst_object_get_name($0) }) ?? "element"
-            return .element(name: sourceName, fields: [:])
+            // The structure is only read while `msg` is alive, so the bus can stand in as owner.
+            let fields = gst_message_get_structure(msg).map { Structure(pointer: $0, owner: self).fields } ?? [:]
+            return .element(name: sourceName, fields: fields)
 
         case GST_MESSAGE_BUFFERING:
             var percent: gint = 0
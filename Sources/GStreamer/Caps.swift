@@ -21,6 +21,16 @@ import CGStreamerShim
 /// ### Properties
 ///
 /// - ``description``
+/// - ``isEmpty``
+/// - ``isFixed``
+/// - ``structureCount``
+/// - ``structure(at:)``
+///
+/// ### Negotiation
+///
+/// - ``intersect(_:)``
+/// - ``canIntersect(with:)``
+/// - ``fixated()``
 ///
 /// ## Example
 ///
@@ -167,4 +177,93 @@ public struct Caps: Sendable, CustomStringConvertible {
     public var description: String {
         GLibString.takeOwnership(swift_gst_caps_to_string(caps)) ?? ""
     }
+
+    // MARK: - Inspection
+
+    /// Whether the caps accept no media at all.
+    public var isEmpty: Bool {
+        gst_caps_is_empty(caps) != 0
+    }
+
+    /// Whether the caps describe exactly one format (no lists or ranges).
+    public var isFixed: Bool {
+        gst_caps_is_fixed(caps) != 0
+    }
+
+    /// Number of structures (alternative formats) in the caps.
+    public var structureCount: Int {
+        Int(gst_caps_get_size(caps))
+    }
+
+    /// The structure at the given index.
+    ///
+    /// The returned ``Structure`` keeps these caps alive and reads fields
+    /// lazily, e.g. `caps.structure(at: 0)?.int("width")`.
+    ///
+    /// - Parameter index: The structure index.
+    /// - Returns: The structure, or `nil` if the index is out of range.
+    public func structure(at index: Int) -> Structure? {
+        guard index >= 0, index < structureCount,
+              let pointer = gst_caps_get_structure(caps, guint(index))
+        else {
+            return nil
+        }
+        return Structure(pointer: UnsafePointer(pointer), owner: storage)
+    }
+
+    // MARK: - Negotiation
+
+    /// The formats accepted by both these caps and `other`.
+    ///
+    /// This is the same intersection GStreamer performs during negotiation,
+    /// done in memory without building a pipeline.
+    ///
+    /// ## Example
+    ///
+    /// ```swift
+    /// let device = try Caps("video/x-raw,format={ NV12, YUY2 },width=[ 1, 1920 ],height=[ 1, 1080 ]")
+    /// let wanted = try Caps("video/x-raw,format=NV12,width=1280,height=720")
+    /// let common = wanted.intersect(device)
+    /// print(common.isEmpty) // false
+    /// ```
+    ///
+    /// - Parameter other: The caps to intersect with.
+    /// - Returns: The intersection, which may be empty.
+    public func intersect(_ other: Caps) -> Caps {
+        Caps(caps: gst_caps_intersect(caps, other.caps), ownsReference: true)
+    }
+
+    /// Whether these caps and `other` have any format in common.
+    ///
+    /// Cheaper than ``intersect(_:)`` when only the answer is needed.
+    public func canIntersect(with other: Caps) -> Bool {
+        gst_caps_can_intersect(caps, other.caps) != 0
+    }
+
+    /// A fixed version of these caps.
+    ///
+    /// Keeps the first structure and takes the lowest value of every range
+    /// and the first entry of every list, as `gst_caps_fixate` does.
+    ///
+    /// - Returns: Fixed caps with a single structure.
+    public func fixated() -> Caps {
+        Caps(caps: gst_caps_fixate(swift_gst_caps_copy(caps)), ownsReference: true)
+    }
+
+    /// Fixate video caps, choosing the size and framerate nearest to targets.
+    ///
+    /// ``fixated()`` takes the low end of every range, which for a source
+    /// with open ranges is 1x1 at 0/1. This first moves `width`, `height`
+    /// and `framerate` in every structure as close to the targets as their
+    /// ranges and lists allow, then fixates the remaining fields.
+    internal func fixated(width: Int, height: Int, framerate: Int) -> Caps {
+        let copy = swift_gst_caps_copy(caps)
+        for index in 0..<gst_caps_get_size(copy) {
+            guard let structure = gst_caps_get_structure(copy, index) else { continue }
+            _ = gst_structure_fixate_field_nearest_int(structure, "width", gint(clamping: width))
+            _ = gst_structure_fixate_field_nearest_int(structure, "height", gint(clamping: height))
+            _ = gst_structure_fixate_field_nearest_fraction(structure, "framerate", gint(clamping: framerate), 1)
+        }
+        return Caps(caps: gst_caps_fixate(copy), ownsReference: true)
+    }
 }
@@ -1,13 +1,82 @@
-/// A fluent builder for constructing GStreamer capabilities (caps) strings.
+import CGStreamer
+import CGStreamerShim
+import Synchronization
+
+/// A fluent builder for constructing GStreamer capabilities (caps).
+///
+/// CapsBuilder provides a type-safe, fluent API for describing media format
+/// constraints. Fields keep their GStreamer type (int, fraction, range, list),
+/// so ``buildCaps()`` constructs the `GstCaps` directly with
+/// `gst_structure_set` instead of printing and re-parsing a string. Built caps
+/// are interned: building an identical description again returns the cached
+/// caps without allocating a new `GstCaps`.
 ///
-/// CapsBuilder provides a type-safe, fluent API for constructing caps strings
-/// that define media format constraints in pipelines.
+/// ``build()`` still produces the equivalent caps string for splicing into
+/// pipeline descriptions.
 ///
 /// - Note: This is an internal API. For public use, prefer the generic pipeline
 ///   elements like `RawVideoFormat<_VideoFrame<BGRA<1920, 1080>>>`.
-internal struct CapsBuilder: Sendable {
+internal struct CapsBuilder: Sendable, Hashable {
+    /// A typed caps field value.
+    enum Value: Sendable, Hashable {
+        case int(Int)
+        case bool(Bool)
+        case string(String)
+        case fraction(Int, Int)
+        case intRange(ClosedRange<Int>)
+        case fractionRange(min: Fraction, max: Fraction)
+        case list([Value])
+
+        /// A numerator/denominator pair.
+        struct Fraction: Sendable, Hashable {
+            var numerator: Int
+            var denominator: Int
+        }
+
+        /// Infer a typed value from its caps-string form, as the caps parser does
+        /// for untyped values.
+        init(parsing string: String) {
+            if let int = Int(string) {
+                self = .int(int)
+            } else if string == "true" || string == "false" {
+                self = .bool(string == "true")
+            } else if let slash = string.firstIndex(of: "/"),
+                      let numerator = Int(string[..<slash]),
+                      let denominator = Int(string[string.index(after: slash)...]) {
+                self = .fraction(numerator, denominator)
+            } else {
+                self = .string(string)
+            }
+        }
+
+        /// The value in caps-string syntax.
+        var serialized: String {
+            switch self {
+            case .int(let value):
+                return String(value)
+            case .bool(let value):
+                return value ? "true" : "false"
+            case .string(let value):
+                return value
+            case .fraction(let numerator, let denominator):
+                return "\(numerator)/\(denominator)"
+            case .intRange(let range):
+                return "[ \(range.lowerBound), \(range.upperBound) ]"
+            case .fractionRange(let min, let max):
+                return "[ \(min.numerator)/\(min.denominator), \(max.numerator)/\(max.denominator) ]"
+            case .list(let values):
+                return "{ " + values.map(\.serialized).joined(separator: ", ") + " }"
+            }
+        }
+    }
+
     private var mediaType: String
-    private var properties: [(key: String, value: String)]
+    private var properties: [Property]
+
+    private struct Property: Sendable, Hashable {
+        var key: String
+        var value: Value
+    }
 
     /// Create a builder with a custom media type.
     ///
@@ -34,7 +103,16 @@ internal struct CapsBuilder: Sendable {
     /// - Parameter format: The pixel format.
     /// - Returns: The builder for chaining.
     func format(_ format: PixelFormat) -> CapsBuilder {
-        property("format", format.formatString)
+        property("format", .string(format.formatString))
+    }
+
+    /// Accept any of several pixel formats, in order of preference.
+    ///
+    /// - Parameter formats: The acceptable pixel formats.
+    /// - Returns: The builder for chaining.
+    func formats(_ formats: [PixelFormat]) -> CapsBuilder {
+        guard formats.count != 1 else { return format(formats[0]) }
+        return property("format", .list(formats.map { .string($0.formatString) }))
     }
 
     /// Set the video dimensions.
@@ -44,8 +122,8 @@ internal struct CapsBuilder: Sendable {
     ///   - height: The height in pixels.
     /// - Returns: The builder for chaining.
     func size(width: Int, height: Int) -> CapsBuilder {
-        self.property("width", String(width))
-            .property("height", String(height))
+        self.property("width", .int(width))
+            .property("height", .int(height))
     }
 
     /// Set the video width.
@@ -53,7 +131,15 @@ internal struct CapsBuilder: Sendable {
     /// - Parameter width: The width in pixels.
     /// - Returns: The builder for chaining.
     func width(_ width: Int) -> CapsBuilder {
-        property("width", String(width))
+        property("width", .int(width))
+    }
+
+    /// Accept any video width in a range.
+    ///
+    /// - Parameter range: The acceptable widths in pixels.
+    /// - Returns: The builder for chaining.
+    func width(in range: ClosedRange<Int>) -> CapsBuilder {
+        property("width", .intRange(range))
     }
 
     /// Set the video height.
@@ -61,7 +147,15 @@ internal struct CapsBuilder: Sendable {
     /// - Parameter height: The height in pixels.
     /// - Returns: The builder for chaining.
     func height(_ height: Int) -> CapsBuilder {
-        property("height", String(height))
+        property("height", .int(height))
+    }
+
+    /// Accept any video height in a range.
+    ///
+    /// - Parameter range: The acceptable heights in pixels.
+    /// - Returns: The builder for chaining.
+    func height(in range: ClosedRange<Int>) -> CapsBuilder {
+        property("height", .intRange(range))
     }
 
     /// Set the video framerate.
@@ -71,7 +165,26 @@ internal struct CapsBuilder: Sendable {
     ///   - denominator: The framerate denominator (e.g., 1 for 30fps, 1001 for 29.97fps).
     /// - Returns: The builder for chaining.
     func framerate(_ numerator: Int, _ denominator: Int) -> CapsBuilder {
-        property("framerate", "\(numerator)/\(denominator)")
+        property("framerate", .fraction(numerator, denominator))
+    }
+
+    /// Accept any framerate between two fractions, inclusive.
+    ///
+    /// - Parameters:
+    ///   - min: The lowest acceptable framerate as numerator/denominator.
+    ///   - max: The highest acceptable framerate as numerator/denominator.
+    /// - Returns: The builder for chaining.
+    func framerate(
+        min: (numerator: Int, denominator: Int),
+        max: (numerator: Int, denominator: Int)
+    ) -> CapsBuilder {
+        property(
+            "framerate",
+            .fractionRange(
+                min: Value.Fraction(numerator: min.numerator, denominator: min.denominator),
+                max: Value.Fraction(numerator: max.numerator, denominator: max.denominator)
+            )
+        )
     }
 
     // MARK: - Audio Properties
@@ -81,7 +194,7 @@ internal struct CapsBuilder: Sendable {
     /// - Parameter format: The audio format.
     /// - Returns: The builder for chaining.
     func format(_ format: AudioFormat) -> CapsBuilder {
-        property("format", format.formatString)
+        property("format", .string(format.formatString))
     }
 
     /// Set the audio sample rate.
@@ -89,7 +202,7 @@ internal struct CapsBuilder: Sendable {
     /// - Parameter rate: The sample rate in Hz (e.g., 44100, 48000).
     /// - Returns: The builder for chaining.
     func rate(_ rate: Int) -> CapsBuilder {
-        property("rate", String(rate))
+        property("rate", .int(rate))
     }
 
     /// Set the number of audio channels.
@@ -97,23 +210,40 @@ internal struct CapsBuilder: Sendable {
     /// - Parameter channels: The number of channels (1 for mono, 2 for stereo).
     /// - Returns: The builder for chaining.
     func channels(_ channels: Int) -> CapsBuilder {
-        property("channels", String(channels))
+        property("channels", .int(channels))
     }
 
     // MARK: - Generic Properties
 
-    /// Add a custom property.
+    /// Add a typed property, replacing any earlier value for the same key.
     ///
     /// - Parameters:
     ///   - key: The property name.
-    ///   - value: The property value.
+    ///   - value: The typed value.
     /// - Returns: The builder for chaining.
-    func property(_ key: String, _ value: String) -> CapsBuilder {
+    func property(_ key: String, _ value: Value) -> CapsBuilder {
         var copy = self
-        copy.properties.append((key, value))
+        if let index = copy.properties.firstIndex(where: { $0.key == key }) {
+            copy.properties[index].value = value
+        } else {
+            copy.properties.append(Property(key: key, value: value))
+        }
         return copy
     }
 
+    /// Add a custom property from its caps-string form.
+    ///
+    /// The value's type is inferred the same way the caps parser does:
+    /// integers, booleans and `n/d` fractions are typed, anything else is a string.
+    ///
+    /// - Parameters:
+    ///   - key: The property name.
+    ///   - value: The property value.
+    /// - Returns: The builder for chaining.
+    func property(_ key: String, _ value: String) -> CapsBuilder {
+        property(key, Value(parsing: value))
+    }
+
     /// Add a custom integer property.
     ///
     /// - Parameters:
@@ -121,7 +251,7 @@ internal struct CapsBuilder: Sendable {
     ///   - value: The integer value.
     /// - Returns: The builder for chaining.
     func property(_ key: String, _ value: Int) -> CapsBuilder {
-        property(key, String(value))
+        property(key, .int(value))
     }
 
     /// Add a custom boolean property.
@@ -131,7 +261,7 @@ internal struct CapsBuilder: Sendable {
     ///   - value: The boolean value.
     /// - Returns: The builder for chaining.
     func property(_ key: String, _ value: Bool) -> CapsBuilder {
-        property(key, value ? "true" : "false")
+        property(key, .bool(value))
     }
 
     // MARK: - Build
@@ -143,16 +273,99 @@ internal struct CapsBuilder: Sendable {
         if properties.isEmpty {
             return mediaType
         }
-        let propsString = properties.map { "\($0.key)=\($0.value)" }.joined(separator: ",")
+        let propsString = properties.map { "\($0.key)=\($0.value.serialized)" }.joined(separator: ",")
         return "\(mediaType),\(propsString)"
     }
 
     /// Build a Caps object from this builder.
     ///
+    /// The caps are constructed field by field without going through a
+    /// string, and interned so that identical builders share one `GstCaps`.
+    ///
     /// - Returns: A Caps object.
-    /// - Throws: ``GStreamerError/capsParseFailed(_:)`` if the caps string is invalid.
-    func buildCaps() throws -> Caps {
-        try Caps(build())
+    func buildCaps() -> Caps {
+        if let cached = Self.cache.withLock({ $0[self] }) {
+            return cached
+        }
+
+        let caps = makeCaps()
+        Self.cache.withLock { cache in
+            if cache.count >= Self.cacheLimit {
+                cache.removeAll(keepingCapacity: true)
+            }
+            cache[self] = caps
+        }
+        return caps
+    }
+
+    /// Build caps and intersect them with what a device or pad can produce.
+    ///
+    /// - Parameter available: The caps to intersect with (e.g. device caps).
+    /// - Returns: The intersection, or `nil` if nothing in common.
+    func intersect(with available: Caps) -> Caps? {
+        let result = buildCaps().intersect(available)
+        return result.isEmpty ? nil : result
+    }
+
+    /// Maximum number of interned caps kept alive.
+    private static let cacheLimit = 64
+
+    /// Interned caps keyed by builder contents.
+    ///
+    /// Cached caps are never mutated; operations on ``Caps`` return new caps.
+    private static let cache = Mutex<[CapsBuilder: Caps]>([:])
+
+    private func makeCaps() -> Caps {
+        let caps = gst_caps_new_empty_simple(mediaType)!
+        let structure = gst_caps_get_structure(caps, 0)!
+
+        for property in properties {
+            Self.set(property.value, for: property.key, on: structure)
+        }
+
+        return Caps(caps: caps, ownsReference: true)
+    }
+
+    private static func set(
+        _ value: Value,
+        for key: String,
+        on structure: UnsafeMutablePointer<GstStructure>
+    ) {
+        switch value {
+        case .int(let int):
+            swift_gst_structure_set_int(structure, key, gint(int))
+        case .bool(let bool):
+            swift_gst_structure_set_boolean(structure, key, bool ? 1 : 0)
+        case .string(let string):
+            swift_gst_structure_set_string(structure, key, string)
+        case .fraction(let numerator, let denominator):
+            swift_gst_structure_set_fraction(structure, key, gint(numerator), gint(denominator))
+        case .intRange(let range):
+            swift_gst_structure_set_int_range(
+                structure, key, gint(range.lowerBound), gint(range.upperBound))
+        case .fractionRange(let min, let max):
+            swift_gst_structure_set_fraction_range(
+                structure, key,
+                gint(min.numerator), gint(min.denominator),
+                gint(max.numerator), gint(max.denominator))
+        case .list(let values):
+            let list = swift_gst_value_list_new()
+            for item in values {
+                switch item {
+                case .int(let int):
+                    swift_gst_value_list_append_int(list, gint(int))
+                case .string(let string):
+                    swift_gst_value_list_append_string(list, string)
+                case .fraction(let numerator, let denominator):
+                    swift_gst_value_list_append_fraction(list, gint(numerator), gint(denominator))
+                default:
+                    // Nested ranges and lists are not used by any builder;
+                    // fall back to the string form rather than dropping them.
+                    swift_gst_value_list_append_string(list, item.serialized)
+                }
+            }
+            swift_gst_structure_take_list(structure, key, list)
+        }
     }
 }
 
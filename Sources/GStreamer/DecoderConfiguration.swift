@@ -0,0 +1,164 @@
+import CGStreamer
+import CGStreamerShim
+import Synchronization
+
+/// Tuning for the elements a `uridecodebin` or `decodebin` plugs in.
+///
+/// Auto-plugged decoders start with their default settings: as many threads
+/// as the machine has cores, and whichever factory has the highest rank.
+/// That suits one stream decoded as fast as possible, but with dozens of
+/// streams per machine the threads oversubscribe the cores. A configuration
+/// is applied to every element the decodebin adds, as it is added and before
+/// it starts, and can reorder or exclude candidate factories for this
+/// pipeline only.
+///
+/// ## Example
+///
+/// ```swift
+/// // Many streams per core: single-threaded decoders, never the hardware one
+/// let configuration = DecoderConfiguration(
+///     maxThreads: 1,
+///     rankOverrides: ["vah264dec": 0, "avdec_h264": DecoderConfiguration.primaryRank + 1]
+/// ) { element in
+///     if element.hasProperty("output-corrupt") {
+///         element.set("output-corrupt", false)
+///     }
+/// }
+///
+/// // Applied by runPipeline and withPipeline
+/// let source = URIDecodeSource.file(path: "/media/camera1.mp4").configured(configuration)
+///
+/// // Or, for a pipeline written as a string
+/// let pipeline = try Pipeline("uridecodebin name=dec uri=file:///media/camera1.mp4 ! fakesink")
+/// try pipeline.configureDecoders(named: "dec", configuration)
+/// ```
+public struct DecoderConfiguration: Sendable {
+    /// `GST_RANK_PRIMARY`, the rank of a factory preferred by default.
+    public static let primaryRank = 256
+    /// `GST_RANK_SECONDARY`.
+    public static let secondaryRank = 128
+    /// `GST_RANK_MARGINAL`, the lowest rank decodebin considers.
+    public static let marginalRank = 64
+
+    /// Value for `max-threads` on every added element that has it, such as
+    /// the libav decoders. `nil` keeps each element's default.
+    public var maxThreads: Int?
+
+    /// Replacement ranks by factory name, for this pipeline only.
+    ///
+    /// Candidates for each stream are tried from highest rank to lowest, so
+    /// raising a factory above ``primaryRank`` prefers it and a rank of 0
+    /// excludes it. Overrides can only reorder the factories decodebin
+    /// already considered; a factory ranked below ``marginalRank`` in the
+    /// registry is never offered. `decodebin3` and `uridecodebin3` choose
+    /// decoders differently and ignore overrides.
+    public var rankOverrides: [String: Int]
+
+    /// Called with every element the decodebin adds, after ``maxThreads``
+    /// has been applied.
+    ///
+    /// Runs on the streaming thread that is plugging the element, before the
+    /// element changes state, so it must return quickly.
+    public var elementSetup: (@Sendable (Element) -> Void)?
+
+    /// Create a decoder configuration.
+    ///
+    /// - Parameters:
+    ///   - maxThreads: Thread limit for decoders that support one.
+    ///   - rankOverrides: Replacement factory ranks; 0 excludes a factory.
+    ///   - elementSetup: Called with every added element.
+    public init(
+        maxThreads: Int? = nil,
+        rankOverrides: [String: Int] = [:],
+        elementSetup: (@Sendable (Element) -> Void)? = nil
+    ) {
+        self.maxThreads = maxThreads
+        self.rankOverrides = rankOverrides
+        self.elementSetup = elementSetup
+    }
+
+    // MARK: - Naming
+
+    private static let nextID = Atomic<Int>(0)
+
+    /// A unique element name for a decodebin that a typed source configures.
+    ///
+    /// Typed sources choose the name once, when they are created, so every
+    /// description they write names the same element.
+    internal static func uniqueElementName() -> String {
+        "swiftdecodebin\(nextID.add(1, ordering: .relaxed).newValue)"
+    }
+
+    // MARK: - Applying
+
+    private final class Context: Sendable {
+        let configuration: DecoderConfiguration
+
+        init(_ configuration: DecoderConfiguration) {
+            self.configuration = configuration
+        }
+    }
+
+    /// Install the hooks on a decodebin.
+    internal func apply(to decodebin: Element) {
+        if maxThreads != nil || elementSetup != nil {
+            let callback: SwiftGstElementAddedCallback = { element, userData in
+                guard let element, let userData else { return }
+                let configuration = Unmanaged<Context>.fromOpaque(userData).takeUnretainedValue().configuration
+                let added = Element(
+                    element: gst_object_ref(element).assumingMemoryBound(to: GstElement.self))
+
+                if let maxThreads = configuration.maxThreads, added.hasProperty("max-threads") {
+                    added.set("max-threads", maxThreads)
+                }
+                configuration.elementSetup?(added)
+            }
+            let release: GDestroyNotify = { userData in
+                guard let userData else { return }
+                Unmanaged<Context>.fromOpaque(userData).release()
+            }
+            swift_gst_bin_observe_added_elements(
+                decodebin.element, callback, Unmanaged.passRetained(Context(self)).toOpaque(), release)
+        }
+
+        guard !rankOverrides.isEmpty else { return }
+        let overrides = Array(rankOverrides)
+        let names = overrides.map { g_strdup($0.key) }
+        defer { names.forEach { g_free($0) } }
+        let ranks = overrides.map { gint(clamping: max($0.value, 0)) }
+
+        _ = swift_gst_decodebin_set_rank_overrides(
+            decodebin.element, names.map { UnsafePointer($0) }, ranks, guint(overrides.count))
+    }
+}
+
+extension Pipeline {
+    /// Tune the elements a decodebin in this pipeline auto-plugs.
+    ///
+    /// Call before the pipeline leaves NULL; elements already plugged are
+    /// not revisited.
+    ///
+    /// ```swift
+    /// let pipeline = try Pipeline("uridecodebin name=dec uri=rtsp://camera/stream ! fakesink")
+    /// try pipeline.configureDecoders(named: "dec", DecoderConfiguration(maxThreads: 2))
+    /// ```
+    ///
+    /// - Parameters:
+    ///   - name: The name of a `uridecodebin` or `decodebin` in the pipeline.
+    ///   - configuration: The configuration to apply.
+    /// - Throws: ``GStreamerError/elementNotFound(_:)`` if no element has
+    ///   that name.
+    public func configureDecoders(named name: String, _ configuration: DecoderConfiguration) throws {
+        guard let decodebin = element(named: name) else {
+            throw GStreamerError.elementNotFound(name)
+        }
+        configuration.apply(to: decodebin)
+    }
+
+    /// Apply the decoder configurations a typed pipeline carries, by element name.
+    internal func configureDecoders(_ configurations: [String: DecoderConfiguration]) throws {
+        for (name, configuration) in configurations {
+            try configureDecoders(named: name, configuration)
+        }
+    }
+}
@@ -13,6 +13,7 @@ import CGStreamerShim
 /// - ``displayName``
 /// - ``deviceClass``
 /// - ``caps``
+/// - ``supportedCaps``
 ///
 /// ### Creating Elements
 ///
@@ -79,6 +80,17 @@ public final class Device: @unchecked Sendable {
         return GLibString.takeOwnership(swift_gst_caps_to_string(gstCaps))
     }
 
+    /// The capabilities of the device as a ``Caps`` value.
+    ///
+    /// Use this to intersect device capabilities with a requested format
+    /// without going through a caps string.
+    public var supportedCaps: Caps? {
+        guard let gstCaps = swift_gst_device_get_caps(device) else {
+            return nil
+        }
+        return Caps(caps: gstCaps, ownsReference: true)
+    }
+
     /// Get a device property by name.
     ///
     /// - Parameter name: The property name (e.g., "device.path", "device.api").
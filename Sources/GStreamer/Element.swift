@@ -203,6 +203,22 @@ public final class Element: @unchecked Sendable {
         swift_gst_element_set_double(element, key, value)
     }
 
+    /// Set a caps property on this element.
+    ///
+    /// - Parameters:
+    ///   - key: The property name.
+    ///   - value: The caps value.
+    ///
+    /// ## Example
+    ///
+    /// ```swift
+    /// // Constrain a capsfilter without re-parsing a pipeline
+    /// filter.set("caps", try Caps("video/x-raw,width=640,height=480"))
+    /// ```
+    public func set(_ key: String, _ value: Caps) {
+        swift_gst_element_set_caps(element, key, value.caps)
+    }
+
     // MARK: - Property Getters
 
     /// Get a boolean property from this element.
@@ -302,6 +318,20 @@ public final class Element: @unchecked Sendable {
         return Element(element: el, ownsReference: true)
     }
 
+    /// Whether an element factory is installed.
+    ///
+    /// Checks the plugin registry without creating an element.
+    ///
+    /// - Parameter factory: The factory name (e.g., "x264enc").
+    /// - Returns: `true` if the factory can be instantiated.
+    public static func isAvailable(factory: String) -> Bool {
+        guard let elementFactory = gst_element_factory_find(factory) else {
+            return false
+        }
+        gst_object_unref(UnsafeMutableRawPointer(elementFactory))
+        return true
+    }
+
     // MARK: - Pads and Linking
 
     /// Get a static pad from the element.
@@ -0,0 +1,358 @@
+import CGStreamer
+import CGStreamerApp
+import CGStreamerShim
+
+/// An encoded access unit with its NAL units located.
+///
+/// Packagers and muxers need to know where each NAL unit starts, what type
+/// it is and whether the frame is a keyframe carrying its parameter sets.
+/// `EncodedFrame` finds the NAL boundaries once, when the frame is created,
+/// from the stream format in the caps: Annex B start codes (`byte-stream`)
+/// or length prefixes (`avc`, `hvc1`). The NAL units themselves are never
+/// copied; read them in place with ``withBytes(of:_:)`` or pass them on as
+/// buffers sharing the original memory with ``buffer(for:)``.
+///
+/// ```swift
+/// let pipeline = try Pipeline("""
+///     v4l2src ! videoconvert ! x264enc tune=zerolatency ! \
+///     h264parse ! video/x-h264,stream-format=byte-stream,alignment=au ! \
+///     appsink name=sink
+///     """)
+/// let sink = try pipeline.appSink(named: "sink")
+/// try pipeline.play()
+///
+/// for try await frame in sink.encodedFrames() {
+///     if frame.isKeyframe && !frame.containsParameterSets {
+///         insertCachedParameterSets()
+///     }
+///     for unit in frame.nalUnits {
+///         try frame.withBytes(of: unit) { packager.append($0) }
+///     }
+/// }
+/// ```
+///
+/// Frames of other codecs, such as encoded audio, carry their buffer and
+/// caps with no NAL units.
+public struct EncodedFrame: @unchecked Sendable {
+    /// The codec named by the caps.
+    public enum Codec: Sendable, Hashable {
+        case h264
+        case h265
+        /// Any other media type, by caps name (e.g. `"audio/mpeg"`).
+        case other(String)
+
+        init(mediaType: String) {
+            switch mediaType {
+            case "video/x-h264": self = .h264
+            case "video/x-h265": self = .h265
+            default: self = .other(mediaType)
+            }
+        }
+    }
+
+    /// How NAL units are delimited in the buffer.
+    public enum StreamFormat: Sendable, Hashable {
+        /// Annex B start codes (`00 00 01` or `00 00 00 01`).
+        case byteStream
+        /// Each NAL unit is preceded by its size in this many bytes, as in
+        /// `avc` and `hvc1` streams.
+        case lengthPrefixed(Int)
+    }
+
+    /// One NAL unit within the frame.
+    public struct NALUnit: Sendable, Hashable {
+        /// The `nal_unit_type` from the NAL header.
+        public let type: UInt8
+        /// Offset of the NAL header in the buffer, after any start code or
+        /// length prefix.
+        public let offset: Int
+        /// Size in bytes, including the NAL header.
+        public let size: Int
+    }
+
+    /// The encoded data.
+    public let buffer: Buffer
+
+    /// The stream's caps, when known.
+    public let caps: Caps?
+
+    /// The codec the caps describe.
+    public let codec: Codec
+
+    /// How NAL units are delimited, or `nil` for codecs without NAL units.
+    public let streamFormat: StreamFormat?
+
+    /// NAL units in decoding order. Empty for codecs other than H.264 and H.265.
+    public let nalUnits: [NALUnit]
+
+    /// Out-of-band codec configuration from the caps' `codec_data`, such as
+    /// an `avcC` record or an AAC AudioSpecificConfig, when the caps carry one.
+    public var codecData: Buffer? {
+        guard let caps, let data = swift_gst_caps_get_codec_data(caps.caps) else {
+            return nil
+        }
+        _ = swift_gst_buffer_ref(data)
+        return Buffer(buffer: data, ownsReference: true)
+    }
+
+    /// Create a frame from a buffer and the caps it was negotiated with.
+    ///
+    /// NAL units are located immediately; this is the only pass over the data.
+    ///
+    /// - Parameters:
+    ///   - buffer: The encoded access unit.
+    ///   - caps: The caps of the stream, used for the codec and stream format.
+    public init(buffer: Buffer, caps: Caps?) {
+        let structure = caps?.structure(at: 0)
+        let codec = Codec(mediaType: structure?.name ?? "")
+
+        var streamFormat: StreamFormat?
+        if codec == .h264 || codec == .h265 {
+            switch structure?.string("stream-format") {
+            case "avc", "avc3", "hvc1", "hev1":
+                let codecData = caps.flatMap { swift_gst_caps_get_codec_data($0.caps) }
+                streamFormat = .lengthPrefixed(Self.nalLengthSize(codecData: codecData, codec: codec))
+            default:
+                streamFormat = .byteStream
+            }
+        }
+
+        self.buffer = buffer
+        self.caps = caps
+        self.codec = codec
+        self.streamFormat = streamFormat
+        self.nalUnits = streamFormat.map { Self.locateNALUnits(in: buffer, format: $0, codec: codec) } ?? []
+    }
+
+    // MARK: - Timing
+
+    /// Presentation timestamp in nanoseconds.
+    public var pts: UInt64? { buffer.pts }
+
+    /// Decode timestamp in nanoseconds.
+    public var dts: UInt64? { buffer.dts }
+
+    /// Duration in nanoseconds.
+    public var duration: UInt64? { buffer.duration }
+
+    // MARK: - Frame Properties
+
+    /// Whether the frame can be decoded without earlier frames.
+    ///
+    /// For H.264 and H.265 this is decided by the NAL units (IDR, or any
+    /// IRAP picture for H.265). Otherwise the buffer's delta-unit flag,
+    /// as set by parsers and encoders, is used.
+    public var isKeyframe: Bool {
+        switch codec {
+        case .h264 where !nalUnits.isEmpty:
+            return nalUnits.contains { $0.type == 5 }
+        case .h265 where !nalUnits.isEmpty:
+            return nalUnits.contains { (16...23).contains($0.type) }
+        default:
+            return swift_gst_buffer_is_delta_unit(buffer.buffer) == 0
+        }
+    }
+
+    /// Whether the frame carries a sequence parameter set.
+    public var containsSPS: Bool {
+        contains(h264: 7, h265: 33)
+    }
+
+    /// Whether the frame carries a picture parameter set.
+    public var containsPPS: Bool {
+        contains(h264: 8, h265: 34)
+    }
+
+    /// Whether the frame carries a video parameter set (H.265 only).
+    public var containsVPS: Bool {
+        codec == .h265 && nalUnits.contains { $0.type == 32 }
+    }
+
+    /// Whether the frame carries every parameter set its codec needs to
+    /// start decoding.
+    public var containsParameterSets: Bool {
+        switch codec {
+        case .h264: return containsSPS && containsPPS
+        case .h265: return containsVPS && containsSPS && containsPPS
+        case .other: return false
+        }
+    }
+
+    private func contains(h264: UInt8, h265: UInt8) -> Bool {
+        switch codec {
+        case .h264: return nalUnits.contains { $0.type == h264 }
+        case .h265: return nalUnits.contains { $0.type == h265 }
+        case .other: return false
+        }
+    }
+
+    // MARK: - NAL Unit Access
+
+    /// Read a NAL unit in place.
+    ///
+    /// - Parameters:
+    ///   - unit: One of this frame's ``nalUnits``.
+    ///   - body: Receives the NAL unit's bytes, header included. The span is
+    ///     only valid inside the closure.
+    /// - Returns: The value returned by `body`.
+    /// - Throws: ``GStreamerError/bufferMapFailed`` if the buffer can't be
+    ///   mapped or `unit` doesn't fit in it, or any error from `body`.
+    public func withBytes<R>(of unit: NALUnit, _ body: (RawSpan) throws -> R) throws -> R {
+        var mapInfo = GstMapInfo()
+        guard swift_gst_buffer_map_read(buffer.buffer, &mapInfo) != 0 else {
+            throw GStreamerError.bufferMapFailed
+        }
+        defer { swift_gst_buffer_unmap(buffer.buffer, &mapInfo) }
+        guard unit.offset >= 0, unit.offset + unit.size <= Int(mapInfo.size), let data = mapInfo.data else {
+            throw GStreamerError.bufferMapFailed
+        }
+        return try body(RawSpan(_unsafeStart: data + unit.offset, byteCount: unit.size))
+    }
+
+    /// A buffer holding just one NAL unit, sharing this frame's memory.
+    ///
+    /// - Parameter unit: One of this frame's ``nalUnits``.
+    /// - Returns: The sub-buffer, or `nil` if `unit` doesn't fit in the buffer.
+    public func buffer(for unit: NALUnit) -> Buffer? {
+        guard unit.offset >= 0, unit.size >= 0,
+            let region = swift_gst_buffer_share_region(buffer.buffer, gsize(unit.offset), gsize(unit.size))
+        else {
+            return nil
+        }
+        return Buffer(buffer: region, ownsReference: true)
+    }
+
+    // MARK: - Parsing
+
+    /// NAL length size from `avcC` or `hvcC` codec data; 4 when absent.
+    private static func nalLengthSize(codecData: UnsafeMutablePointer<GstBuffer>?, codec: Codec) -> Int {
+        guard let codecData else { return 4 }
+        // lengthSizeMinusOne is in the low two bits of byte 4 of avcC and byte 21 of hvcC.
+        let index = codec == .h265 ? 21 : 4
+        var byte: UInt8 = 0
+        guard gst_buffer_extract(codecData, gsize(index), &byte, 1) == 1 else { return 4 }
+        return Int(byte & 0x03) + 1
+    }
+
+    private static func locateNALUnits(in buffer: Buffer, format: StreamFormat, codec: Codec) -> [NALUnit] {
+        var mapInfo = GstMapInfo()
+        guard swift_gst_buffer_map_read(buffer.buffer, &mapInfo) != 0 else { return [] }
+        defer { swift_gst_buffer_unmap(buffer.buffer, &mapInfo) }
+        guard let data = mapInfo.data else { return [] }
+        let bytes = UnsafeRawBufferPointer(start: data, count: Int(mapInfo.size))
+
+        let ranges: [Range<Int>]
+        switch format {
+        case .byteStream:
+            ranges = startCodeRanges(in: bytes)
+        case .lengthPrefixed(let lengthSize):
+            ranges = lengthPrefixedRanges(in: bytes, lengthSize: lengthSize)
+        }
+
+        return ranges.compactMap { range in
+            guard !range.isEmpty else { return nil }
+            let header = bytes[range.lowerBound]
+            let type = codec == .h265 ? (header >> 1) & 0x3F : header & 0x1F
+            return NALUnit(type: type, offset: range.lowerBound, size: range.count)
+        }
+    }
+
+    /// NAL unit ranges between Annex B start codes.
+    private static func startCodeRanges(in bytes: UnsafeRawBufferPointer) -> [Range<Int>] {
+        var starts: [Int] = []
+        var index = 0
+        while index + 2 < bytes.count {
+            // A start code ends in 01; any larger byte rules out the three
+            // start codes that could overlap it.
+            if bytes[index + 2] > 1 {
+                index += 3
+            } else if bytes[index] == 0 && bytes[index + 1] == 0 && bytes[index + 2] == 1 {
+                starts.append(index + 3)
+                index += 3
+            } else {
+                index += 1
+            }
+        }
+
+        return starts.indices.map { position in
+            var end = position + 1 < starts.count ? starts[position + 1] - 3 : bytes.count
+            // Drop the leading zero of a 4-byte start code and trailing_zero_8bits.
+            while end > starts[position] && bytes[end - 1] == 0 {
+                end -= 1
+            }
+            return starts[position]..<end
+        }
+    }
+
+    /// NAL unit ranges after big-endian length prefixes.
+    private static func lengthPrefixedRanges(in bytes: UnsafeRawBufferPointer, lengthSize: Int) -> [Range<Int>] {
+        var ranges: [Range<Int>] = []
+        var index = 0
+        while index + lengthSize <= bytes.count {
+            var length = 0
+            for byte in bytes[index..<(index + lengthSize)] {
+                length = length << 8 | Int(byte)
+            }
+            index += lengthSize
+            // A truncated unit means the data isn't length-prefixed as declared.
+            guard length <= bytes.count - index else { break }
+            ranges.append(index..<(index + length))
+            index += length
+        }
+        return ranges
+    }
+}
+
+extension AppSink {
+    /// Encoded frames pulled from an appsink, with NAL units located.
+    public struct EncodedFrames: AsyncSequence {
+        let sink: AppSink
+
+        public struct AsyncIterator: AsyncIteratorProtocol {
+            let sink: AppSink
+
+            @concurrent
+            public func next() async throws -> EncodedFrame? {
+                while !Task.isCancelled {
+                    if let sample = swift_gst_app_sink_try_pull_sample(sink.appSink, 100_000_000) {
+                        defer { swift_gst_sample_unref(UnsafeMutableRawPointer(sample)) }
+
+                        guard let gstBuffer = swift_gst_sample_get_buffer(UnsafeMutableRawPointer(sample)),
+                            swift_gst_buffer_get_size(gstBuffer) > 0
+                        else {
+                            continue
+                        }
+                        let caps = swift_gst_sample_get_caps(UnsafeMutableRawPointer(sample)).map {
+                            Caps(caps: swift_gst_caps_ref($0), ownsReference: true)
+                        }
+                        _ = swift_gst_buffer_ref(gstBuffer)
+                        return EncodedFrame(buffer: Buffer(buffer: gstBuffer, ownsReference: true), caps: caps)
+                    }
+
+                    if swift_gst_app_sink_is_eos(sink.appSink) != 0 {
+                        // A sink stopped by a pipeline restart reads as EOS too.
+                        guard sink.isRestarting else { break }
+                        try? await Task.sleep(for: .milliseconds(10))
+                        continue
+                    }
+
+                    await Task.yield()
+                }
+
+                return nil
+            }
+        }
+
+        public func makeAsyncIterator() -> AsyncIterator {
+            AsyncIterator(sink: sink)
+        }
+    }
+
+    /// Encoded frames from this sink, with codec caps and NAL units.
+    ///
+    /// Use for sinks after an encoder or parser, such as `h264parse`, in
+    /// place of ``frames()``, which assumes raw video.
+    public func encodedFrames() -> EncodedFrames {
+        EncodedFrames(sink: self)
+    }
+}
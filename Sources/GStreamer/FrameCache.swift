@@ -0,0 +1,320 @@
+import CGStreamer
+
+/// A memory-bounded cache of decoded frames for random access around a playhead.
+///
+/// Review tools step back and forth over the same few seconds. Without a
+/// cache every step seeks and decodes again from the previous keyframe.
+/// `FrameCache` keeps recently decoded ``VideoFrame``s keyed by presentation
+/// timestamp and evicts the least recently used ones once `capacity` bytes are
+/// held. Cached frames are references to the sink's buffers, so caching a
+/// frame costs no copy.
+///
+/// The cache drives its pipeline: it seeks for frames it doesn't have and
+/// decodes windows around the playhead in the background with
+/// ``prefetch(around:behind:ahead:)``. Give it a pipeline of its own, with
+/// an appsink that doesn't sync to the clock:
+///
+/// ```swift
+/// let pipeline = try Pipeline("""
+///     uridecodebin uri=file:///review/shot.mov ! videoconvert ! \
+///     video/x-raw,format=BGRA ! appsink name=sink sync=false
+///     """)
+/// let cache = FrameCache(pipeline: pipeline, sink: try pipeline.appSink(named: "sink"))
+/// try await pipeline.pause(timeout: .seconds(5))
+///
+/// // Step through frames; nearby frames become lookups
+/// let frame = try await cache.frame(at: playhead)
+/// await cache.prefetch(around: playhead)
+/// ```
+///
+/// Every cached frame keeps its buffer alive. If the buffers come from a
+/// fixed-size pool upstream, keep `capacity` below what the pool can spare.
+public actor FrameCache {
+    /// Errors specific to the frame cache.
+    public enum CacheError: Error, Sendable, CustomStringConvertible {
+        /// The pipeline produced no frame for the position before the timeout.
+        case frameUnavailable(position: UInt64)
+
+        public var description: String {
+            switch self {
+            case .frameUnavailable(let position):
+                return "No frame was decoded at \(Timestamp(nanoseconds: position).formatted)"
+            }
+        }
+    }
+
+    /// Cache activity counters.
+    public struct Statistics: Sendable, Hashable {
+        /// Lookups answered from the cache.
+        public var hits = 0
+        /// Lookups that required a seek and decode.
+        public var misses = 0
+        /// Frames evicted to stay under capacity.
+        public var evictions = 0
+        /// Frames currently cached.
+        public var frames = 0
+        /// Bytes currently held by cached frames.
+        public var bytes = 0
+    }
+
+    private struct Entry {
+        let frame: VideoFrame
+        let size: Int
+        var lastUse: UInt64
+    }
+
+    /// The pipeline the cache seeks and decodes with.
+    public let pipeline: Pipeline
+
+    /// The sink frames are pulled from.
+    public let sink: AppSink
+
+    /// Maximum bytes of frame data kept alive.
+    public let capacity: Int
+
+    /// Maximum time to wait for a single frame.
+    public let timeout: Duration
+
+    private var entries: [UInt64: Entry] = [:]
+    /// Cached timestamps in ascending order, for covering lookups.
+    private var timestamps: [UInt64] = []
+    private var bytes = 0
+    private var clock: UInt64 = 0
+    private var counters = Statistics()
+
+    private var prefetchTask: Task<Void, Never>?
+    private var pipelineBusy = false
+    private var pipelineWaiters: [CheckedContinuation<Void, Never>] = []
+
+    /// Create a frame cache.
+    ///
+    /// - Parameters:
+    ///   - pipeline: A pipeline dedicated to the cache, in PAUSED before the
+    ///     first lookup.
+    ///   - sink: The pipeline's appsink; it should have `sync=false`.
+    ///   - capacity: Maximum bytes of frame data to keep.
+    ///   - timeout: Maximum time to wait for a single frame.
+    public init(
+        pipeline: Pipeline,
+        sink: AppSink,
+        capacity: Int = 512 * 1024 * 1024,
+        timeout: Duration = .seconds(2)
+    ) {
+        self.pipeline = pipeline
+        self.sink = sink
+        self.capacity = max(0, capacity)
+        self.timeout = timeout
+    }
+
+    deinit {
+        prefetchTask?.cancel()
+    }
+
+    /// Current cache counters.
+    public var statistics: Statistics {
+        var statistics = counters
+        statistics.frames = entries.count
+        statistics.bytes = bytes
+        return statistics
+    }
+
+    // MARK: - Lookup
+
+    /// The frame shown at a position, decoding it if it isn't cached.
+    ///
+    /// A frame covers its presentation timestamp until its duration ends or
+    /// the next cached frame starts.
+    ///
+    /// - Parameter position: A stream position in nanoseconds.
+    /// - Returns: The frame displayed at `position`.
+    /// - Throws: ``CacheError/frameUnavailable(position:)`` if nothing was
+    ///   decoded in time, or ``GStreamerError`` if seeking fails.
+    public func frame(at position: UInt64) async throws -> VideoFrame {
+        if let frame = lookup(position) {
+            counters.hits += 1
+            return frame
+        }
+        counters.misses += 1
+
+        prefetchTask?.cancel()
+        await acquirePipeline()
+        defer { releasePipeline() }
+
+        // Another caller may have decoded it while we waited.
+        if let frame = lookup(position) {
+            return frame
+        }
+
+        if pipeline.currentState() != .paused {
+            try await pipeline.pause(timeout: timeout)
+        }
+        try pipeline.seek(to: position, flags: [.flush, .accurate])
+        guard let frame = try await sink.preroll(timeout: timeout) else {
+            throw CacheError.frameUnavailable(position: position)
+        }
+        insert(frame)
+        return frame
+    }
+
+    /// The cached frame shown at a position, without decoding.
+    ///
+    /// - Parameter position: A stream position in nanoseconds.
+    /// - Returns: The frame, or `nil` if it isn't cached.
+    public func cachedFrame(at position: UInt64) -> VideoFrame? {
+        lookup(position)
+    }
+
+    /// Add a frame obtained elsewhere, such as from normal playback.
+    ///
+    /// Frames without a timestamp are ignored.
+    public func insert(_ frame: VideoFrame) {
+        guard let pts = frame.pts else { return }
+        let size = frame.withBuffer { Int(gst_buffer_get_size($0)) }
+
+        clock += 1
+        if let existing = entries.updateValue(Entry(frame: frame, size: size, lastUse: clock), forKey: pts) {
+            bytes -= existing.size
+        } else {
+            timestamps.insert(pts, at: insertionIndex(for: pts))
+        }
+        bytes += size
+
+        evict()
+    }
+
+    /// Drop every cached frame.
+    public func removeAll() {
+        entries.removeAll()
+        timestamps.removeAll()
+        bytes = 0
+    }
+
+    // MARK: - Prefetch
+
+    /// Decode the frames around a position in the background.
+    ///
+    /// Replaces any prefetch still running. Frames already cached at the
+    /// start of the window are skipped. A lookup that misses interrupts the
+    /// prefetch so it is never queued behind background work.
+    ///
+    /// - Parameters:
+    ///   - position: The playhead in nanoseconds.
+    ///   - behind: How much to decode before the playhead.
+    ///   - ahead: How much to decode after the playhead.
+    public func prefetch(
+        around position: UInt64,
+        behind: Duration = .seconds(1),
+        ahead: Duration = .seconds(2)
+    ) {
+        let behindNanoseconds = Timestamp(duration: max(behind, .zero)).nanoseconds
+        let aheadNanoseconds = Timestamp(duration: max(ahead, .zero)).nanoseconds
+        let start = position > behindNanoseconds ? position - behindNanoseconds : 0
+        let stop = position &+ aheadNanoseconds
+
+        prefetchTask?.cancel()
+        prefetchTask = Task { [weak self] in
+            await self?.decode(from: start, to: stop)
+        }
+    }
+
+    /// Play the range `start..<stop` through the sink and cache every frame.
+    private func decode(from start: UInt64, to stop: UInt64) async {
+        await acquirePipeline()
+        defer { releasePipeline() }
+
+        // Skip the part of the window that is already cached.
+        var start = start
+        while start < stop, let index = coveringIndex(for: start) {
+            start = coverageEnd(at: index)
+        }
+        guard start < stop, !Task.isCancelled else { return }
+
+        do {
+            try pipeline.seek(from: start, to: stop, flags: [.flush, .accurate])
+            try await pipeline.play(timeout: timeout)
+            for try await frame in sink.frames() {
+                insert(frame)
+                if Task.isCancelled { break }
+            }
+        } catch {
+            // A failed prefetch leaves the cache as it was.
+        }
+        _ = try? await pipeline.pause(timeout: timeout)
+    }
+
+    // MARK: - Storage
+
+    private func lookup(_ position: UInt64) -> VideoFrame? {
+        guard let index = coveringIndex(for: position),
+            var entry = entries[timestamps[index]]
+        else {
+            return nil
+        }
+        clock += 1
+        entry.lastUse = clock
+        entries[timestamps[index]] = entry
+        return entry.frame
+    }
+
+    /// Index of the cached frame shown at `position`, if any.
+    private func coveringIndex(for position: UInt64) -> Int? {
+        let next = insertionIndex(for: position &+ 1)
+        guard next > 0 else { return nil }
+        let index = next - 1
+        return position < coverageEnd(at: index) ? index : nil
+    }
+
+    /// Where the frame at `index` stops being shown.
+    private func coverageEnd(at index: Int) -> UInt64 {
+        let pts = timestamps[index]
+        let duration = entries[pts]?.frame.duration ?? 0
+        let end = pts &+ max(duration, 1)
+        if index + 1 < timestamps.count {
+            return min(timestamps[index + 1], end)
+        }
+        return end
+    }
+
+    /// First index whose timestamp is not less than `pts`.
+    private func insertionIndex(for pts: UInt64) -> Int {
+        var low = 0
+        var high = timestamps.count
+        while low < high {
+            let mid = (low + high) / 2
+            if timestamps[mid] < pts {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        return low
+    }
+
+    private func evict() {
+        while bytes > capacity, let oldest = entries.min(by: { $0.value.lastUse < $1.value.lastUse }) {
+            entries.removeValue(forKey: oldest.key)
+            timestamps.remove(at: insertionIndex(for: oldest.key))
+            bytes -= oldest.value.size
+            counters.evictions += 1
+        }
+    }
+
+    // MARK: - Pipeline Access
+
+    private func acquirePipeline() async {
+        if !pipelineBusy {
+            pipelineBusy = true
+            return
+        }
+        await withCheckedContinuation { pipelineWaiters.append($0) }
+    }
+
+    private func releasePipeline() {
+        if pipelineWaiters.isEmpty {
+            pipelineBusy = false
+        } else {
+            // Hand the pipeline straight to the next waiter.
+            pipelineWaiters.removeFirst().resume()
+        }
+    }
+}
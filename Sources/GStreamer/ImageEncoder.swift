@@ -0,0 +1,339 @@
+import CGStreamer
+import CGStreamerShim
+
+/// Encodes video frames to JPEG or PNG on long-lived pipelines.
+///
+/// Building `appsrc ! jpegenc ! appsink` for every snapshot pays for parsing,
+/// element creation and a state change each time. `ImageEncoder` keeps one
+/// warm pipeline per input size and pixel format and reuses it for every
+/// frame with that shape.
+///
+/// Frames are handed over by reference: the pipeline sees a shallow copy of
+/// the frame's buffer that shares its memory. Each submission is tagged with
+/// a sequence number so results are matched to their request, which lets
+/// several requests be in flight at once: while one frame is being encoded
+/// the next is already being converted.
+///
+/// ## Example
+///
+/// ```swift
+/// let encoder = ImageEncoder(format: .jpeg(quality: 85))
+///
+/// for try await frame in sink.frames() {
+///     let jpeg = try await encoder.encode(frame)
+///     try jpeg.bytes.withUnsafeBytes { try save($0) }
+/// }
+///
+/// await encoder.close()
+/// ```
+///
+/// ## Throughput
+///
+/// Concurrent callers share the pipelines, up to `maxInFlight` frames at a
+/// time:
+///
+/// ```swift
+/// let images = try await encoder.encode(frames)  // results in input order
+/// ```
+public actor ImageEncoder {
+    /// The output image format.
+    public enum Format: Sendable, Hashable {
+        /// JPEG with quality 0-100.
+        case jpeg(quality: Int)
+        /// PNG with zlib compression level 0-9.
+        case png(compressionLevel: Int)
+
+        /// The encoder element description.
+        var element: String {
+            switch self {
+            case .jpeg(let quality):
+                return JPEGEncoder(quality: quality).pipeline
+            case .png(let compressionLevel):
+                return PNGEncoder(compressionLevel: compressionLevel).pipeline
+            }
+        }
+    }
+
+    /// Errors specific to image encoding.
+    public enum EncoderError: Error, Sendable, CustomStringConvertible {
+        /// The frame is compressed or has unknown dimensions.
+        case unsupportedFrame(PixelFormat)
+
+        /// The encoder was closed before the frame was encoded.
+        case closed
+
+        public var description: String {
+            switch self {
+            case .unsupportedFrame(let format):
+                return "Cannot encode \(format) frames; a raw frame with known dimensions is required"
+            case .closed:
+                return "Image encoder was closed"
+            }
+        }
+    }
+
+    /// Input shape a pipeline is configured for.
+    private struct Key: Hashable {
+        let width: Int
+        let height: Int
+        let pixelFormat: PixelFormat
+    }
+
+    /// One warm `appsrc ! videoconvert ! queue ! encoder ! appsink` pipeline.
+    private final class Worker: @unchecked Sendable {
+        let pipeline: Pipeline
+        let source: AppSource
+        let sink: AppSink
+
+        init(key: Key, format: Format) throws {
+            pipeline = try Pipeline(
+                """
+                appsrc name=src format=time ! videoconvert ! queue ! \(format.element) ! \
+                appsink name=sink sync=false
+                """
+            )
+            source = try pipeline.appSource(named: "src")
+            sink = try pipeline.appSink(named: "sink")
+
+            source.setCaps(
+                CapsBuilder.video()
+                    .format(key.pixelFormat)
+                    .size(width: key.width, height: key.height)
+                    .framerate(0, 1)
+                    .buildCaps()
+            )
+
+            do {
+                try pipeline.play()
+            } catch {
+                pipeline.stop()
+                throw error
+            }
+        }
+
+        deinit {
+            pipeline.stop()
+        }
+    }
+
+    /// A submitted frame waiting for its encoded result.
+    private struct Pending {
+        let continuation: CheckedContinuation<Buffer, any Error>
+        let pts: UInt64?
+        let duration: UInt64?
+    }
+
+    /// The configured output format.
+    public let format: Format
+
+    /// Maximum number of frames submitted to the pipelines at once.
+    public let maxInFlight: Int
+
+    /// Maximum number of distinct input shapes kept warm.
+    public let maxPipelines: Int
+
+    private var workers: [Key: Worker] = [:]
+    private var readers: [Key: Task<Void, Never>] = [:]
+    private var pending: [Key: [UInt64: Pending]] = [:]
+    private var nextSequence: UInt64 = 0
+    private var inFlight = 0
+    private var waiters: [CheckedContinuation<Void, Never>] = []
+    private var isClosed = false
+
+    /// Create an image encoder.
+    ///
+    /// Pipelines are created lazily for each input size and pixel format.
+    ///
+    /// - Parameters:
+    ///   - format: The output image format.
+    ///   - maxInFlight: Maximum frames submitted at once across all callers.
+    ///   - maxPipelines: Maximum number of input shapes kept warm; idle
+    ///     pipelines are dropped beyond this.
+    public init(format: Format = .jpeg(quality: 85), maxInFlight: Int = 4, maxPipelines: Int = 4) {
+        self.format = format
+        self.maxInFlight = max(1, maxInFlight)
+        self.maxPipelines = max(1, maxPipelines)
+    }
+
+    deinit {
+        for reader in readers.values {
+            reader.cancel()
+        }
+    }
+
+    /// Encode one frame.
+    ///
+    /// - Parameter frame: A raw video frame. Its pixels are not copied.
+    /// - Returns: The encoded image, carrying the frame's timestamps.
+    /// - Throws: ``EncoderError`` if the frame can't be encoded or the encoder
+    ///   is closed, or ``GStreamerError`` if the pipeline fails.
+    public func encode(_ frame: VideoFrame) async throws -> Buffer {
+        guard !frame.format.isCompressed, frame.width > 0, frame.height > 0 else {
+            throw EncoderError.unsupportedFrame(frame.format)
+        }
+        guard !isClosed else { throw EncoderError.closed }
+
+        await acquireSlot()
+        defer { releaseSlot() }
+        guard !isClosed else { throw EncoderError.closed }
+
+        let key = Key(width: frame.width, height: frame.height, pixelFormat: frame.format)
+        let worker = try worker(for: key)
+
+        // The sequence number travels through the pipeline as the PTS of a
+        // shallow copy; the frame's own timestamps are restored on output.
+        let sequence = nextSequence
+        nextSequence += 1
+        guard let submission = frame.withBuffer({ gst_buffer_copy($0) }) else {
+            throw GStreamerError.bufferMapFailed
+        }
+        defer { swift_gst_buffer_unref(submission) }
+        swift_gst_buffer_set_pts(submission, GstClockTime(sequence))
+        swift_gst_buffer_set_dts(submission, swift_gst_clock_time_none())
+        swift_gst_buffer_set_duration(submission, swift_gst_clock_time_none())
+
+        return try await withCheckedThrowingContinuation { continuation in
+            pending[key, default: [:]][sequence] = Pending(
+                continuation: continuation,
+                pts: frame.pts,
+                duration: frame.duration
+            )
+            do {
+                try worker.source.push(buffer: submission)
+            } catch {
+                pending[key]?[sequence] = nil
+                continuation.resume(throwing: error)
+            }
+        }
+    }
+
+    /// Encode several frames concurrently.
+    ///
+    /// - Parameter frames: Raw video frames.
+    /// - Returns: The encoded images, in the same order as `frames`.
+    public func encode(_ frames: [VideoFrame]) async throws -> [Buffer] {
+        try await withThrowingTaskGroup(of: (Int, Buffer).self) { group in
+            for (index, frame) in frames.enumerated() {
+                group.addTask {
+                    (index, try await self.encode(frame))
+                }
+            }
+
+            var results = [Buffer?](repeating: nil, count: frames.count)
+            for try await (index, buffer) in group {
+                results[index] = buffer
+            }
+            return results.compactMap { $0 }
+        }
+    }
+
+    /// Stop all pipelines and fail any outstanding requests.
+    public func close() {
+        isClosed = true
+        for key in Array(workers.keys) {
+            retire(key, error: EncoderError.closed)
+        }
+        // Waiters wake to find the encoder closed; count them as holding a
+        // slot so their release balances.
+        inFlight += waiters.count
+        for waiter in waiters {
+            waiter.resume()
+        }
+        waiters.removeAll()
+    }
+
+    // MARK: - Pipelines
+
+    private func worker(for key: Key) throws -> Worker {
+        if let worker = workers[key] {
+            return worker
+        }
+
+        if workers.count >= maxPipelines,
+            let idle = workers.keys.first(where: { pending[$0]?.isEmpty ?? true })
+        {
+            retire(idle, error: EncoderError.closed)
+        }
+
+        let worker = try Worker(key: key, format: format)
+        workers[key] = worker
+        readers[key] = Task { [weak self, worker] in
+            do {
+                // appsink never reaches EOS if the pipeline fails, so a bus
+                // watcher turns errors into a thrown error.
+                try await withThrowingTaskGroup(of: Void.self) { group in
+                    group.addTask {
+                        for await message in worker.pipeline.bus.messages(filter: .error) {
+                            if case .error(let text, let debug) = message {
+                                throw GStreamerError.busError(text, source: nil, debug: debug)
+                            }
+                        }
+                    }
+                    group.addTask {
+                        for try await output in worker.sink.frames() {
+                            await self?.complete(output, key: key)
+                        }
+                    }
+                    _ = try await group.next()
+                    group.cancelAll()
+                }
+                await self?.retire(key, worker: worker, error: EncoderError.closed)
+            } catch {
+                await self?.retire(key, worker: worker, error: error)
+            }
+        }
+        return worker
+    }
+
+    /// Match an encoded buffer to its request by sequence number.
+    private func complete(_ output: VideoFrame, key: Key) {
+        guard let sequence = output.pts,
+            let request = pending[key]?.removeValue(forKey: sequence)
+        else { return }
+
+        guard let copy = gst_buffer_copy(output.buffer) else {
+            request.continuation.resume(throwing: GStreamerError.bufferMapFailed)
+            return
+        }
+        var buffer = Buffer(buffer: copy, ownsReference: true)
+        buffer.pts = request.pts
+        buffer.duration = request.duration
+        request.continuation.resume(returning: buffer)
+    }
+
+    /// Tear down a pipeline and fail its outstanding requests.
+    ///
+    /// - Parameter worker: When given, only retire if it is still the
+    ///   pipeline for `key` (a stale reader must not stop its replacement).
+    private func retire(_ key: Key, worker: Worker? = nil, error: any Error) {
+        if let worker, workers[key] !== worker {
+            return
+        }
+        readers.removeValue(forKey: key)?.cancel()
+        workers.removeValue(forKey: key)?.pipeline.stop()
+        if let requests = pending.removeValue(forKey: key) {
+            for request in requests.values {
+                request.continuation.resume(throwing: error)
+            }
+        }
+    }
+
+    // MARK: - In-Flight Limit
+
+    private func acquireSlot() async {
+        if inFlight < maxInFlight {
+            inFlight += 1
+            return
+        }
+        await withCheckedContinuation { waiters.append($0) }
+    }
+
+    private func releaseSlot() {
+        if waiters.isEmpty {
+            inFlight -= 1
+        } else {
+            // Hand the slot straight to the next waiter.
+            waiters.removeFirst().resume()
+        }
+    }
+}
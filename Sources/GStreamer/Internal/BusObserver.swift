@@ -0,0 +1,47 @@
+import CGStreamer
+import CGStreamerShim
+
+/// Calls a handler for every message posted on a pipeline's bus, on the
+/// posting thread, without removing anything from the bus.
+///
+/// The handler runs synchronously in the streaming or state-change thread
+/// that posted the message. It must return quickly and must not change the
+/// state of, or seek, the pipeline it observes; hand that work to a task.
+/// Observation stops when the observer is released.
+internal final class BusObserver: @unchecked Sendable {
+    private final class Handler: Sendable {
+        let body: @Sendable (UnsafeMutablePointer<GstMessage>) -> Void
+
+        init(_ body: @escaping @Sendable (UnsafeMutablePointer<GstMessage>) -> Void) {
+            self.body = body
+        }
+    }
+
+    private let bus: UnsafeMutablePointer<GstBus>
+    private let id: gulong
+
+    /// - Parameters:
+    ///   - pipeline: The pipeline whose bus to observe.
+    ///   - handler: Called with each borrowed message.
+    init?(pipeline: Pipeline, handler: @escaping @Sendable (UnsafeMutablePointer<GstMessage>) -> Void) {
+        guard let bus = swift_gst_element_get_bus(pipeline._element) else { return nil }
+
+        let observer: SwiftGstBusSyncObserver = { message, userData in
+            guard let message, let userData else { return }
+            Unmanaged<Handler>.fromOpaque(userData).takeUnretainedValue().body(message)
+        }
+        let release: GDestroyNotify = { userData in
+            guard let userData else { return }
+            Unmanaged<Handler>.fromOpaque(userData).release()
+        }
+
+        self.bus = bus
+        self.id = swift_gst_bus_add_sync_observer(
+            bus, observer, Unmanaged.passRetained(Handler(handler)).toOpaque(), release)
+    }
+
+    deinit {
+        swift_gst_bus_remove_sync_observer(bus, id)
+        swift_gst_object_unref(bus)
+    }
+}
@@ -45,6 +45,22 @@ extension String {
 
         return String(self[start..<end])
     }
+
+    /// The string as a double-quoted pipeline description value.
+    ///
+    /// Spaces, `!` and other characters that are special to `gst_parse_launch`
+    /// are kept as part of the value instead of splitting the description.
+    internal var pipelineQuoted: String {
+        var result = "\""
+        for char in self {
+            if char == "\"" || char == "\\" {
+                result.append("\\")
+            }
+            result.append(char)
+        }
+        result.append("\"")
+        return result
+    }
 }
 
 extension Substring {
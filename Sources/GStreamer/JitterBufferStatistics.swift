@@ -0,0 +1,101 @@
+import CGStreamer
+import CGStreamerShim
+
+/// Packet counters from one `rtpjitterbuffer`.
+///
+/// RTP sources such as `rtspsrc` keep a jitterbuffer per stream inside
+/// their session manager. Its counters show whether a camera feed is
+/// healthy: packets lost on the network, packets arriving too late to be
+/// played out within the latency budget, and how much the arrival times
+/// vary.
+///
+/// ```swift
+/// for await snapshot in pipeline.jitterBufferStatistics(every: .seconds(1)) {
+///     for stream in snapshot where stream.lost > 0 {
+///         print("\(stream.element): \(stream.lost) lost, jitter \(stream.jitter)")
+///     }
+/// }
+/// ```
+public struct JitterBufferStatistics: Sendable, Hashable, CustomStringConvertible {
+    /// Name of the jitterbuffer element.
+    public var element: String
+    /// Packets pushed downstream.
+    public var pushed: UInt64
+    /// Packets that never arrived.
+    public var lost: UInt64
+    /// Packets that arrived after their playout deadline and were dropped.
+    public var late: UInt64
+    /// Duplicate packets dropped.
+    public var duplicates: UInt64
+    /// Average interarrival jitter.
+    public var jitter: Duration
+    /// How full the buffer is, from 0 to 100. Only meaningful with
+    /// ``RTSPVideoSource/BufferMode/buffer``; otherwise 0.
+    public var percent: Int
+
+    public var description: String {
+        let microseconds = jitter.components.seconds * 1_000_000 + jitter.components.attoseconds / 1_000_000_000_000
+        return "\(element): pushed \(pushed), lost \(lost), late \(late), duplicates \(duplicates), "
+            + "jitter \(microseconds)µs, \(percent)%"
+    }
+
+    /// Read the counters of a jitterbuffer, or `nil` if it has no statistics.
+    internal init?(jitterBuffer: Element) {
+        guard let stats = swift_gst_element_get_structure(jitterBuffer.element, "stats") else { return nil }
+        defer { gst_structure_free(stats) }
+
+        func counter(_ field: String) -> UInt64 {
+            var value: guint64 = 0
+            return gst_structure_get_uint64(stats, field, &value) != 0 ? UInt64(value) : 0
+        }
+
+        self.element = jitterBuffer.name
+        self.pushed = counter("num-pushed")
+        self.lost = counter("num-lost")
+        self.late = counter("num-late")
+        self.duplicates = counter("num-duplicates")
+        self.jitter = .nanoseconds(Int64(clamping: counter("avg-jitter")))
+        self.percent = jitterBuffer.hasProperty("percent") ? jitterBuffer.getInt("percent") : 0
+    }
+}
+
+extension Pipeline {
+    /// Current counters of every `rtpjitterbuffer` in the pipeline,
+    /// including those inside `rtspsrc` and other bins.
+    ///
+    /// Empty until the RTP session has been set up, which for `rtspsrc`
+    /// happens while the pipeline goes to PAUSED.
+    public func jitterBufferStatistics() -> [JitterBufferStatistics] {
+        var statistics: [JitterBufferStatistics] = []
+        var index: guint = 0
+        while let jitterBuffer = swift_gst_bin_find_by_factory(_element, "rtpjitterbuffer", index) {
+            if let stream = JitterBufferStatistics(jitterBuffer: Element(element: jitterBuffer)) {
+                statistics.append(stream)
+            }
+            index += 1
+        }
+        return statistics
+    }
+
+    /// Jitterbuffer counters sampled at a fixed interval.
+    ///
+    /// Each element holds one entry per jitterbuffer. Sampling reads element
+    /// properties and never touches the ``bus``. The stream finishes when
+    /// the consumer stops iterating or the pipeline is released.
+    ///
+    /// - Parameter interval: Time between samples.
+    public func jitterBufferStatistics(every interval: Duration) -> AsyncStream<[JitterBufferStatistics]> {
+        AsyncStream(bufferingPolicy: .bufferingNewest(1)) { continuation in
+            let task = Task { [weak self] in
+                while !Task.isCancelled {
+                    // Only hold the pipeline while sampling.
+                    guard let statistics = self?.jitterBufferStatistics() else { break }
+                    continuation.yield(statistics)
+                    try? await Task.sleep(for: interval)
+                }
+                continuation.finish()
+            }
+            continuation.onTermination = { _ in task.cancel() }
+        }
+    }
+}
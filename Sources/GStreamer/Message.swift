@@ -71,6 +71,128 @@ public final class Message: @unchecked Sendable {
     }
 }
 
+// MARK: - Payloads
+
+extension Message {
+    /// The name of the object that posted the message.
+    ///
+    /// Decoded on access; nothing is copied when the message is received.
+    public var sourceName: String? {
+        swift_gst_message_src(message).flatMap { GLibString.takeOwnership(gst_object_get_name($0)) }
+    }
+
+    /// The message's structure, if it carries one.
+    ///
+    /// The returned ``Structure`` keeps this message alive and decodes fields
+    /// lazily. Element, application and most stats messages carry their
+    /// payload here.
+    public var structure: Structure? {
+        guard let pointer = gst_message_get_structure(message) else { return nil }
+        return Structure(pointer: pointer, owner: self)
+    }
+
+    /// Quality-of-service data from a QoS message.
+    ///
+    /// Returns `nil` for other message types.
+    public var qos: QoS? {
+        guard swift_gst_message_type(message) == GST_MESSAGE_QOS else { return nil }
+
+        var live: gboolean = 0
+        var runningTime: guint64 = 0
+        var streamTime: guint64 = 0
+        var timestamp: guint64 = 0
+        var duration: guint64 = 0
+        gst_message_parse_qos(message, &live, &runningTime, &streamTime, &timestamp, &duration)
+
+        var jitter: gint64 = 0
+        var proportion: gdouble = 0
+        var quality: gint = 0
+        gst_message_parse_qos_values(message, &jitter, &proportion, &quality)
+
+        var format: GstFormat = GST_FORMAT_UNDEFINED
+        var processed: guint64 = 0
+        var dropped: guint64 = 0
+        gst_message_parse_qos_stats(message, &format, &processed, &dropped)
+
+        return QoS(
+            live: live != 0,
+            runningTime: UInt64(runningTime),
+            streamTime: UInt64(streamTime),
+            timestamp: UInt64(timestamp),
+            duration: UInt64(duration),
+            jitter: Int64(jitter),
+            proportion: Double(proportion),
+            quality: Int(quality),
+            processed: UInt64(processed),
+            dropped: UInt64(dropped)
+        )
+    }
+
+    /// Thread status from a stream-status message.
+    ///
+    /// Returns `nil` for other message types.
+    public var streamStatus: StreamStatus? {
+        guard swift_gst_message_type(message) == GST_MESSAGE_STREAM_STATUS else { return nil }
+
+        var type: GstStreamStatusType = GST_STREAM_STATUS_TYPE_CREATE
+        var owner: UnsafeMutablePointer<GstElement>?
+        gst_message_parse_stream_status(message, &type, &owner)
+
+        let ownerName = owner.flatMap {
+            GLibString.takeOwnership(gst_object_get_name(UnsafeMutableRawPointer($0).assumingMemoryBound(to: GstObject.self)))
+        }
+        return StreamStatus(
+            kind: StreamStatus.Kind(rawValue: Int32(bitPattern: type.rawValue)) ?? .unknown,
+            owner: ownerName
+        )
+    }
+
+    /// Quality-of-service data reported by an element that dropped or
+    /// late-rendered data.
+    public struct QoS: Sendable, Hashable {
+        /// Whether the message came from a live element.
+        public let live: Bool
+        /// Running time of the affected buffer in nanoseconds.
+        public let runningTime: UInt64
+        /// Stream time of the affected buffer in nanoseconds.
+        public let streamTime: UInt64
+        /// Timestamp of the affected buffer in nanoseconds.
+        public let timestamp: UInt64
+        /// Duration of the affected buffer in nanoseconds.
+        public let duration: UInt64
+        /// How late the buffer was, in nanoseconds. Negative means early.
+        public let jitter: Int64
+        /// Long-term processing rate relative to real time (1.0 is real time).
+        public let proportion: Double
+        /// Element-specific quality level.
+        public let quality: Int
+        /// Total buffers processed by the element so far.
+        public let processed: UInt64
+        /// Total buffers dropped by the element so far.
+        public let dropped: UInt64
+    }
+
+    /// Lifecycle of a streaming thread.
+    public struct StreamStatus: Sendable, Hashable {
+        /// What happened to the thread.
+        public enum Kind: Int32, Sendable {
+            case create = 0
+            case enter = 1
+            case leave = 2
+            case destroy = 3
+            case start = 8
+            case pause = 9
+            case stop = 10
+            case unknown = -1
+        }
+
+        /// What happened to the thread.
+        public let kind: Kind
+        /// Name of the element that owns the thread.
+        public let owner: String?
+    }
+}
+
 // MARK: - MessageType
 
 extension Message {
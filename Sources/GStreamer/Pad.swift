@@ -131,6 +131,20 @@ public final class Pad: @unchecked Sendable {
         return GLibString.takeOwnership(swift_gst_caps_to_string(caps))
     }
 
+    /// All caps this pad could accept or produce right now.
+    ///
+    /// Unlike ``currentCaps``, this works before negotiation: for an element
+    /// that isn't in a pipeline yet it reports the element's full capabilities,
+    /// which makes it useful for checking compatibility without building one.
+    ///
+    /// - Returns: The queried caps, or `nil` if the query failed.
+    public func queryCaps() -> Caps? {
+        guard let caps = gst_pad_query_caps(pad, nil) else {
+            return nil
+        }
+        return Caps(caps: caps, ownsReference: true)
+    }
+
     // MARK: - Pad Probes
 
     /// Type of pad probe.
@@ -17,6 +17,7 @@ import Synchronization
 /// ### Creating Pipelines
 ///
 /// - ``init(_:)``
+/// - ``init(_:profileStartup:)``
 ///
 /// ### Controlling Playback
 ///
@@ -27,6 +28,19 @@ import Synchronization
 /// - ``currentState()``
 /// - ``State``
 ///
+/// ### Startup Profiling
+///
+/// - ``startupProfile``
+/// - ``StartupProfile``
+///
+/// ### Asynchronous State Changes
+///
+/// - ``play(timeout:)``
+/// - ``pause(timeout:)``
+/// - ``stop(timeout:)``
+/// - ``setState(_:timeout:)``
+/// - ``start(_:to:maxConcurrent:timeout:)``
+///
 /// ### Accessing Elements
 ///
 /// - ``element(named:)``
@@ -152,6 +166,12 @@ public final class Pipeline: @unchecked Sendable {
   /// Cached bus instance (thread-safe access).
   private let _bus = Mutex<Bus?>(nil)
 
+  /// Startup recorder, when profiling was requested.
+  private let profiler: StartupProfiler?
+
+  /// Restarts in progress, shared with the pipeline's app sinks.
+  internal let restarts = Restarts()
+
   /// Create a pipeline from a `gst-launch-1.0`-style description string.
   ///
   /// The description uses the same syntax as the `gst-launch-1.0` command-line tool.
@@ -179,9 +199,25 @@ public final class Pipeline: @unchecked Sendable {
   /// // Audio capture (Linux)
   /// let audio = try Pipeline("alsasrc device=hw:0 ! autoaudiosink")
   /// ```
-  public init(_ description: String) throws {
+  public convenience init(_ description: String) throws {
+    try self.init(description, profileStartup: false)
+  }
+
+  /// Create a pipeline, optionally recording where its startup time goes.
+  ///
+  /// With `profileStartup` enabled the parse time and every element's state
+  /// transitions are recorded until the pipeline reaches PLAYING, and are
+  /// available from ``startupProfile``. Messages are observed as they are
+  /// posted; nothing is removed from the ``bus``.
+  ///
+  /// - Parameters:
+  ///   - description: A GStreamer pipeline description.
+  ///   - profileStartup: Record a ``StartupProfile``.
+  /// - Throws: ``GStreamerError/parsePipeline(_:)`` if parsing fails.
+  public init(_ description: String, profileStartup: Bool) throws {
     try GStreamer.ensureInitialized()
 
+    let start = ContinuousClock.now
     var errorMessage: UnsafeMutablePointer<CChar>?
     guard let pipeline = swift_gst_parse_launch(description, &errorMessage) else {
       let message = GLibString.takeOwnership(errorMessage) ?? "Unknown error"
@@ -189,9 +225,18 @@ public final class Pipeline: @unchecked Sendable {
     }
     _ = GLibString.takeOwnership(errorMessage)  // Free if non-nil
     self._element = pipeline
+
+    if profileStartup {
+      let profiler = StartupProfiler(pipeline: pipeline, start: start)
+      profiler.attach()
+      self.profiler = profiler
+    } else {
+      self.profiler = nil
+    }
   }
 
   deinit {
+    profiler?.detach()
     _ = swift_gst_element_set_state(_element, GST_STATE_NULL)
     swift_gst_object_unref(_element)
   }
@@ -245,6 +290,7 @@ public final class Pipeline: @unchecked Sendable {
   /// try pipeline.setState(.playing) // Start streaming
   /// ```
   public func setState(_ state: State) throws {
+    profiler?.stateRequested()
     let currentState = self.currentState()
     let result = swift_gst_element_set_state(_element, state.gstState)
     if result == GST_STATE_CHANGE_FAILURE {
@@ -252,6 +298,14 @@ public final class Pipeline: @unchecked Sendable {
     }
   }
 
+  /// The recorded startup profile, or `nil` if the pipeline was created
+  /// without `profileStartup`.
+  ///
+  /// The profile is a snapshot; read it again to see later transitions.
+  public var startupProfile: StartupProfile? {
+    profiler?.profile
+  }
+
   /// Get the current pipeline state.
   ///
   /// Returns the current state of the pipeline. Note that state changes are
@@ -263,6 +317,254 @@ public final class Pipeline: @unchecked Sendable {
     return State(gstState: state)
   }
 
+  // MARK: - Asynchronous State Changes
+
+  /// Start the pipeline and wait until it is actually playing.
+  ///
+  /// Unlike ``play()``, this waits for preroll to finish (a camera opening,
+  /// a demuxer reading headers) without blocking a cooperative thread.
+  ///
+  /// - Parameter timeout: Maximum time to wait for the pipeline to reach PLAYING.
+  /// - Throws: ``GStreamerError/busError(_:source:debug:)`` if an element posts an
+  ///   error during the change, or ``GStreamerError/stateChangeFailed(element:from:to:)``
+  ///   if the change fails or times out.
+  ///
+  /// ## Example
+  ///
+  /// ```swift
+  /// let pipeline = try Pipeline("v4l2src ! videoconvert ! appsink name=sink")
+  /// try await pipeline.play(timeout: .seconds(5))
+  /// // The device is open and the first buffer has prerolled
+  /// ```
+  public func play(timeout: Duration) async throws {
+    try await setState(.playing, timeout: timeout)
+  }
+
+  /// Pause the pipeline and wait until it has prerolled.
+  ///
+  /// - Parameter timeout: Maximum time to wait for the pipeline to reach PAUSED.
+  /// - Throws: ``GStreamerError`` if the change fails, errors, or times out.
+  public func pause(timeout: Duration) async throws {
+    try await setState(.paused, timeout: timeout)
+  }
+
+  /// Stop the pipeline without blocking the caller while elements tear down.
+  ///
+  /// Closing devices and joining streaming threads can take a while; this
+  /// does that work off the cooperative thread pool.
+  ///
+  /// - Parameter timeout: Maximum time to wait for the pipeline to reach NULL.
+  public func stop(timeout: Duration) async {
+    _ = try? await setState(.null, timeout: timeout)
+  }
+
+  /// Set the pipeline state and wait for the change to complete.
+  ///
+  /// The state change runs on GStreamer's thread pool. When the pipeline
+  /// answers `GST_STATE_CHANGE_ASYNC`, the task suspends until the pipeline
+  /// reaches `state`, an element posts an error, or `timeout` expires. Errors
+  /// are observed without popping the bus, so ``bus`` consumers still receive
+  /// every message.
+  ///
+  /// Cancelling the calling task does not abort the state change; the call
+  /// returns once it completes or times out.
+  ///
+  /// - Parameters:
+  ///   - state: The desired state.
+  ///   - timeout: Maximum time to wait for an asynchronous change.
+  /// - Returns: The state the pipeline reached. Live pipelines report
+  ///   `state` as soon as it is committed, without prerolling.
+  /// - Throws: ``GStreamerError/busError(_:source:debug:)`` if an element posts an
+  ///   error during the change, or ``GStreamerError/stateChangeFailed(element:from:to:)``
+  ///   if the change fails or times out.
+  @discardableResult
+  public func setState(_ state: State, timeout: Duration) async throws -> State {
+    profiler?.stateRequested()
+    let outcome = await completion(timeout: timeout) { element, nanoseconds, callback, context in
+      swift_gst_element_set_state_async(element, state.gstState, nanoseconds, callback, context)
+    }
+    return try outcome.get(target: state)
+  }
+
+  /// Change the state of one element in the pipeline without blocking the
+  /// calling thread, such as a source being restarted on its own.
+  ///
+  /// - Parameters:
+  ///   - element: An element inside this pipeline.
+  ///   - state: The desired state.
+  ///   - timeout: Maximum time to wait for an asynchronous change.
+  /// - Returns: The state the element reached.
+  @discardableResult
+  internal func setState(of element: Element, to state: State, timeout: Duration) async throws -> State {
+    let outcome = await completion(of: element.element, timeout: timeout) { element, nanoseconds, callback, context in
+      swift_gst_element_set_state_async(element, state.gstState, nanoseconds, callback, context)
+    }
+    return try outcome.get(target: state)
+  }
+
+  /// Wait for a pending asynchronous state change to finish, without
+  /// requesting a new state.
+  ///
+  /// After a flushing seek the pipeline prerolls again; this suspends until
+  /// that completes, an element posts an error, or `timeout` expires.
+  ///
+  /// - Parameter timeout: Maximum time to wait.
+  /// - Returns: The pipeline's state once nothing is pending.
+  internal func settle(timeout: Duration) async throws -> State {
+    let outcome = await completion(timeout: timeout) { element, nanoseconds, callback, context in
+      swift_gst_element_wait_state_async(element, nanoseconds, callback, context)
+    }
+    return try outcome.get(target: currentState())
+  }
+
+  /// Run a state-change request on GStreamer's thread pool and suspend until
+  /// its callback reports the outcome.
+  private func completion(
+    of element: UnsafeMutablePointer<GstElement>? = nil,
+    timeout: Duration,
+    submit: (UnsafeMutablePointer<GstElement>, GstClockTime, SwiftGstStateChangeCallback, UnsafeMutableRawPointer) -> Void
+  ) async -> StateChangeOutcome {
+    await withCheckedContinuation { continuation in
+      let context = Unmanaged.passRetained(StateChangeContext(continuation: continuation))
+
+      let callback: SwiftGstStateChangeCallback = { result, current, message, source, userData in
+        guard let userData else { return }
+        let context = Unmanaged<StateChangeContext>.fromOpaque(userData).takeRetainedValue()
+        let state = State(gstState: current)
+
+        switch result {
+        case GST_STATE_CHANGE_SUCCESS, GST_STATE_CHANGE_NO_PREROLL:
+          context.continuation.resume(returning: .reached(state))
+        case GST_STATE_CHANGE_ASYNC:
+          context.continuation.resume(returning: .timedOut(state))
+        default:
+          context.continuation.resume(
+            returning: .failed(
+              state,
+              message: message.map { String(cString: $0) },
+              source: source.map { String(cString: $0) }
+            ))
+        }
+      }
+
+      submit(
+        element ?? _element,
+        GstClockTime(Timestamp(duration: max(timeout, .zero)).nanoseconds),
+        callback,
+        context.toOpaque()
+      )
+    }
+  }
+
+  /// Bring several pipelines to a state concurrently.
+  ///
+  /// At most `maxConcurrent` state changes are in flight at once, which
+  /// keeps device opens and decoder setup from all landing at the same
+  /// moment. A pipeline that fails doesn't affect the others.
+  ///
+  /// - Parameters:
+  ///   - pipelines: The pipelines to change.
+  ///   - state: The desired state.
+  ///   - maxConcurrent: Maximum number of simultaneous state changes.
+  ///   - timeout: Maximum time to wait for each pipeline.
+  /// - Returns: One result per pipeline, in the same order as `pipelines`.
+  ///
+  /// ## Example
+  ///
+  /// ```swift
+  /// let cameras = try urls.map { try Pipeline("rtspsrc location=\($0) ! fakesink") }
+  /// let results = await Pipeline.start(cameras, maxConcurrent: 4, timeout: .seconds(10))
+  ///
+  /// for (url, result) in zip(urls, results) {
+  ///     if case .failure(let error) = result {
+  ///         print("\(url): \(error)")
+  ///     }
+  /// }
+  /// ```
+  public static func start(
+    _ pipelines: [Pipeline],
+    to state: State = .playing,
+    maxConcurrent: Int = 4,
+    timeout: Duration
+  ) async -> [Result<State, any Error>] {
+    await withTaskGroup(of: (Int, Result<State, any Error>).self) { group in
+      var results = [Result<State, any Error>?](repeating: nil, count: pipelines.count)
+      var next = 0
+
+      func addNext() {
+        guard next < pipelines.count else { return }
+        let index = next
+        let pipeline = pipelines[index]
+        next += 1
+        group.addTask {
+          do {
+            return (index, .success(try await pipeline.setState(state, timeout: timeout)))
+          } catch {
+            return (index, .failure(error))
+          }
+        }
+      }
+
+      for _ in 0..<max(1, maxConcurrent) {
+        addNext()
+      }
+      while let (index, result) = await group.next() {
+        results[index] = result
+        addNext()
+      }
+
+      return results.map { $0! }
+    }
+  }
+
+  /// How an asynchronous state change ended.
+  private enum StateChangeOutcome: Sendable {
+    case reached(State)
+    case failed(State, message: String?, source: String?)
+    case timedOut(State)
+
+    /// The reached state, or the error describing why `target` wasn't reached.
+    func get(target: State) throws -> State {
+      switch self {
+      case .reached(let reached):
+        return reached
+      case .failed(_, let message?, let source):
+        throw GStreamerError.busError(message, source: source, debug: nil)
+      case .failed(let current, nil, _), .timedOut(let current):
+        throw GStreamerError.stateChangeFailed(element: nil, from: current, to: target)
+      }
+    }
+  }
+
+  /// Tracks restarts, such as a ``Watchdog`` cycling the pipeline through
+  /// `READY`, during which a stopped app sink is coming back rather than
+  /// finished.
+  internal final class Restarts: Sendable {
+    private let depth = Atomic<Int>(0)
+
+    /// Whether a restart is under way.
+    var inProgress: Bool {
+      depth.load(ordering: .acquiring) > 0
+    }
+
+    func begin() {
+      depth.add(1, ordering: .releasing)
+    }
+
+    func end() {
+      depth.subtract(1, ordering: .releasing)
+    }
+  }
+
+  /// Carries the continuation through the C callback's user data.
+  private final class StateChangeContext: Sendable {
+    let continuation: CheckedContinuation<StateChangeOutcome, Never>
+
+    init(continuation: CheckedContinuation<StateChangeOutcome, Never>) {
+      self.continuation = continuation
+    }
+  }
+
   /// The pipeline's message bus.
   ///
   /// Use the bus to receive messages about pipeline events like errors,
@@ -346,6 +648,36 @@ public final class Pipeline: @unchecked Sendable {
     try AppSink(pipeline: self, name: name)
   }
 
+  /// The most recent frame that reached a sink, fetched on request.
+  ///
+  /// Works with any sink that keeps its `last-sample` (`fakesink` does by
+  /// default; `appsink` needs `enable-last-sample=true`). Nothing runs in
+  /// Swift between calls, so monitoring pipelines that are rarely looked at
+  /// cost nothing while idle.
+  ///
+  /// - Parameter name: The sink element name.
+  /// - Returns: The latest frame, or `nil` if none has arrived yet.
+  /// - Throws: ``GStreamerError/elementNotFound(_:)`` if not found.
+  ///
+  /// ## Example
+  ///
+  /// ```swift
+  /// let pipeline = try Pipeline("rtspsrc location=rtsp://cam/stream ! decodebin ! videoconvert ! fakesink name=tap")
+  /// try pipeline.play()
+  ///
+  /// let frame = try pipeline.snapshot(of: "tap")
+  /// ```
+  public func snapshot(of name: String) throws -> VideoFrame? {
+    guard let sink = element(named: name) else {
+      throw GStreamerError.elementNotFound(name)
+    }
+    guard let sample = swift_gst_base_sink_get_last_sample(sink.element) else {
+      return nil
+    }
+    defer { swift_gst_sample_unref(UnsafeMutableRawPointer(sample)) }
+    return VideoFrame(sample: sample)
+  }
+
   /// Get an appsrc element from the pipeline.
   ///
   /// This is a convenience method for accessing appsrc elements used
@@ -376,6 +708,9 @@ public final class Pipeline: @unchecked Sendable {
   ///
   /// Returns `nil` if the position cannot be queried (e.g., pipeline not playing).
   ///
+  /// Each read runs a position query through the pipeline. To poll at
+  /// display rate, use a ``PlaybackClock`` instead.
+  ///
   /// ## Example
   ///
   /// ```swift
@@ -450,6 +785,44 @@ public final class Pipeline: @unchecked Sendable {
     public static let accurate = SeekFlags(
       rawValue: UInt32(swift_gst_seek_flag_accurate().rawValue))
 
+    /// Perform a segment seek.
+    ///
+    /// Instead of EOS, the pipeline posts a segment-done message when the
+    /// stop position is reached, which allows seamless looping.
+    public static let segment = SeekFlags(
+      rawValue: UInt32(swift_gst_seek_flag_segment().rawValue))
+
+    /// Snap to the keyframe at or before the requested position.
+    ///
+    /// Combine with ``keyUnit``.
+    public static let snapBefore = SeekFlags(
+      rawValue: UInt32(swift_gst_seek_flag_snap_before().rawValue))
+
+    /// Snap to the keyframe at or after the requested position.
+    ///
+    /// Combine with ``keyUnit``.
+    public static let snapAfter = SeekFlags(
+      rawValue: UInt32(swift_gst_seek_flag_snap_after().rawValue))
+
+    /// Snap to the keyframe nearest to the requested position.
+    ///
+    /// Combine with ``keyUnit``.
+    public static let snapNearest = SeekFlags(
+      rawValue: UInt32(swift_gst_seek_flag_snap_nearest().rawValue))
+
+    /// Allow elements to skip frames during playback (trick mode).
+    public static let trickmode = SeekFlags(
+      rawValue: UInt32(swift_gst_seek_flag_trickmode().rawValue))
+
+    /// Only decode and output keyframes (trick mode).
+    ///
+    /// Combine with ``trickmode``.
+    public static let trickmodeKeyUnits = SeekFlags(
+      rawValue: UInt32(swift_gst_seek_flag_trickmode_key_units().rawValue))
+
+    /// Deprecated alias for ``trickmode`` kept for parity with GStreamer.
+    public static let skip = SeekFlags(rawValue: UInt32(swift_gst_seek_flag_skip().rawValue))
+
     internal var gstFlags: GstSeekFlags {
       GstSeekFlags(rawValue: rawValue)
     }
@@ -501,6 +874,34 @@ public final class Pipeline: @unchecked Sendable {
     }
   }
 
+  /// Seek to a start position and play until a stop position.
+  ///
+  /// The pipeline plays the configured segment and then posts EOS (or
+  /// segment-done when ``SeekFlags/segment`` is set) once `stop` is reached.
+  ///
+  /// - Parameters:
+  ///   - start: The segment start in nanoseconds.
+  ///   - stop: The segment stop in nanoseconds, or `nil` to play to the end.
+  ///   - rate: The playback rate. Defaults to 1.0.
+  ///   - flags: Seek flags controlling the behavior.
+  /// - Throws: ``GStreamerError/seekFailed(position:)`` if the seek fails.
+  ///
+  /// ## Example
+  ///
+  /// ```swift
+  /// // Play only the range 10s..20s
+  /// try pipeline.seek(from: 10_000_000_000, to: 20_000_000_000, flags: [.flush, .accurate])
+  /// ```
+  public func seek(
+    from start: UInt64, to stop: UInt64?, rate: Double = 1.0, flags: SeekFlags
+  ) throws {
+    let gstStop = stop.map { gint64($0) } ?? -1
+    guard swift_gst_element_seek(_element, rate, gint64(start), gstStop, flags.gstFlags) != 0
+    else {
+      throw GStreamerError.seekFailed(position: start)
+    }
+  }
+
   // MARK: - Playback Rate
 
   /// Set the playback rate.
@@ -1,16 +1,114 @@
 /// RTSP source with low-latency settings, suitable for IP cameras.
+///
+/// The stream is depayloaded and decoded, so frames come out as raw video.
+/// `rtspsrc` buffers 2 seconds by default; this source defaults to no
+/// added latency. Watch packet loss with
+/// ``Pipeline/jitterBufferStatistics(every:)``.
+///
+/// ```swift
+/// let camera = RTSPVideoSource(
+///     location: "rtsp://camera.local/stream",
+///     latency: 200,
+///     transport: .tcp,
+///     dropOnLatency: true,
+///     startOnKeyframe: true
+/// )
+/// ```
 public struct RTSPVideoSource: VideoPipelineSource {
     public typealias VideoFrameOutput = VideoFrame
 
+    /// How RTP packets are carried.
+    public enum Transport: String, Sendable {
+        /// Let the server choose, trying UDP first.
+        case automatic
+        /// Interleaved in the RTSP TCP connection. Survives firewalls and
+        /// packet loss at the cost of head-of-line blocking.
+        case tcp
+        /// Unicast UDP. Lowest latency, but lost packets stay lost.
+        case udp
+    }
+
+    /// How the jitterbuffer schedules packets (`rtspsrc` `buffer-mode`).
+    public enum BufferMode: Int, Sendable {
+        /// Output packets as soon as they arrive, timestamped on arrival.
+        case none = 0
+        /// Follow the sender's clock, smoothing out jitter.
+        case slave = 1
+        /// Fill the buffer before playing; reports a fill percent.
+        case buffer = 2
+        /// Let `rtspsrc` choose.
+        case auto = 3
+        /// Follow the sender's timestamps with a synchronized clock.
+        case synced = 4
+    }
+
     private let location: String
     private let latency: Int
-    
+    private let transport: Transport
+    private let dropOnLatency: Bool
+    private let bufferMode: BufferMode?
+    /// Decodebin configuration that starts output on a keyframe, with the
+    /// name given to the decodebin.
+    private let decoder: (name: String, configuration: DecoderConfiguration)?
+
     public var pipeline: String {
-        "rtspsrc location=\(location) latency=\(latency)"
+        var options = ["rtspsrc location=\(location) latency=\(latency)"]
+        if transport != .automatic {
+            options.append("protocols=\(transport.rawValue)")
+        }
+        if dropOnLatency {
+            options.append("drop-on-latency=true")
+        }
+        if let bufferMode {
+            options.append("buffer-mode=\(bufferMode.rawValue)")
+        }
+        let decodebin = decoder.map { "decodebin name=\($0.name)" } ?? "decodebin"
+        return options.joined(separator: " ") + " ! " + decodebin
+    }
+
+    public var decoderConfigurations: [String: DecoderConfiguration] {
+        decoder.map { [$0.name: $0.configuration] } ?? [:]
     }
 
-    public init(location: String, latency: Int = 0) {
+    /// Create an RTSP source.
+    ///
+    /// - Parameters:
+    ///   - location: The `rtsp://` URL.
+    ///   - latency: Jitterbuffer latency budget in milliseconds.
+    ///   - transport: How RTP packets are carried.
+    ///   - dropOnLatency: Drop packets that would exceed the latency budget
+    ///     instead of growing it.
+    ///   - bufferMode: Jitterbuffer scheduling, or `nil` for the default.
+    ///   - startOnKeyframe: Hold back output until the first keyframe so
+    ///     decoding never starts on a partial picture, and ask the sender
+    ///     for a keyframe when packets are lost.
+    public init(
+        location: String,
+        latency: Int = 0,
+        transport: Transport = .automatic,
+        dropOnLatency: Bool = false,
+        bufferMode: BufferMode? = nil,
+        startOnKeyframe: Bool = false
+    ) {
         self.location = location
         self.latency = latency
+        self.transport = transport
+        self.dropOnLatency = dropOnLatency
+        self.bufferMode = bufferMode
+
+        if startOnKeyframe {
+            // The depayloader is auto-plugged, so set it up as it is added.
+            let configuration = DecoderConfiguration { element in
+                if element.hasProperty("wait-for-keyframe") {
+                    element.set("wait-for-keyframe", true)
+                }
+                if element.hasProperty("request-keyframe") {
+                    element.set("request-keyframe", true)
+                }
+            }
+            self.decoder = (DecoderConfiguration.uniqueElementName(), configuration)
+        } else {
+            self.decoder = nil
+        }
     }
-}
\ No newline at end of file
+}
@@ -1,19 +1,51 @@
 /// A source that decodes any URI (file, http, rtsp, etc.) and outputs raw video.
 /// Use this instead of `Playbin` when you need to chain elements after it (e.g., appsink).
+///
+/// Use ``configured(_:)`` to tune the decoders it plugs in, for example to
+/// limit their threads when many streams share a machine. ``runPipeline(buildPipeline:)``
+/// and ``withPipeline(buildPipeline:withEachFrame:)`` apply the configuration;
+/// when parsing ``pipeline`` yourself, apply ``decoderConfigurations`` with
+/// ``Pipeline/configureDecoders(named:_:)``.
 public struct URIDecodeSource: VideoPipelineSource {
     public typealias VideoFrameOutput = VideoFrame
 
     private let uri: String
+    /// Tuning for the decoders, with the name given to the `uridecodebin`.
+    private var decoder: (name: String, configuration: DecoderConfiguration)?
+
     public var pipeline: String {
         // videoscale allows scaling to target resolution
         // videoconvert allows format conversion
-        "uridecodebin uri=\(uri)"
+        if let decoder {
+            return "uridecodebin name=\(decoder.name) uri=\(uri)"
+        }
+        return "uridecodebin uri=\(uri)"
+    }
+
+    public var decoderConfigurations: [String: DecoderConfiguration] {
+        decoder.map { [$0.name: $0.configuration] } ?? [:]
     }
 
     public init(uri: String) {
         self.uri = uri
     }
 
+    /// Create a source whose auto-plugged elements are tuned by `configuration`.
+    public init(uri: String, configuration: DecoderConfiguration) {
+        self.uri = uri
+        self.decoder = (DecoderConfiguration.uniqueElementName(), configuration)
+    }
+
+    /// A copy of this source whose auto-plugged elements are tuned by `configuration`.
+    ///
+    /// ```swift
+    /// URIDecodeSource.rtsp("rtsp://camera/stream")
+    ///     .configured(DecoderConfiguration(maxThreads: 1))
+    /// ```
+    public func configured(_ configuration: DecoderConfiguration) -> Self {
+        URIDecodeSource(uri: uri, configuration: configuration)
+    }
+
     public static func rtsp(_ url: String) -> Self {
         URIDecodeSource(uri: url)
     }
@@ -25,4 +57,4 @@ public struct URIDecodeSource: VideoPipelineSource {
     public static func http(url: String) -> Self {
         URIDecodeSource(uri: url.hasPrefix("http") ? url : "http://\(url)")
     }
-}
\ No newline at end of file
+}
@@ -1,9 +1,20 @@
 public struct PartialPipeline<Element: Sendable>: Sendable {
     internal var pipeline: String
     internal var sinkName: String?
+    /// Decoder configurations collected from the elements, by element name.
+    internal var decoders: [String: DecoderConfiguration]
     
-    init(pipeline: String, sinkName: String? = nil) {
+    init(pipeline: String, sinkName: String? = nil, decoders: [String: DecoderConfiguration] = [:]) {
         self.pipeline = pipeline
         self.sinkName = sinkName
+        self.decoders = decoders
+    }
+
+    /// This pipeline linked to `next`, keeping both sides' decoder configurations.
+    func linked<Output>(to next: some VideoPipelineElement) -> PartialPipeline<Output> {
+        PartialPipeline<Output>(
+            pipeline: pipeline + " ! " + next.pipeline,
+            decoders: decoders.merging(next.decoderConfigurations) { $1 }
+        )
     }
 }
\ No newline at end of file
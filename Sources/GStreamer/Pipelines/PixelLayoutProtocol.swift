@@ -64,4 +64,64 @@ public enum GRAY8<
         "height=\(height)",
     ] }
     public typealias Rotated = GRAY8<height, width>
+}
+
+public enum YUY2<
+    let width: Int,
+    let height: Int
+>: PixelLayoutProtocol {
+    public static var name: String { "YUY2" }
+    public static var options: [String] { [
+        "width=\(width)",
+        "height=\(height)",
+    ] }
+    public typealias Rotated = YUY2<height, width>
+}
+
+public enum UYVY<
+    let width: Int,
+    let height: Int
+>: PixelLayoutProtocol {
+    public static var name: String { "UYVY" }
+    public static var options: [String] { [
+        "width=\(width)",
+        "height=\(height)",
+    ] }
+    public typealias Rotated = UYVY<height, width>
+}
+
+public enum P010_10LE<
+    let width: Int,
+    let height: Int
+>: PixelLayoutProtocol {
+    public static var name: String { "P010_10LE" }
+    public static var options: [String] { [
+        "width=\(width)",
+        "height=\(height)",
+    ] }
+    public typealias Rotated = P010_10LE<height, width>
+}
+
+public enum I420_10LE<
+    let width: Int,
+    let height: Int
+>: PixelLayoutProtocol {
+    public static var name: String { "I420_10LE" }
+    public static var options: [String] { [
+        "width=\(width)",
+        "height=\(height)",
+    ] }
+    public typealias Rotated = I420_10LE<height, width>
+}
+
+public enum GRAY16_LE<
+    let width: Int,
+    let height: Int
+>: PixelLayoutProtocol {
+    public static var name: String { "GRAY16_LE" }
+    public static var options: [String] { [
+        "width=\(width)",
+        "height=\(height)",
+    ] }
+    public typealias Rotated = GRAY16_LE<height, width>
 }
\ No newline at end of file
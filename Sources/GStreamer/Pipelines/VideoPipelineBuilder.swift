@@ -4,7 +4,7 @@ public struct VideoPipelineBuilder: Sendable {
     public static func buildPartialBlock<Source: VideoPipelineSource>(
         first source: Source
     ) -> PartialPipeline<Source.VideoFrameOutput> {
-        PartialPipeline(pipeline: source.pipeline)
+        PartialPipeline(pipeline: source.pipeline, decoders: source.decoderConfigurations)
     }
 
     /// Format step that transforms the frame type into a different format.
@@ -15,7 +15,7 @@ public struct VideoPipelineBuilder: Sendable {
         accumulated: PartialPipeline<Input>,
         next: some VideoFormat<Frame>
     ) -> PartialPipeline<Frame> {
-        PartialPipeline(pipeline: accumulated.pipeline + " ! " + next.pipeline)
+        accumulated.linked(to: next)
     }
 
     /// Convert step that transforms the frame type into a different format.
@@ -26,7 +26,7 @@ public struct VideoPipelineBuilder: Sendable {
         accumulated: PartialPipeline<Input>,
         next: some VideoPipelineConvert<Input, Output>
     ) -> PartialPipeline<Output> {
-        PartialPipeline(pipeline: accumulated.pipeline + " ! " + next.pipeline)
+        accumulated.linked(to: next)
     }
 
     /// Sink that terminates the pipeline (e.g., OSXVideoSink)
@@ -37,7 +37,7 @@ public struct VideoPipelineBuilder: Sendable {
         accumulated: PartialPipeline<Input>,
         next: Sink
     ) -> PartialPipeline<Never> where Sink.VideoFrameOutput == Never {
-        PartialPipeline(pipeline: accumulated.pipeline + " ! " + next.pipeline)
+        accumulated.linked(to: next)
     }
 
     // MARK: - Typed Element Builders
@@ -48,7 +48,7 @@ public struct VideoPipelineBuilder: Sendable {
         accumulated: PartialPipeline<_VideoFrame<Layout>>,
         next: some TypedConvertible
     ) -> PartialPipeline<_VideoFrame<Layout>> {
-        PartialPipeline(pipeline: accumulated.pipeline + " ! " + next._asTypedConvert(Layout.self).pipeline)
+        accumulated.linked(to: next._asTypedConvert(Layout.self))
     }
 
     /// Resolves a typed sink builder in a typed pipeline context.
@@ -56,7 +56,7 @@ public struct VideoPipelineBuilder: Sendable {
         accumulated: PartialPipeline<_VideoFrame<Layout>>,
         next: some TypedSinkable
     ) -> PartialPipeline<Never> {
-        PartialPipeline(pipeline: accumulated.pipeline + " ! " + next._asTypedSink(Layout.self).pipeline)
+        accumulated.linked(to: next._asTypedSink(Layout.self))
     }
 
     // MARK: - Non-Generic Steps (Fallback)
@@ -70,7 +70,7 @@ public struct VideoPipelineBuilder: Sendable {
         accumulated: PartialPipeline<Input>,
         next: some VideoPipelineConvert<VideoFrame, Output>
     ) -> PartialPipeline<Output> {
-        PartialPipeline(pipeline: accumulated.pipeline + " ! " + next.pipeline)
+        accumulated.linked(to: next)
     }
 
     /// Sink that terminates the pipeline (non-generic fallback).
@@ -82,7 +82,7 @@ public struct VideoPipelineBuilder: Sendable {
         accumulated: PartialPipeline<Input>,
         next: Sink
     ) -> PartialPipeline<Never> where Sink.VideoFrameOutput == Never {
-        PartialPipeline(pipeline: accumulated.pipeline + " ! " + next.pipeline)
+        accumulated.linked(to: next)
     }
 }
 
@@ -90,6 +90,14 @@ public struct VideoPipelineBuilder: Sendable {
 
 public protocol VideoPipelineElement: Sendable {
     var pipeline: String { get }
+
+    /// Configurations for decodebins this element's description names, by
+    /// element name. Applied once the pipeline is parsed.
+    var decoderConfigurations: [String: DecoderConfiguration] { get }
+}
+
+extension VideoPipelineElement {
+    public var decoderConfigurations: [String: DecoderConfiguration] { [:] }
 }
 
 public protocol VideoPipelineSource: VideoPipelineElement {
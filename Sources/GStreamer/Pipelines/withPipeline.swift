@@ -1,7 +1,9 @@
 public func runPipeline(
     @VideoPipelineBuilder buildPipeline: @Sendable () -> PartialPipeline<Never>
 ) async throws {
-    let pipeline = try Pipeline(buildPipeline().pipeline)
+    let partial = buildPipeline()
+    let pipeline = try Pipeline(partial.pipeline)
+    try pipeline.configureDecoders(partial.decoders)
     try pipeline.play()
     defer { pipeline.stop() }
     for await state in pipeline.bus.messages() {
@@ -45,6 +47,7 @@ public func runPipeline(
      ! appsink name=\(sinkname) sync=false drop=true max-buffers=1 emit-signals=true
     """
     let pipeline = try Pipeline(pipelineDescription)
+    try pipeline.configureDecoders(partial.decoders)
     let sink = try pipeline.appSink(named: sinkname)
     try pipeline.play()
     defer { pipeline.stop() }
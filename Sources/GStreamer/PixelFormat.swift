@@ -21,10 +21,22 @@
 ///
 /// - ``nv12``
 /// - ``i420``
+/// - ``yuy2``
+/// - ``uyvy``
+///
+/// ### High Bit Depth Formats
+///
+/// - ``p010``
+/// - ``i420_10le``
 ///
 /// ### Grayscale
 ///
 /// - ``gray8``
+/// - ``gray16le``
+///
+/// ### Compressed
+///
+/// - ``mjpeg``
 ///
 /// ### Other
 ///
@@ -33,7 +45,16 @@
 /// ### Format Properties
 ///
 /// - ``formatString``
+/// - ``mediaType``
+/// - ``isCompressed``
 /// - ``bytesPerPixel``
+/// - ``bitDepth``
+/// - ``planeCount``
+/// - ``chromaSubsampling``
+/// - ``planes(width:height:)``
+/// - ``frameSize(width:height:)``
+/// - ``Plane``
+/// - ``Subsampling``
 ///
 /// ## Example
 ///
@@ -77,6 +98,10 @@
 /// | NV12 | Hardware video decode output |
 /// | I420 | Video encoding, software processing |
 /// | GRAY8 | Grayscale processing, edge detection |
+/// | YUY2, UYVY | Native USB webcam output |
+/// | MJPEG | High-resolution USB webcam modes |
+/// | P010, I420_10LE | 10-bit (HDR) decoder output |
+/// | GRAY16_LE | Depth cameras |
 ///
 /// ```swift
 /// // Request BGRA for Metal rendering
@@ -132,6 +157,61 @@ public enum PixelFormat: Sendable, Hashable, CustomStringConvertible {
     /// Memory layout: `[G0][G1][G2][G3]...`
     case gray8
 
+    /// YUV 4:2:2 packed format, luma first (also known as YUYV).
+    ///
+    /// The most common uncompressed output of USB webcams. Each pair of
+    /// pixels shares one U and one V sample, giving 2 bytes per pixel.
+    ///
+    /// Memory layout: `[Y0][U0][Y1][V0] [Y2][U1][Y3][V1] ...`
+    case yuy2
+
+    /// YUV 4:2:2 packed format, chroma first.
+    ///
+    /// Same sampling as ``yuy2`` with the byte order swapped; produced by
+    /// some webcams and capture cards.
+    ///
+    /// Memory layout: `[U0][Y0][V0][Y1] [U1][Y2][V1][Y3] ...`
+    case uyvy
+
+    /// Motion JPEG: each frame is an independently compressed JPEG image.
+    ///
+    /// USB webcams use MJPEG for their high-resolution, high-framerate modes
+    /// because uncompressed video doesn't fit the USB bandwidth. Frames in
+    /// this format carry `image/jpeg` caps and have no plane layout; decode
+    /// them (e.g. with `jpegdec`) to get raw pixels.
+    case mjpeg
+
+    /// 10-bit YUV 4:2:0 semi-planar format (GStreamer `P010_10LE`).
+    ///
+    /// The high bit depth counterpart of ``nv12``, produced by hardware
+    /// decoders for HDR content. Each sample is a little-endian 16-bit word
+    /// with the 10 significant bits in the high bits.
+    ///
+    /// Memory layout:
+    /// - Y plane: `[Y0][Y1]...` (2 bytes per sample, full resolution)
+    /// - UV plane: `[U0][V0][U1][V1]...` (2 bytes per sample, half width, half height)
+    case p010
+
+    /// 10-bit YUV 4:2:0 planar format (GStreamer `I420_10LE`).
+    ///
+    /// The high bit depth counterpart of ``i420``, produced by software
+    /// decoders for 10-bit streams. Each sample is a little-endian 16-bit
+    /// word with the 10 significant bits in the low bits.
+    ///
+    /// Memory layout:
+    /// - Y plane: full resolution, 2 bytes per sample
+    /// - U plane: half width, half height, 2 bytes per sample
+    /// - V plane: half width, half height, 2 bytes per sample
+    case i420_10le
+
+    /// 16-bit little-endian grayscale format (GStreamer `GRAY16_LE`).
+    ///
+    /// Single channel, two bytes per pixel. Depth cameras use it to report
+    /// distances, typically in millimetres.
+    ///
+    /// Memory layout: `[G0 lo][G0 hi][G1 lo][G1 hi]...`
+    case gray16le
+
     /// Unknown or unsupported format.
     ///
     /// Contains the original format string from GStreamer.
@@ -159,6 +239,12 @@ public enum PixelFormat: Sendable, Hashable, CustomStringConvertible {
         case "NV12": self = .nv12
         case "I420": self = .i420
         case "GRAY8": self = .gray8
+        case "YUY2", "YUYV": self = .yuy2
+        case "UYVY": self = .uyvy
+        case "MJPEG", "MJPG", "JPEG": self = .mjpeg
+        case "P010_10LE", "P010": self = .p010
+        case "I420_10LE": self = .i420_10le
+        case "GRAY16_LE": self = .gray16le
         default: self = .unknown(string)
         }
     }
@@ -183,23 +269,51 @@ public enum PixelFormat: Sendable, Hashable, CustomStringConvertible {
         case .nv12: return "NV12"
         case .i420: return "I420"
         case .gray8: return "GRAY8"
+        case .yuy2: return "YUY2"
+        case .uyvy: return "UYVY"
+        case .mjpeg: return "MJPEG"
+        case .p010: return "P010_10LE"
+        case .i420_10le: return "I420_10LE"
+        case .gray16le: return "GRAY16_LE"
         case .unknown(let s): return s
         }
     }
 
+    /// The caps media type frames in this format are described with.
+    ///
+    /// ``mjpeg`` frames are `image/jpeg`; everything else is `video/x-raw`
+    /// with ``formatString`` as its `format` field.
+    public var mediaType: String {
+        switch self {
+        case .mjpeg: return "image/jpeg"
+        default: return "video/x-raw"
+        }
+    }
+
+    /// Whether frames in this format are compressed rather than raw pixels.
+    ///
+    /// Compressed frames have no plane layout and a variable size.
+    public var isCompressed: Bool {
+        self == .mjpeg
+    }
+
     /// The number of bytes per pixel for packed formats.
     ///
-    /// For planar formats (NV12, I420), this returns the bytes per sample
-    /// in the Y plane.
+    /// For planar formats (NV12, I420, P010, I420_10LE), this returns the
+    /// bytes per sample in the Y plane. Use ``planes(width:height:)`` or
+    /// ``frameSize(width:height:)`` for the size of a whole frame.
     ///
     /// | Format | Bytes per Pixel |
     /// |--------|-----------------|
     /// | BGRA | 4 |
     /// | RGBA | 4 |
+    /// | YUY2, UYVY | 2 |
     /// | NV12 | 1 (Y plane) |
     /// | I420 | 1 (Y plane) |
+    /// | P010, I420_10LE | 2 (Y plane) |
     /// | GRAY8 | 1 |
-    /// | unknown | 0 |
+    /// | GRAY16_LE | 2 |
+    /// | MJPEG, unknown | 0 |
     ///
     /// ## Example
     ///
@@ -212,9 +326,164 @@ public enum PixelFormat: Sendable, Hashable, CustomStringConvertible {
         switch self {
         case .bgra, .rgba: return 4
         case .gray8: return 1
+        case .yuy2, .uyvy, .gray16le: return 2
         case .nv12, .i420: return 1 // Planar format - this is per-plane for Y
-        case .unknown: return 0
+        case .p010, .i420_10le: return 2
+        case .mjpeg, .unknown: return 0
+        }
+    }
+
+    /// Significant bits per component, or 0 for compressed and unknown formats.
+    public var bitDepth: Int {
+        switch self {
+        case .bgra, .rgba, .nv12, .i420, .gray8, .yuy2, .uyvy: return 8
+        case .p010, .i420_10le: return 10
+        case .gray16le: return 16
+        case .mjpeg, .unknown: return 0
+        }
+    }
+
+    /// Number of memory planes in a frame.
+    ///
+    /// Packed formats have one plane; NV12 and P010 have two (Y, interleaved
+    /// UV); I420 and I420_10LE have three (Y, U, V). Compressed and unknown
+    /// formats report 0.
+    public var planeCount: Int {
+        switch self {
+        case .bgra, .rgba, .gray8, .gray16le, .yuy2, .uyvy: return 1
+        case .nv12, .p010: return 2
+        case .i420, .i420_10le: return 3
+        case .mjpeg, .unknown: return 0
+        }
+    }
+
+    /// Chroma subsampling factors relative to the luma resolution.
+    public var chromaSubsampling: Subsampling {
+        switch self {
+        case .nv12, .i420, .p010, .i420_10le: return .yuv420
+        case .yuy2, .uyvy: return .yuv422
+        default: return .none
+        }
+    }
+
+    /// The memory layout of one plane within a frame buffer.
+    public struct Plane: Sendable, Hashable {
+        /// Byte offset of the plane from the start of the buffer.
+        public let offset: Int
+        /// Bytes per row, including padding.
+        public let stride: Int
+        /// Samples (pixels, or chroma samples for subsampled planes) per row.
+        public let width: Int
+        /// Number of rows.
+        public let height: Int
+
+        /// Bytes covered by the plane's rows.
+        public var size: Int { stride * height }
+    }
+
+    /// Horizontal and vertical chroma subsampling factors.
+    public struct Subsampling: Sendable, Hashable {
+        /// Luma samples per chroma sample along a row.
+        public let horizontal: Int
+        /// Luma rows per chroma row.
+        public let vertical: Int
+
+        /// No subsampling (RGB, grayscale).
+        public static let none = Subsampling(horizontal: 1, vertical: 1)
+        /// 4:2:2, chroma at half width (YUY2, UYVY).
+        public static let yuv422 = Subsampling(horizontal: 2, vertical: 1)
+        /// 4:2:0, chroma at half width and half height (NV12, I420, P010).
+        public static let yuv420 = Subsampling(horizontal: 2, vertical: 2)
+    }
+
+    /// The plane layout GStreamer uses for a frame of this format.
+    ///
+    /// Matches the default `GstVideoInfo` layout: rows are padded to a
+    /// multiple of 4 bytes and chroma planes of 4:2:0 formats start after a
+    /// luma plane rounded up to an even number of rows. Buffers carrying
+    /// `GstVideoMeta` may use other strides.
+    ///
+    /// ```swift
+    /// let planes = PixelFormat.nv12.planes(width: 1920, height: 1080)
+    /// // planes[0]: offset 0, stride 1920, 1920x1080 (Y)
+    /// // planes[1]: offset 2073600, stride 1920, 960x540 (UV)
+    /// ```
+    ///
+    /// - Returns: One entry per plane, or an empty array for compressed and
+    ///   unknown formats.
+    public func planes(width: Int, height: Int) -> [Plane] {
+        let evenHeight = roundUp(height, 2)
+        let chromaWidth = roundUp(width, 2) / 2
+        let chromaHeight = evenHeight / 2
+
+        switch self {
+        case .bgra, .rgba:
+            return [Plane(offset: 0, stride: width * 4, width: width, height: height)]
+        case .gray8:
+            return [Plane(offset: 0, stride: roundUp(width, 4), width: width, height: height)]
+        case .gray16le:
+            return [Plane(offset: 0, stride: roundUp(width * 2, 4), width: width, height: height)]
+        case .yuy2, .uyvy:
+            return [Plane(offset: 0, stride: roundUp(roundUp(width, 2) * 2, 4), width: width, height: height)]
+        case .nv12, .p010:
+            let sampleBytes = bytesPerPixel
+            let stride = roundUp(width * sampleBytes, 4)
+            return [
+                Plane(offset: 0, stride: stride, width: width, height: height),
+                Plane(offset: stride * evenHeight, stride: stride, width: chromaWidth, height: chromaHeight),
+            ]
+        case .i420, .i420_10le:
+            let sampleBytes = bytesPerPixel
+            let lumaStride = roundUp(width * sampleBytes, 4)
+            let chromaStride = roundUp(chromaWidth * sampleBytes, 4)
+            let uOffset = lumaStride * evenHeight
+            let vOffset = uOffset + chromaStride * chromaHeight
+            return [
+                Plane(offset: 0, stride: lumaStride, width: width, height: height),
+                Plane(offset: uOffset, stride: chromaStride, width: chromaWidth, height: chromaHeight),
+                Plane(offset: vOffset, stride: chromaStride, width: chromaWidth, height: chromaHeight),
+            ]
+        case .mjpeg, .unknown:
+            return []
+        }
+    }
+
+    /// Total bytes of a frame in GStreamer's default layout.
+    ///
+    /// - Returns: The frame size, or `nil` for compressed and unknown formats.
+    public func frameSize(width: Int, height: Int) -> Int? {
+        guard let last = planes(width: width, height: height).last else { return nil }
+        return last.offset + last.size
+    }
+
+    /// Infer frame dimensions from a buffer size when caps carry none.
+    ///
+    /// Tries common camera and video resolutions first, then every multiple
+    /// of common aspect ratios, accepting only exact ``frameSize(width:height:)``
+    /// matches so padding and subsampling are accounted for.
+    internal func inferDimensions(frameSize size: Int) -> (width: Int, height: Int)? {
+        guard size > 0, planeCount > 0 else { return nil }
+
+        let common: [(Int, Int)] = [
+            (1920, 1080), (1280, 720), (3840, 2160), (640, 480), (320, 240),
+            (2560, 1440), (1280, 960), (1024, 768), (800, 600), (640, 360),
+            (352, 288), (176, 144), (160, 120),
+        ]
+        for (width, height) in common where frameSize(width: width, height: height) == size {
+            return (width, height)
         }
+
+        let aspectRatios: [(Int, Int)] = [(16, 9), (4, 3), (16, 10), (1, 1)]
+        for (w, h) in aspectRatios {
+            var scale = 1
+            while let candidate = frameSize(width: w * scale, height: h * scale), candidate <= size {
+                if candidate == size {
+                    return (w * scale, h * scale)
+                }
+                scale += 1
+            }
+        }
+        return nil
     }
 
     /// A human-readable description of the pixel format.
@@ -222,3 +491,8 @@ public enum PixelFormat: Sendable, Hashable, CustomStringConvertible {
         formatString
     }
 }
+
+/// Round `value` up to a multiple of `alignment` (a power of two).
+private func roundUp(_ value: Int, _ alignment: Int) -> Int {
+    (value + alignment - 1) & ~(alignment - 1)
+}
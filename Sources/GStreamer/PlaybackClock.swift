@@ -0,0 +1,388 @@
+import CGStreamer
+import CGStreamerShim
+import Synchronization
+
+/// A playback position that can be read at display rate without querying the pipeline.
+///
+/// ``Pipeline/position`` runs a position query that travels to the sinks and
+/// takes locks on the streaming path. That is fine once a second, but a UI
+/// that polls every frame for dozens of players pays for it continuously.
+///
+/// `PlaybackClock` instead derives the position the same way a sink does:
+/// from the last segment the sink received, the pipeline clock and the base
+/// time. Those inputs change only on segments (seeks, loops), state changes
+/// and clock selection, and are refreshed then. Reading ``position`` loads
+/// them without taking a lock and asks the clock for the current time.
+/// ``duration`` is queried once and cached until the pipeline reports that
+/// it changed or changes state.
+///
+/// Nothing is removed from the pipeline's ``Pipeline/bus``; state changes
+/// are observed as they are posted.
+///
+/// ## Example
+///
+/// ```swift
+/// let pipeline = try Pipeline("filesrc location=movie.mp4 ! decodebin ! autovideosink")
+/// let clock = try PlaybackClock(pipeline: pipeline)
+/// try pipeline.play()
+///
+/// // In a display-link callback, from any thread
+/// if let position = clock.position, let duration = clock.duration {
+///     scrubber.value = Double(position) / Double(duration)
+/// }
+/// ```
+public final class PlaybackClock: @unchecked Sendable {
+    private let pipeline: Pipeline
+    private let sink: UnsafeMutablePointer<GstElement>
+    private let pad: UnsafeMutablePointer<GstPad>
+    private let storage: Storage
+    private let probeID: gulong
+    private let observerID: gulong
+    private let bus: UnsafeMutablePointer<GstBus>?
+
+    /// Track the playback position of a pipeline.
+    ///
+    /// A clock attached to a pipeline that is already playing picks up its
+    /// clock and base time at once, and the sink's current segment as soon
+    /// as the segment observer is installed.
+    ///
+    /// - Parameters:
+    ///   - pipeline: The pipeline to track.
+    ///   - sink: Name of the sink whose segments define the position, or
+    ///     `nil` for the pipeline's first sink.
+    /// - Throws: ``GStreamerError/elementNotFound(_:)`` if there is no such sink.
+    public init(pipeline: Pipeline, sink name: String? = nil) throws {
+        let sink: UnsafeMutablePointer<GstElement>?
+        if let name {
+            sink = gst_bin_get_by_name(
+                UnsafeMutableRawPointer(pipeline._element).assumingMemoryBound(to: GstBin.self), name)
+        } else {
+            sink = swift_gst_bin_find_sink(pipeline._element)
+        }
+        guard let sink else {
+            throw GStreamerError.elementNotFound(name ?? "sink")
+        }
+        guard let pad = swift_gst_element_get_static_pad(sink, "sink") else {
+            swift_gst_object_unref(sink)
+            throw GStreamerError.elementNotFound("\(name ?? "sink").sink")
+        }
+
+        let storage = Storage(pipeline: pipeline._element)
+        if pipeline.currentState() == .playing {
+            storage.pipelineStarted()
+        }
+
+        let segmentObserver: SwiftGstSegmentObserver = { segment, userData in
+            guard let segment, let userData else { return }
+            Unmanaged<Storage>.fromOpaque(userData).takeUnretainedValue().segmentReceived(segment.pointee)
+        }
+        let messageObserver: SwiftGstBusSyncObserver = { message, userData in
+            guard let message, let userData else { return }
+            Unmanaged<Storage>.fromOpaque(userData).takeUnretainedValue().observe(message)
+        }
+        let release: GDestroyNotify = { userData in
+            guard let userData else { return }
+            Unmanaged<Storage>.fromOpaque(userData).release()
+        }
+
+        self.pipeline = pipeline
+        self.sink = sink
+        self.pad = pad
+        self.storage = storage
+        self.probeID = swift_gst_pad_add_segment_observer(
+            pad, segmentObserver, Unmanaged.passRetained(storage).toOpaque(), release)
+        self.bus = swift_gst_element_get_bus(pipeline._element)
+        if let bus {
+            self.observerID = swift_gst_bus_add_sync_observer(
+                bus, messageObserver, Unmanaged.passRetained(storage).toOpaque(), release)
+        } else {
+            self.observerID = 0
+        }
+    }
+
+    deinit {
+        gst_pad_remove_probe(pad, probeID)
+        if let bus {
+            swift_gst_bus_remove_sync_observer(bus, observerID)
+            swift_gst_object_unref(bus)
+        }
+        swift_gst_pad_unref(pad)
+        swift_gst_object_unref(sink)
+    }
+
+    /// The current stream position in nanoseconds.
+    ///
+    /// Returns `nil` until the sink has received a segment, and after the
+    /// pipeline is stopped. Safe to read from any thread; no lock is taken.
+    public var position: UInt64? {
+        storage.position()
+    }
+
+    /// The stream duration in nanoseconds, or `nil` if it isn't known.
+    ///
+    /// Queried from the pipeline on the first read after the duration or the
+    /// pipeline's state changed, and cached until then.
+    public var duration: UInt64? {
+        storage.duration()
+    }
+
+    /// The playback rate of the current segment.
+    public var rate: Double {
+        storage.load().rate
+    }
+
+    /// Whether the position is advancing (the pipeline is PLAYING).
+    public var isRunning: Bool {
+        storage.load().playing
+    }
+}
+
+extension PlaybackClock {
+    /// The inputs to the position calculation.
+    struct Snapshot {
+        var playing = false
+        var hasSegment = false
+        /// Base time plus pipeline latency.
+        var baseTime: UInt64 = 0
+        /// Running time to report while not playing.
+        var pausedRunningTime: UInt64 = 0
+        var clock: UInt = 0
+        var rate: Double = 1
+        var appliedRate: Double = 1
+        var segmentBase: UInt64 = 0
+        var segmentOffset: UInt64 = 0
+        var segmentStart: UInt64 = 0
+        var segmentStop: UInt64 = 0
+        var segmentTime: UInt64 = 0
+    }
+
+    /// Snapshot storage behind a sequence lock.
+    ///
+    /// Writers (the streaming thread on segments, the state-change thread on
+    /// transitions) are rare and serialized by a mutex. Readers never block:
+    /// they retry if a write happened while they were loading.
+    final class Storage: @unchecked Sendable {
+        private let pipeline: UnsafeMutablePointer<GstElement>
+        private let pipelineAddress: UInt
+
+        private let sequence = Atomic<UInt64>(0)
+        private let flags = Atomic<UInt64>(0)
+        private let baseTime = Atomic<UInt64>(0)
+        private let pausedRunningTime = Atomic<UInt64>(0)
+        private let clock = Atomic<UInt>(0)
+        private let rate = Atomic<UInt64>(0)
+        private let appliedRate = Atomic<UInt64>(0)
+        private let segmentBase = Atomic<UInt64>(0)
+        private let segmentOffset = Atomic<UInt64>(0)
+        private let segmentStart = Atomic<UInt64>(0)
+        private let segmentStop = Atomic<UInt64>(0)
+        private let segmentTime = Atomic<UInt64>(0)
+
+        /// Cached duration, and whether it must be queried again.
+        private let cachedDuration = Atomic<UInt64>(0)
+        private let durationIsStale = Atomic<Bool>(true)
+
+        /// Serializes writers and keeps every clock that was ever published
+        /// alive, so a reader holding an old address never sees a freed clock.
+        private let writer = Mutex<[UnsafeMutablePointer<GstClock>]>([])
+
+        /// - Parameter pipeline: The pipeline element; not retained.
+        init(pipeline: UnsafeMutablePointer<GstElement>) {
+            self.pipeline = pipeline
+            self.pipelineAddress = UInt(bitPattern: pipeline)
+            store(Snapshot())
+        }
+
+        deinit {
+            for clock in writer.withLock({ $0 }) {
+                swift_gst_object_unref(clock)
+            }
+        }
+
+        // MARK: Reading
+
+        func load() -> Snapshot {
+            while true {
+                let before = sequence.load(ordering: .acquiring)
+                if before & 1 == 0 {
+                    let bits = flags.load(ordering: .relaxed)
+                    let snapshot = Snapshot(
+                        playing: bits & 1 != 0,
+                        hasSegment: bits & 2 != 0,
+                        baseTime: baseTime.load(ordering: .relaxed),
+                        pausedRunningTime: pausedRunningTime.load(ordering: .relaxed),
+                        clock: clock.load(ordering: .relaxed),
+                        rate: Double(bitPattern: rate.load(ordering: .relaxed)),
+                        appliedRate: Double(bitPattern: appliedRate.load(ordering: .relaxed)),
+                        segmentBase: segmentBase.load(ordering: .relaxed),
+                        segmentOffset: segmentOffset.load(ordering: .relaxed),
+                        segmentStart: segmentStart.load(ordering: .relaxed),
+                        segmentStop: segmentStop.load(ordering: .relaxed),
+                        segmentTime: segmentTime.load(ordering: .relaxed)
+                    )
+                    atomicMemoryFence(ordering: .acquiring)
+                    if sequence.load(ordering: .relaxed) == before {
+                        return snapshot
+                    }
+                }
+            }
+        }
+
+        func position() -> UInt64? {
+            let snapshot = load()
+            guard snapshot.hasSegment else { return nil }
+
+            var runningTime = snapshot.pausedRunningTime
+            if snapshot.playing, let clock = UnsafeMutablePointer<GstClock>(bitPattern: snapshot.clock) {
+                let now = gst_clock_get_time(clock)
+                runningTime = now > snapshot.baseTime ? now - snapshot.baseTime : 0
+            }
+
+            var segment = GstSegment()
+            gst_segment_init(&segment, GST_FORMAT_TIME)
+            segment.rate = snapshot.rate
+            segment.applied_rate = snapshot.appliedRate
+            segment.base = snapshot.segmentBase
+            segment.offset = snapshot.segmentOffset
+            segment.start = snapshot.segmentStart
+            segment.stop = snapshot.segmentStop
+            segment.time = snapshot.segmentTime
+
+            // Before the segment starts (e.g. just after a seek) the sink is
+            // showing the segment's first position.
+            var position = gst_segment_position_from_running_time(&segment, GST_FORMAT_TIME, runningTime)
+            if position == swift_gst_clock_time_none() {
+                position = snapshot.rate >= 0 ? segment.start : segment.stop
+            }
+            let streamTime = gst_segment_to_stream_time(&segment, GST_FORMAT_TIME, position)
+            return streamTime == swift_gst_clock_time_none() ? nil : streamTime
+        }
+
+        func duration() -> UInt64? {
+            // A change reported while querying marks the cache stale again.
+            if durationIsStale.exchange(false, ordering: .acquiringAndReleasing) {
+                var value: gint64 = -1
+                let known = swift_gst_element_query_duration(pipeline, &value) != 0 && value >= 0
+                cachedDuration.store(known ? UInt64(value) : swift_gst_clock_time_none(), ordering: .releasing)
+            }
+            let value = cachedDuration.load(ordering: .acquiring)
+            return value == swift_gst_clock_time_none() ? nil : value
+        }
+
+        // MARK: Writing
+
+        private func update(_ body: (inout Snapshot) -> Void) {
+            writer.withLock { _ in
+                var snapshot = load()
+                body(&snapshot)
+                store(snapshot)
+            }
+        }
+
+        /// Publish a snapshot. Callers hold `writer`, except during init.
+        private func store(_ snapshot: Snapshot) {
+            let current = sequence.load(ordering: .relaxed)
+            sequence.store(current &+ 1, ordering: .relaxed)
+            atomicMemoryFence(ordering: .releasing)
+
+            flags.store((snapshot.playing ? 1 : 0) | (snapshot.hasSegment ? 2 : 0), ordering: .relaxed)
+            baseTime.store(snapshot.baseTime, ordering: .relaxed)
+            pausedRunningTime.store(snapshot.pausedRunningTime, ordering: .relaxed)
+            clock.store(snapshot.clock, ordering: .relaxed)
+            rate.store(snapshot.rate.bitPattern, ordering: .relaxed)
+            appliedRate.store(snapshot.appliedRate.bitPattern, ordering: .relaxed)
+            segmentBase.store(snapshot.segmentBase, ordering: .relaxed)
+            segmentOffset.store(snapshot.segmentOffset, ordering: .relaxed)
+            segmentStart.store(snapshot.segmentStart, ordering: .relaxed)
+            segmentStop.store(snapshot.segmentStop, ordering: .relaxed)
+            segmentTime.store(snapshot.segmentTime, ordering: .relaxed)
+
+            sequence.store(current &+ 2, ordering: .releasing)
+        }
+
+        func segmentReceived(_ segment: GstSegment) {
+            guard segment.format == GST_FORMAT_TIME else { return }
+            update { snapshot in
+                snapshot.hasSegment = true
+                snapshot.rate = segment.rate
+                snapshot.appliedRate = segment.applied_rate
+                snapshot.segmentBase = segment.base
+                snapshot.segmentOffset = segment.offset
+                snapshot.segmentStart = segment.start
+                snapshot.segmentStop = segment.stop
+                snapshot.segmentTime = segment.time
+                if !snapshot.playing {
+                    // A flushing seek while paused restarts running time at
+                    // the new segment.
+                    snapshot.pausedRunningTime = segment.base
+                }
+            }
+        }
+
+        func observe(_ message: UnsafeMutablePointer<GstMessage>) {
+            let type = swift_gst_message_type(message)
+            if type == GST_MESSAGE_DURATION_CHANGED {
+                // Any element may post it; the pipeline answers the query.
+                durationIsStale.store(true, ordering: .releasing)
+                return
+            }
+            guard type == GST_MESSAGE_STATE_CHANGED,
+                UInt(bitPattern: swift_gst_message_src(message)) == pipelineAddress
+            else { return }
+            durationIsStale.store(true, ordering: .releasing)
+
+            var old: GstState = GST_STATE_NULL
+            var new: GstState = GST_STATE_NULL
+            var pending: GstState = GST_STATE_NULL
+            swift_gst_message_parse_state_changed(message, &old, &new, &pending)
+
+            switch new {
+            case GST_STATE_PLAYING:
+                pipelineStarted()
+            case GST_STATE_PAUSED where old == GST_STATE_PLAYING:
+                // The pipeline records the running time it paused at.
+                let startTime = gst_element_get_start_time(pipeline)
+                let latency = pipelineLatency()
+                update { snapshot in
+                    snapshot.playing = false
+                    snapshot.pausedRunningTime = startTime > latency ? startTime - latency : 0
+                }
+            case GST_STATE_READY, GST_STATE_NULL:
+                update { snapshot in
+                    snapshot.playing = false
+                    snapshot.hasSegment = false
+                    snapshot.pausedRunningTime = 0
+                }
+            default:
+                break
+            }
+        }
+
+        /// Pick up the clock and base time chosen for PLAYING.
+        func pipelineStarted() {
+            guard let clock = gst_element_get_clock(pipeline) else { return }
+            let baseTime = gst_element_get_base_time(pipeline)
+            let latency = pipelineLatency()
+
+            writer.withLock { clocks in
+                if clocks.contains(clock) {
+                    swift_gst_object_unref(clock)
+                } else {
+                    clocks.append(clock)
+                }
+
+                var snapshot = load()
+                snapshot.playing = true
+                snapshot.baseTime = baseTime &+ latency
+                snapshot.clock = UInt(bitPattern: clock)
+                store(snapshot)
+            }
+        }
+
+        private func pipelineLatency() -> UInt64 {
+            let latency = gst_pipeline_get_latency(
+                UnsafeMutableRawPointer(pipeline).assumingMemoryBound(to: GstPipeline.self))
+            return latency == swift_gst_clock_time_none() ? 0 : latency
+        }
+    }
+}
@@ -0,0 +1,288 @@
+import CGStreamer
+import CGStreamerShim
+import Synchronization
+
+/// Gapless looping and playlist playback.
+///
+/// Restarting a file with a seek at end-of-stream, or building a new
+/// pipeline for the next file, leaves a visible gap and a burst of CPU while
+/// the demuxer and decoder start over. `PlaylistPlayer` avoids both:
+///
+/// - A single looping item uses segment seeks. The pipeline posts
+///   `SEGMENT_DONE` instead of EOS at the end of the file, and the next loop
+///   is queued with a non-flushing seek while the sinks still have data, so
+///   playback never drains.
+/// - For several items, the next item is built and prerolled in a parked
+///   pipeline while the current one plays. At the current item's EOS the
+///   parked pipeline, whose first frame is already decoded, is set to
+///   PLAYING from the thread that posted the EOS, and the finished pipeline
+///   is torn down in the background.
+///
+/// ## Example
+///
+/// ```swift
+/// let player = PlaylistPlayer(
+///     [
+///         "filesrc location=/media/intro.mp4 ! decodebin ! videoconvert ! kmssink",
+///         "filesrc location=/media/promo.mp4 ! decodebin ! videoconvert ! kmssink",
+///     ],
+///     loop: true
+/// )
+/// try await player.play()
+///
+/// for await index in player.transitions {
+///     print("Now playing item \(index)")
+/// }
+/// ```
+///
+/// Each item is a complete pipeline description. Items are prerolled to
+/// PAUSED before they play, so sinks that open a window or device on preroll
+/// do so while the previous item is still showing.
+public final class PlaylistPlayer: Sendable {
+    private struct Slot {
+        let index: Int
+        let pipeline: Pipeline
+    }
+
+    private struct Status {
+        var current: Slot?
+        var currentObserver: BusObserver?
+        var parked: Slot?
+        var isPreparing = false
+        var advanceWhenReady = false
+        var isStopped = true
+    }
+
+    /// Pipeline descriptions, in playback order.
+    public let items: [String]
+
+    /// Whether playback restarts from the first item after the last.
+    public let loop: Bool
+
+    /// Maximum time to wait for an item to preroll.
+    public let timeout: Duration
+
+    /// The index of each item as it starts playing.
+    ///
+    /// Only the newest index is buffered. The stream finishes when playback
+    /// ends or ``stop()`` is called. Intended for a single consumer.
+    public let transitions: AsyncStream<Int>
+
+    private let continuation: AsyncStream<Int>.Continuation
+    private let status = Mutex(Status())
+
+    /// Create a player.
+    ///
+    /// - Parameters:
+    ///   - items: Pipeline descriptions to play in order.
+    ///   - loop: Restart from the first item after the last. A single
+    ///     looping item loops seamlessly with segment seeks.
+    ///   - timeout: Maximum time to wait for each item to preroll.
+    public init(_ items: [String], loop: Bool = false, timeout: Duration = .seconds(5)) {
+        self.items = items
+        self.loop = loop
+        self.timeout = timeout
+        (transitions, continuation) = AsyncStream.makeStream(bufferingPolicy: .bufferingNewest(1))
+    }
+
+    deinit {
+        continuation.finish()
+    }
+
+    /// The index of the item playing now, or `nil` when stopped.
+    public var currentIndex: Int? {
+        status.withLock { $0.current?.index }
+    }
+
+    /// The pipeline playing now, or `nil` when stopped.
+    public var currentPipeline: Pipeline? {
+        status.withLock { $0.current?.pipeline }
+    }
+
+    /// Whether a single item loops with segment seeks.
+    private var usesSegmentLoop: Bool {
+        loop && items.count == 1
+    }
+
+    /// Start playback from the first item.
+    ///
+    /// Returns once the first item is playing. The following item is
+    /// prerolled in the background from the moment the first has prerolled.
+    ///
+    /// - Throws: ``GStreamerError`` if the first item can't be built or started.
+    public func play() async throws {
+        guard !items.isEmpty else { return }
+        await stop(finishing: false)
+
+        let pipeline = try Pipeline(items[0])
+        let slot = Slot(index: 0, pipeline: pipeline)
+
+        // Watch for the item's end before it can reach it: a short item may
+        // post EOS or SEGMENT_DONE before it is reported as playing.
+        status.withLock { status in
+            status.isStopped = false
+            status.current = slot
+            status.currentObserver = observe(slot)
+        }
+
+        do {
+            try await pipeline.pause(timeout: timeout)
+            if usesSegmentLoop {
+                try pipeline.seek(from: 0, to: nil, flags: [.flush, .segment])
+            }
+            continuation.yield(0)
+            if !usesSegmentLoop {
+                prepareNext(after: 0)
+            }
+            try await pipeline.play(timeout: timeout)
+        } catch {
+            await stop(finishing: false)
+            throw error
+        }
+    }
+
+    /// Stop playback and release every pipeline.
+    public func stop() async {
+        await stop(finishing: true)
+    }
+
+    private func stop(finishing: Bool) async {
+        let (current, parked) = status.withLock { status in
+            status.isStopped = true
+            status.advanceWhenReady = false
+            status.currentObserver = nil
+            defer {
+                status.current = nil
+                status.parked = nil
+            }
+            return (status.current, status.parked)
+        }
+        await current?.pipeline.stop(timeout: timeout)
+        await parked?.pipeline.stop(timeout: timeout)
+        if finishing {
+            continuation.finish()
+        }
+    }
+
+    // MARK: - Transitions
+
+    private func observe(_ slot: Slot) -> BusObserver? {
+        let pipelineAddress = UInt(bitPattern: slot.pipeline._element)
+        return BusObserver(pipeline: slot.pipeline) { [weak self] message in
+            guard let self,
+                UInt(bitPattern: swift_gst_message_src(message)) == pipelineAddress
+            else { return }
+
+            switch swift_gst_message_type(message) {
+            case GST_MESSAGE_SEGMENT_DONE:
+                // Queue the next loop from a task: seeking from the thread
+                // that posted the message can deadlock some demuxers.
+                Task { try? slot.pipeline.seek(from: 0, to: nil, flags: [.segment]) }
+            case GST_MESSAGE_EOS:
+                self.advance(from: slot.index)
+            default:
+                break
+            }
+        }
+    }
+
+    /// Switch to the parked item. Called on the thread that posted EOS.
+    private func advance(from index: Int) {
+        let switched: (old: Slot, new: Slot)? = status.withLock { status in
+            guard !status.isStopped, let current = status.current, current.index == index else { return nil }
+            guard let parked = status.parked else {
+                if status.isPreparing {
+                    status.advanceWhenReady = true
+                } else {
+                    // Nothing follows: playback is over.
+                    status.isStopped = true
+                }
+                return nil
+            }
+
+            // Watch for the new item's end before it can possibly reach it.
+            status.currentObserver = observe(parked)
+            status.parked = nil
+            status.current = parked
+            return (current, parked)
+        }
+
+        guard let switched else {
+            if status.withLock({ $0.isStopped }) {
+                finishIfDone(after: index)
+            }
+            return
+        }
+
+        // The parked pipeline has prerolled, so this only starts the clock.
+        // It runs outside the lock: the state change can post messages that
+        // are handled synchronously on this thread.
+        try? switched.new.pipeline.play()
+        continuation.yield(switched.new.index)
+        Task {
+            await switched.old.pipeline.stop(timeout: timeout)
+            prepareNext(after: switched.new.index)
+        }
+    }
+
+    /// Stop the pipeline that ended the playlist and finish the stream.
+    private func finishIfDone(after index: Int) {
+        let finished = status.withLock { status -> Slot? in
+            guard status.current?.index == index, status.parked == nil, !status.isPreparing else { return nil }
+            status.currentObserver = nil
+            defer { status.current = nil }
+            return status.current
+        }
+        guard let finished else { return }
+        continuation.finish()
+        Task { await finished.pipeline.stop(timeout: timeout) }
+    }
+
+    /// Build and preroll the item after `index` in a parked pipeline.
+    private func prepareNext(after index: Int) {
+        let start = status.withLock { status in
+            guard !status.isStopped, !status.isPreparing, status.parked == nil else { return false }
+            status.isPreparing = true
+            return true
+        }
+        guard start else { return }
+
+        Task {
+            var parked: Slot?
+            // Skip items that fail to build or preroll, trying each at most once.
+            var candidate = index
+            for _ in 0..<items.count {
+                candidate += 1
+                if candidate == items.count {
+                    guard loop else { break }
+                    candidate = 0
+                }
+                guard let pipeline = try? Pipeline(items[candidate]) else { continue }
+                do {
+                    try await pipeline.pause(timeout: timeout)
+                    parked = Slot(index: candidate, pipeline: pipeline)
+                    break
+                } catch {
+                    await pipeline.stop(timeout: timeout)
+                }
+            }
+
+            let (advanceNow, discard) = status.withLock { status -> (Int?, Slot?) in
+                status.isPreparing = false
+                guard !status.isStopped else { return (nil, parked) }
+                status.parked = parked
+                guard status.advanceWhenReady else { return (nil, nil) }
+                status.advanceWhenReady = false
+                if parked == nil {
+                    status.isStopped = true
+                }
+                return (status.current?.index, nil)
+            }
+
+            await discard?.pipeline.stop(timeout: timeout)
+            if let advanceNow {
+                advance(from: advanceNow)
+            }
+        }
+    }
+}
@@ -0,0 +1,178 @@
+import Synchronization
+
+/// Interactive seeking for timeline sliders.
+///
+/// A slider being dragged produces dozens of positions per second. Issuing a
+/// flushing seek for each one queues them up behind each other, and the
+/// picture falls further and further behind the cursor.
+///
+/// `Scrubber` keeps at most one seek in flight. Positions that arrive while a
+/// seek is running replace each other, so when the pipeline has prerolled
+/// the next seek goes straight to wherever the cursor is now. While
+/// dragging, seeks snap to the nearest keyframe, which only needs a single
+/// frame decoded; on release one accurate seek lands on the exact position.
+///
+/// ## Example
+///
+/// ```swift
+/// let scrubber = Scrubber(pipeline: pipeline)
+///
+/// // Slider callbacks, from any thread
+/// func sliderMoved(to seconds: Double) {
+///     scrubber.scrub(to: UInt64(seconds * 1_000_000_000))
+/// }
+///
+/// func sliderReleased() {
+///     scrubber.release()
+/// }
+///
+/// // Keep the time label in sync with what is on screen
+/// Task {
+///     for await position in scrubber.displayedPositions {
+///         label.text = Timestamp(nanoseconds: position).formatted
+///     }
+/// }
+/// ```
+public final class Scrubber: Sendable {
+    private struct Target {
+        let position: UInt64
+        let accurate: Bool
+    }
+
+    private struct Status {
+        var pending: Target?
+        var lastPosition: UInt64?
+        var isSeeking = false
+        var displayed: UInt64?
+        var idleWaiters: [CheckedContinuation<Void, Never>] = []
+    }
+
+    /// The pipeline being scrubbed.
+    public let pipeline: Pipeline
+
+    /// Maximum time to wait for the pipeline to preroll after each seek.
+    public let timeout: Duration
+
+    /// Positions of the frames shown after each completed seek.
+    ///
+    /// Only the newest position is buffered, so a slow consumer skips
+    /// straight to the current one. Intended for a single consumer.
+    public let displayedPositions: AsyncStream<UInt64>
+
+    private let continuation: AsyncStream<UInt64>.Continuation
+    private let status = Mutex(Status())
+
+    /// Create a scrubber for a pipeline.
+    ///
+    /// The pipeline should be PAUSED (or PLAYING) with a seekable source.
+    ///
+    /// - Parameters:
+    ///   - pipeline: The pipeline to seek.
+    ///   - timeout: Maximum time to wait for each seek to preroll.
+    public init(pipeline: Pipeline, timeout: Duration = .seconds(2)) {
+        self.pipeline = pipeline
+        self.timeout = timeout
+        (displayedPositions, continuation) = AsyncStream.makeStream(bufferingPolicy: .bufferingNewest(1))
+    }
+
+    deinit {
+        continuation.finish()
+    }
+
+    /// The position of the frame shown after the last completed seek.
+    public var displayedPosition: UInt64? {
+        status.withLock { $0.displayed }
+    }
+
+    /// Whether a seek is running or waiting to run.
+    public var isSeeking: Bool {
+        status.withLock { $0.isSeeking }
+    }
+
+    /// Move towards a position while the user is dragging.
+    ///
+    /// Returns immediately. If a seek is already running, this replaces any
+    /// position still waiting behind it.
+    ///
+    /// - Parameter position: The cursor position in nanoseconds.
+    public func scrub(to position: UInt64) {
+        submit(Target(position: position, accurate: false))
+    }
+
+    /// Finish scrubbing with one frame-accurate seek.
+    ///
+    /// - Parameter position: The final position in nanoseconds, or `nil` for
+    ///   the last position passed to ``scrub(to:)``.
+    public func release(at position: UInt64? = nil) {
+        guard let position = position ?? status.withLock({ $0.lastPosition }) else { return }
+        submit(Target(position: position, accurate: true))
+    }
+
+    /// Wait until every submitted position has been handled.
+    public func idle() async {
+        await withCheckedContinuation { continuation in
+            let isIdle = status.withLock { status in
+                if status.isSeeking {
+                    status.idleWaiters.append(continuation)
+                    return false
+                }
+                return true
+            }
+            if isIdle {
+                continuation.resume()
+            }
+        }
+    }
+
+    // MARK: - Seeking
+
+    private func submit(_ target: Target) {
+        let start = status.withLock { status in
+            status.pending = target
+            status.lastPosition = target.position
+            guard !status.isSeeking else { return false }
+            status.isSeeking = true
+            return true
+        }
+        if start {
+            Task { await self.drain() }
+        }
+    }
+
+    /// Run seeks until no target is pending.
+    private func drain() async {
+        while true {
+            let next: Target? = status.withLock { status in
+                guard let target = status.pending else {
+                    status.isSeeking = false
+                    for waiter in status.idleWaiters {
+                        waiter.resume()
+                    }
+                    status.idleWaiters.removeAll()
+                    return nil
+                }
+                status.pending = nil
+                return target
+            }
+            guard let target = next else { return }
+            await seek(to: target)
+        }
+    }
+
+    private func seek(to target: Target) async {
+        let flags: Pipeline.SeekFlags = target.accurate ? [.flush, .accurate] : [.flush, .keyUnit, .snapNearest]
+        do {
+            try pipeline.seek(to: target.position, flags: flags)
+            // A flushing seek makes the pipeline preroll again; the frame is
+            // on screen once that completes.
+            _ = try await pipeline.settle(timeout: timeout)
+        } catch {
+            return
+        }
+
+        // Key-unit seeks land on a keyframe, not the requested position.
+        let displayed = pipeline.position ?? target.position
+        status.withLock { $0.displayed = displayed }
+        continuation.yield(displayed)
+    }
+}
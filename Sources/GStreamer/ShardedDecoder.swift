@@ -0,0 +1,327 @@
+/// Decodes a single seekable file with several pipelines running in parallel.
+///
+/// One demux → decode chain is often the bottleneck for offline work on long
+/// recordings. `ShardedDecoder` splits the file's timeline into contiguous,
+/// keyframe-aligned shards and gives each shard its own pipeline, so every
+/// core decodes a different part of the file at the same time.
+///
+/// Shard boundaries are found by seeking a probe pipeline to each nominal
+/// split point with ``Pipeline/SeekFlags/keyUnit`` and
+/// ``Pipeline/SeekFlags/snapBefore``, which lands on the preceding keyframe.
+/// Each shard then starts decoding exactly at its keyframe, so no GOP is
+/// decoded just to be thrown away. Frames are filtered by presentation
+/// timestamp into half-open ranges `[start, stop)`, which guarantees that no
+/// frame is dropped or delivered twice at a boundary. A frame without a
+/// timestamp is delivered only by the shard that owns the timestamped frame
+/// before it, or by the first shard if none came before.
+///
+/// ## Example
+///
+/// ```swift
+/// let decoder = ShardedDecoder(
+///     uri: "file:///recordings/match.mp4",
+///     shardCount: 8
+/// )
+///
+/// // Fastest: frames arrive from all shards concurrently.
+/// try await decoder.run { shard, frame in
+///     try await detector.process(frame)
+/// }
+///
+/// // Presentation order, with each shard decoding up to 16 frames ahead.
+/// let ordered = ShardedDecoder(
+///     uri: "file:///recordings/match.mp4",
+///     shardCount: 8,
+///     ordering: .presentation(prefetch: 16)
+/// )
+/// try await ordered.run { _, frame in
+///     try await writer.append(frame)
+/// }
+/// ```
+///
+/// - Note: The source must be seekable and report a duration. Live sources
+///   and streams without an index throw ``ShardingError/durationUnavailable``.
+public struct ShardedDecoder: Sendable {
+    /// How decoded frames from different shards are delivered.
+    public enum Ordering: Sendable, Hashable {
+        /// Deliver frames as soon as any shard produces them.
+        ///
+        /// Frames within a shard are in presentation order, but frames from
+        /// different shards interleave. This gives the highest throughput.
+        case unordered
+
+        /// Deliver every frame in global presentation order.
+        ///
+        /// All shards decode concurrently, but each shard's appsink holds at
+        /// most `prefetch` frames until its turn comes. The next shard's
+        /// frames are therefore ready as soon as the previous shard finishes.
+        case presentation(prefetch: Int)
+    }
+
+    /// A contiguous slice of the file's timeline.
+    public struct Shard: Sendable, Hashable {
+        /// Position of this shard in presentation order, starting at zero.
+        public let index: Int
+
+        /// Presentation timestamp of the shard's first keyframe in nanoseconds.
+        public let start: UInt64
+
+        /// Exclusive end of the shard in nanoseconds, or `nil` for the last shard.
+        public let stop: UInt64?
+
+        /// Whether a frame with the given presentation timestamp belongs to this shard.
+        public func contains(_ pts: UInt64) -> Bool {
+            guard pts >= start else { return false }
+            guard let stop else { return true }
+            return pts < stop
+        }
+    }
+
+    /// Errors specific to sharded decoding.
+    public enum ShardingError: Error, Sendable, CustomStringConvertible {
+        /// The source did not report a duration after preroll.
+        case durationUnavailable
+
+        /// The decoder was configured with invalid options.
+        case invalidConfiguration(String)
+
+        public var description: String {
+            switch self {
+            case .durationUnavailable:
+                return "Source did not report a duration; sharded decoding requires a seekable file"
+            case .invalidConfiguration(let reason):
+                return "Invalid sharded decoder configuration: \(reason)"
+            }
+        }
+    }
+
+    /// URI of the file to decode.
+    public let uri: String
+
+    /// Number of pipelines to run concurrently.
+    ///
+    /// Short files may produce fewer shards when several split points snap
+    /// to the same keyframe.
+    public let shardCount: Int
+
+    /// Caps applied before each shard's appsink.
+    public let outputCaps: String
+
+    /// How frames from different shards are delivered.
+    public let ordering: Ordering
+
+    /// Extra time decoded past each shard's end.
+    ///
+    /// Open-GOP streams contain frames that precede a keyframe in presentation
+    /// order but follow it in decode order. Decoding slightly past the boundary
+    /// lets the previous shard complete those frames; anything past `stop` is
+    /// discarded by the timestamp filter.
+    public let overlap: Duration
+
+    /// Maximum time to wait for each pipeline to preroll.
+    public let prerollTimeout: Duration
+
+    /// Create a sharded decoder.
+    ///
+    /// - Parameters:
+    ///   - uri: URI of the file to decode (e.g. `file:///path/to/video.mp4`).
+    ///   - shardCount: Number of pipelines to run concurrently.
+    ///   - outputCaps: Caps for decoded frames. Defaults to BGRA.
+    ///   - ordering: How frames from different shards are delivered.
+    ///   - overlap: Extra time decoded past each shard's end.
+    ///   - prerollTimeout: Maximum time to wait for each pipeline to preroll.
+    public init(
+        uri: String,
+        shardCount: Int,
+        outputCaps: String = "video/x-raw,format=BGRA",
+        ordering: Ordering = .unordered,
+        overlap: Duration = .seconds(1),
+        prerollTimeout: Duration = .seconds(10)
+    ) {
+        self.uri = uri
+        self.shardCount = shardCount
+        self.outputCaps = outputCaps
+        self.ordering = ordering
+        self.overlap = overlap
+        self.prerollTimeout = prerollTimeout
+    }
+
+    /// Decode the whole file, calling `body` once for every frame.
+    ///
+    /// The handler runs concurrently for frames from different shards when
+    /// ``ordering`` is ``Ordering/unordered``. An error from the handler or
+    /// from any pipeline cancels the remaining shards and is rethrown.
+    ///
+    /// - Parameter body: Handler called with each frame and the shard it belongs to.
+    public func run(
+        _ body: @escaping @Sendable (Shard, VideoFrame) async throws -> Void
+    ) async throws {
+        guard shardCount > 0 else {
+            throw ShardingError.invalidConfiguration("shardCount must be positive")
+        }
+        if case .presentation(let prefetch) = ordering, prefetch <= 0 {
+            throw ShardingError.invalidConfiguration("prefetch must be positive")
+        }
+
+        // The first pipeline doubles as the probe used to find keyframes.
+        let probe = try makePipeline()
+        try await probe.pause(timeout: prerollTimeout)
+
+        guard let duration = probe.duration, duration > 0 else {
+            probe.stop()
+            throw ShardingError.durationUnavailable
+        }
+
+        var boundaries: [UInt64] = [0]
+        for nominal in Self.nominalBoundaries(duration: duration, count: shardCount) {
+            try probe.seek(to: nominal, flags: [.flush, .keyUnit, .snapBefore])
+            _ = try await probe.settle(timeout: prerollTimeout)
+            boundaries.append(probe.position ?? nominal)
+        }
+
+        let shards = Self.makeShards(boundaries: boundaries)
+        var pipelines = [probe]
+        for _ in shards.dropFirst() {
+            pipelines.append(try makePipeline())
+        }
+
+        defer {
+            for pipeline in pipelines {
+                pipeline.stop()
+            }
+        }
+
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            for (shard, pipeline) in zip(shards, pipelines) {
+                group.addTask {
+                    try await start(shard, on: pipeline)
+                }
+            }
+            try await group.waitForAll()
+        }
+
+        switch ordering {
+        case .unordered:
+            try await withThrowingTaskGroup(of: Void.self) { group in
+                for (shard, pipeline) in zip(shards, pipelines) {
+                    group.addTask {
+                        try await Self.consume(shard, from: pipeline, body)
+                    }
+                }
+                try await group.waitForAll()
+            }
+        case .presentation:
+            for (shard, pipeline) in zip(shards, pipelines) {
+                try await Self.consume(shard, from: pipeline, body)
+                pipeline.stop()
+            }
+        }
+    }
+
+    // MARK: - Planning
+
+    /// Evenly spaced split points strictly inside `(0, duration)`.
+    internal static func nominalBoundaries(duration: UInt64, count: Int) -> [UInt64] {
+        guard count > 1 else { return [] }
+        let step = duration / UInt64(count)
+        guard step > 0 else { return [] }
+        return (1..<count).map { step * UInt64($0) }
+    }
+
+    /// Turn keyframe start positions into contiguous half-open shards.
+    ///
+    /// Split points that snapped to the same (or an earlier) keyframe are
+    /// merged so that every shard covers a non-empty range.
+    internal static func makeShards(boundaries: [UInt64]) -> [Shard] {
+        var starts: [UInt64] = []
+        for boundary in boundaries where starts.last.map({ boundary > $0 }) ?? true {
+            starts.append(boundary)
+        }
+
+        return starts.indices.map { index in
+            Shard(
+                index: index,
+                start: starts[index],
+                stop: index + 1 < starts.count ? starts[index + 1] : nil
+            )
+        }
+    }
+
+    // MARK: - Pipelines
+
+    private var maxBuffers: Int {
+        switch ordering {
+        case .unordered:
+            return 2
+        case .presentation(let prefetch):
+            return prefetch
+        }
+    }
+
+    private func makePipeline() throws -> Pipeline {
+        try Pipeline(
+            """
+            uridecodebin uri=\(uri.pipelineQuoted) ! videoconvert ! \(outputCaps) ! \
+            appsink name=shardsink sync=false max-buffers=\(maxBuffers) drop=false
+            """
+        )
+    }
+
+    private func start(_ shard: Shard, on pipeline: Pipeline) async throws {
+        if pipeline.currentState() != .paused {
+            try await pipeline.pause(timeout: prerollTimeout)
+        }
+
+        let overlapNanoseconds = Timestamp(duration: overlap).nanoseconds
+        let stop = shard.stop.map { $0 + overlapNanoseconds }
+        try pipeline.seek(from: shard.start, to: stop, flags: [.flush, .keyUnit])
+        try pipeline.play()
+    }
+
+    private static func consume(
+        _ shard: Shard,
+        from pipeline: Pipeline,
+        _ body: @escaping @Sendable (Shard, VideoFrame) async throws -> Void
+    ) async throws {
+        let sink = try pipeline.appSink(named: "shardsink")
+
+        // appsink never reaches EOS if the pipeline fails, so a bus watcher
+        // turns errors into a thrown error that cancels frame consumption.
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            group.addTask {
+                for await message in pipeline.bus.messages(filter: .error) {
+                    if case .error(let text, let debug) = message {
+                        throw GStreamerError.busError(text, source: nil, debug: debug)
+                    }
+                }
+            }
+
+            group.addTask {
+                // A frame without a timestamp belongs to the shard that owns
+                // the timestamped frame before it. Before any timestamped
+                // frame, only the first shard owns it.
+                var ownsUntimed = shard.index == 0
+                for try await frame in sink.frames() {
+                    guard let pts = frame.pts else {
+                        if ownsUntimed {
+                            try await body(shard, frame)
+                        }
+                        continue
+                    }
+                    // Decoders emit frames in presentation order, so the first
+                    // frame past `stop` ends this shard.
+                    if let stop = shard.stop, pts >= stop {
+                        break
+                    }
+                    ownsUntimed = shard.contains(pts)
+                    if ownsUntimed {
+                        try await body(shard, frame)
+                    }
+                }
+            }
+
+            _ = try await group.next()
+            group.cancelAll()
+        }
+    }
+}
@@ -0,0 +1,732 @@
+import CGStreamer
+import CGStreamerShim
+import Synchronization
+
+/// Errors from the shared-memory frame transport.
+public enum SharedMemoryError: Error, Sendable, CustomStringConvertible {
+    /// The shared segment couldn't be created or mapped.
+    case segmentUnavailable(size: Int)
+    /// The control socket couldn't be opened.
+    case socketUnavailable(path: String)
+    /// The publisher didn't complete the handshake.
+    case handshakeFailed(path: String)
+    /// The frame is larger than a slot.
+    case frameTooLarge(size: Int, slotSize: Int)
+
+    public var description: String {
+        switch self {
+        case .segmentUnavailable(let size):
+            return "Could not create a shared memory segment of \(size) bytes"
+        case .socketUnavailable(let path):
+            return "Could not open control socket at \(path)"
+        case .handshakeFailed(let path):
+            return "No shared memory handshake from publisher at \(path)"
+        case .frameTooLarge(let size, let slotSize):
+            return "Frame of \(size) bytes does not fit a \(slotSize)-byte slot"
+        }
+    }
+}
+
+/// Publishes frames to a process on the same machine through shared memory.
+///
+/// Sending frames to another process over a socket costs a copy out of the
+/// buffer, a copy into the kernel and a copy out again, for every frame.
+/// The publisher instead owns a ring of slots in one shared memory segment
+/// (a `memfd` on Linux). Each frame is written once, into a free slot, and
+/// the subscriber is sent a small descriptor with the slot, size,
+/// timestamps and, when they change, the caps. The subscriber reads the
+/// frame in place and releases the slot when done.
+///
+/// Slots are the backpressure: when the subscriber holds every slot,
+/// ``publish(_:caps:)-(Buffer,_)`` waits for one to be released, or drops
+/// the frame if the publisher was created with `dropWhenFull`. One
+/// subscriber is served at a time; while none is connected frames are
+/// dropped.
+///
+/// Waiting for subscribers and their slot releases happens on threads of
+/// the transport's own, never on Swift's cooperative pool.
+///
+/// ```swift
+/// // Capture process
+/// let publisher = try SharedMemoryPublisher(
+///     socketPath: "/run/camera0.sock",
+///     slotSize: 3840 * 2160 * 4
+/// )
+/// try await publisher.publish(from: sink)
+///
+/// // Inference process
+/// let subscriber = try await SharedMemorySubscriber(socketPath: "/run/camera0.sock")
+/// for await frame in subscriber.frames() {
+///     frame.withBytes { pixels in model.run(pixels, caps: frame.caps) }
+///     frame.release()
+/// }
+/// ```
+public final class SharedMemoryPublisher: Sendable {
+    private struct Status {
+        var connection: Int32 = -1
+        /// Bumped for every subscriber, so slots, sends and release threads
+        /// of an earlier one are told apart even when the descriptor number
+        /// of its socket has been reused.
+        var generation: UInt64 = 0
+        var freeSlots: [Int]
+        /// Slots a publish is still writing into. They aren't handed out,
+        /// not even to a subscriber that connected meanwhile.
+        var writing: Set<Int> = []
+        var waiters: [CheckedContinuation<Lease?, Never>] = []
+        var caps: String?
+        var capsSent = false
+        var sequence: UInt64 = 0
+        var isClosed = false
+        var counters = Statistics()
+
+        func isCurrent(_ generation: UInt64) -> Bool {
+            connection >= 0 && self.generation == generation
+        }
+
+        /// Put a slot back in the ring, or hand it to the longest waiting publish.
+        mutating func free(_ slot: Int) -> (CheckedContinuation<Lease?, Never>, Lease)? {
+            guard !freeSlots.contains(slot), !writing.contains(slot) else { return nil }
+            guard !waiters.isEmpty else {
+                freeSlots.append(slot)
+                return nil
+            }
+            writing.insert(slot)
+            return (waiters.removeFirst(), Lease(slot: slot, generation: generation))
+        }
+    }
+
+    /// A slot acquired for one frame, and the subscriber it was acquired for.
+    private struct Lease: Sendable {
+        let slot: Int
+        let generation: UInt64
+    }
+
+    /// Transport counters.
+    public struct Statistics: Sendable, Hashable {
+        /// Frames written to a slot and announced.
+        public var published = 0
+        /// Frames dropped because no slot was free or nobody was connected.
+        public var dropped = 0
+        /// Bytes written into slots.
+        public var bytes = 0
+    }
+
+    /// Path of the control socket subscribers connect to.
+    public let socketPath: String
+
+    /// Number of slots in the ring.
+    public let slotCount: Int
+
+    /// Largest frame a slot holds.
+    public let slotSize: Int
+
+    /// Whether frames are dropped instead of waiting when every slot is held.
+    public let dropWhenFull: Bool
+
+    private let slotStride: Int
+    private let segment: Int32
+    private let base: UnsafeMutableRawPointer
+    private let listener: Int32
+    private let status: Mutex<Status>
+    /// Serializes writes to the control socket.
+    private let sendLock = Mutex(())
+
+    /// Create the shared segment and listen for a subscriber.
+    ///
+    /// - Parameters:
+    ///   - socketPath: Unix socket path for the control connection. A stale
+    ///     socket file at the path is replaced.
+    ///   - slotCount: Frames that can be in flight at once.
+    ///   - slotSize: Largest frame in bytes.
+    ///   - dropWhenFull: Drop frames instead of waiting when the subscriber
+    ///     holds every slot.
+    /// - Throws: ``SharedMemoryError`` if the segment or socket can't be created.
+    public init(socketPath: String, slotCount: Int = 4, slotSize: Int, dropWhenFull: Bool = false) throws {
+        let pageSize = Int(swift_shm_page_size())
+        let slotStride = (max(slotSize, 1) + pageSize - 1) / pageSize * pageSize
+        let segmentSize = slotStride * max(slotCount, 1)
+
+        let segment = swift_shm_segment_create(gsize(segmentSize))
+        guard segment >= 0 else {
+            throw SharedMemoryError.segmentUnavailable(size: segmentSize)
+        }
+        guard let base = swift_shm_segment_map(segment, gsize(segmentSize), 1) else {
+            swift_shm_close(segment)
+            throw SharedMemoryError.segmentUnavailable(size: segmentSize)
+        }
+        let listener = swift_shm_listen(socketPath)
+        guard listener >= 0 else {
+            swift_shm_segment_unmap(base, gsize(segmentSize))
+            swift_shm_close(segment)
+            throw SharedMemoryError.socketUnavailable(path: socketPath)
+        }
+
+        self.socketPath = socketPath
+        self.slotCount = max(slotCount, 1)
+        self.slotSize = slotSize
+        self.dropWhenFull = dropWhenFull
+        self.slotStride = slotStride
+        self.segment = segment
+        self.base = base
+        self.listener = listener
+        self.status = Mutex(Status(freeSlots: Array(0..<max(slotCount, 1))))
+
+        SocketThread.start(named: "shm-accept") { [weak self] in
+            while let publisher = self, publisher.acceptNext() {}
+        }
+    }
+
+    deinit {
+        close()
+        swift_shm_segment_unmap(base, gsize(slotStride * slotCount))
+        swift_shm_close(segment)
+    }
+
+    /// Whether a subscriber is connected.
+    public var isConnected: Bool {
+        status.withLock { $0.connection >= 0 }
+    }
+
+    /// Current transport counters.
+    public var statistics: Statistics {
+        status.withLock { $0.counters }
+    }
+
+    // MARK: - Publishing
+
+    /// Write a buffer into a free slot and announce it to the subscriber.
+    ///
+    /// - Parameters:
+    ///   - buffer: The frame data.
+    ///   - caps: The stream's caps; sent to the subscriber when they change.
+    /// - Returns: `false` if the frame was dropped.
+    /// - Throws: ``SharedMemoryError/frameTooLarge(size:slotSize:)``.
+    @discardableResult
+    public func publish(_ buffer: Buffer, caps: String? = nil) async throws -> Bool {
+        try await publish(buffer.buffer, caps: caps)
+    }
+
+    /// Write a video frame into a free slot and announce it to the subscriber.
+    ///
+    /// - Parameters:
+    ///   - frame: The frame.
+    ///   - caps: The stream's caps; sent to the subscriber when they change.
+    /// - Returns: `false` if the frame was dropped.
+    /// - Throws: ``SharedMemoryError/frameTooLarge(size:slotSize:)``.
+    @discardableResult
+    public func publish(_ frame: VideoFrame, caps: String? = nil) async throws -> Bool {
+        try await publish(frame.bufferReference(), caps: caps)
+    }
+
+    /// Publish every frame from an appsink until end-of-stream or cancellation.
+    ///
+    /// Caps are read from the sink's pad, so the subscriber always has the
+    /// current format.
+    public func publish(from sink: AppSink) async throws {
+        let pad = sink.element.staticPad("sink")
+        for try await frame in sink.frames() {
+            try await publish(frame.bufferReference(), caps: pad?.currentCaps)
+        }
+    }
+
+    private func publish(_ buffer: UnsafeMutablePointer<GstBuffer>, caps: String?) async throws -> Bool {
+        let size = Int(swift_gst_buffer_get_size(buffer))
+        guard size <= slotSize else {
+            throw SharedMemoryError.frameTooLarge(size: size, slotSize: slotSize)
+        }
+        guard let lease = await acquireSlot() else {
+            status.withLock { $0.counters.dropped += 1 }
+            return false
+        }
+
+        // The one copy: straight from the GstBuffer's memory into the slot.
+        _ = gst_buffer_extract(buffer, 0, base + lease.slot * slotStride, gsize(size))
+
+        var message = SwiftShmMessage()
+        message.kind = guint32(SWIFT_SHM_MESSAGE_FRAME.rawValue)
+        message.slot = guint32(lease.slot)
+        message.size = guint64(size)
+        message.pts = swift_gst_buffer_get_pts(buffer)
+        message.dts = swift_gst_buffer_get_dts(buffer)
+        message.duration = swift_gst_buffer_get_duration(buffer)
+
+        // `nil` if the subscriber the slot was acquired for has gone.
+        let sent = sendLock.withLock { _ -> Bool? in
+            // A subscriber's descriptor is only closed under the send lock,
+            // so it stays open, and its number unused, while this sends.
+            let current = status.withLock { status -> (connection: Int32, caps: String?)? in
+                guard status.isCurrent(lease.generation) else { return nil }
+                // From here the slot is the subscriber's until it releases it.
+                status.writing.remove(lease.slot)
+                status.sequence += 1
+                message.sequence = status.sequence
+                if let caps, caps != status.caps {
+                    status.caps = caps
+                    status.capsSent = false
+                }
+                defer { status.capsSent = true }
+                return (status.connection, status.capsSent ? nil : status.caps)
+            }
+            guard let current else { return nil }
+            if let caps = current.caps {
+                guard Self.sendCaps(caps, on: current.connection) else { return false }
+            }
+            return swift_shm_send(current.connection, &message, -1, nil, 0) != 0
+        }
+        guard sent == true else {
+            if sent == nil {
+                recycle(lease)
+            } else {
+                disconnect(lease.generation)
+            }
+            status.withLock { $0.counters.dropped += 1 }
+            return false
+        }
+
+        status.withLock {
+            $0.counters.published += 1
+            $0.counters.bytes += size
+        }
+        return true
+    }
+
+    /// Stop publishing: tell the subscriber, close the socket and remove its file.
+    ///
+    /// The subscriber's release thread closes its connection once it sees
+    /// the publisher has closed.
+    public func close() {
+        let waiters = sendLock.withLock { _ -> [CheckedContinuation<Lease?, Never>]? in
+            let closing = status.withLock { status -> (Int32, [CheckedContinuation<Lease?, Never>])? in
+                guard !status.isClosed else { return nil }
+                status.isClosed = true
+                defer {
+                    status.connection = -1
+                    status.waiters.removeAll()
+                }
+                return (status.connection, status.waiters)
+            }
+            guard let (connection, waiters) = closing else { return nil }
+            if connection >= 0 {
+                var message = SwiftShmMessage()
+                message.kind = guint32(SWIFT_SHM_MESSAGE_EOS.rawValue)
+                _ = swift_shm_send(connection, &message, -1, nil, 0)
+            }
+            return waiters
+        }
+        guard let waiters else { return }
+        waiters.forEach { $0.resume(returning: nil) }
+        swift_shm_close(listener)
+        swift_shm_unlink(socketPath)
+    }
+
+    // MARK: - Slots
+
+    /// A free slot, waiting for one if allowed; `nil` to drop the frame.
+    private func acquireSlot() async -> Lease? {
+        await withCheckedContinuation { continuation in
+            let lease: Lease?? = status.withLock { status in
+                guard !status.isClosed, status.connection >= 0 else { return .some(nil) }
+                if let slot = status.freeSlots.popLast() {
+                    status.writing.insert(slot)
+                    return .some(Lease(slot: slot, generation: status.generation))
+                }
+                if dropWhenFull {
+                    return .some(nil)
+                }
+                status.waiters.append(continuation)
+                return nil
+            }
+            if let lease {
+                continuation.resume(returning: lease)
+            }
+        }
+    }
+
+    /// A subscriber released a slot.
+    private func releaseSlot(_ slot: Int, generation: UInt64) {
+        guard slot >= 0, slot < slotCount else { return }
+        // Slots of an earlier subscriber were freed when the next connected.
+        let handoff = status.withLock { status -> (CheckedContinuation<Lease?, Never>, Lease)? in
+            status.generation == generation ? status.free(slot) : nil
+        }
+        if let (waiter, lease) = handoff {
+            waiter.resume(returning: lease)
+        }
+    }
+
+    /// Free a slot whose frame was never announced because its subscriber left.
+    private func recycle(_ lease: Lease) {
+        let handoff = status.withLock { status -> (CheckedContinuation<Lease?, Never>, Lease)? in
+            status.writing.remove(lease.slot)
+            return status.free(lease.slot)
+        }
+        if let (waiter, lease) = handoff {
+            waiter.resume(returning: lease)
+        }
+    }
+
+    // MARK: - Connection
+
+    private static func sendCaps(_ caps: String, on connection: Int32) -> Bool {
+        var message = SwiftShmMessage()
+        message.kind = guint32(SWIFT_SHM_MESSAGE_CAPS.rawValue)
+        let bytes = Array(caps.utf8)
+        message.caps_length = guint32(bytes.count)
+        return bytes.withUnsafeBytes {
+            swift_shm_send(connection, &message, -1, $0.baseAddress, gsize($0.count)) != 0
+        }
+    }
+
+    /// Wait briefly for a subscriber; `false` once the listener is gone.
+    private func acceptNext() -> Bool {
+        guard !status.withLock({ $0.isClosed }) else { return false }
+        let connection = swift_shm_accept(listener, 100)
+        guard connection >= 0 else { return connection == -2 }
+
+        let generation = status.withLock { status -> UInt64? in
+            guard status.connection < 0, !status.isClosed else { return nil }
+            status.connection = connection
+            status.generation += 1
+            // Slots the previous subscriber held are free again, but not
+            // those an earlier publish is still writing into.
+            status.freeSlots = (0..<slotCount).filter { !status.writing.contains($0) }
+            // A new subscriber needs the current caps before any frame.
+            status.capsSent = false
+            return status.generation
+        }
+        guard let generation else {
+            swift_shm_close(connection)
+            return true
+        }
+
+        var hello = SwiftShmMessage()
+        hello.kind = guint32(SWIFT_SHM_MESSAGE_HELLO.rawValue)
+        hello.slot = guint32(slotCount)
+        hello.size = guint64(slotStride)
+        let greeted = sendLock.withLock { _ in swift_shm_send(connection, &hello, segment, nil, 0) != 0 }
+        guard greeted else {
+            retire(connection, generation: generation)
+            return true
+        }
+
+        // The release thread owns the descriptor: it is the only one to
+        // close it, so the number can't be reused while the thread polls
+        // it. The publisher is held weakly between reads so it can be
+        // released while a subscriber is connected.
+        SocketThread.start(named: "shm-release") { [weak self] in
+            while let publisher = self, publisher.readRelease(from: connection, generation: generation) {}
+            if let publisher = self {
+                publisher.retire(connection, generation: generation)
+            } else {
+                swift_shm_close(connection)
+            }
+        }
+        return true
+    }
+
+    /// Wait briefly for a released slot; `false` once the subscriber is gone.
+    private func readRelease(from connection: Int32, generation: UInt64) -> Bool {
+        var message = SwiftShmMessage()
+        let result = swift_shm_receive(connection, &message, nil, nil, 0, 100)
+        guard result >= 0, status.withLock({ $0.isCurrent(generation) }) else { return false }
+        if result > 0 && message.kind == SWIFT_SHM_MESSAGE_RELEASE.rawValue {
+            releaseSlot(Int(message.slot), generation: generation)
+        }
+        return true
+    }
+
+    /// Forget a subscriber; waiting publishers drop, and its slots are
+    /// freed when the next subscriber connects.
+    private func disconnect(_ generation: UInt64) {
+        let waiters = status.withLock { status -> [CheckedContinuation<Lease?, Never>]? in
+            guard status.isCurrent(generation) else { return nil }
+            status.connection = -1
+            defer { status.waiters.removeAll() }
+            return status.waiters
+        }
+        waiters?.forEach { $0.resume(returning: nil) }
+    }
+
+    /// Forget a subscriber and close its connection.
+    private func retire(_ connection: Int32, generation: UInt64) {
+        disconnect(generation)
+        // Not while a send is writing to it.
+        sendLock.withLock { _ in swift_shm_close(connection) }
+    }
+}
+
+/// Receives frames published by a ``SharedMemoryPublisher`` in another process.
+///
+/// The subscriber maps the publisher's segment read-only; frames are read
+/// where the publisher wrote them. Each ``SharedFrame`` holds its slot
+/// until ``SharedFrame/release()`` is called or the frame is released by
+/// Swift. Holding frames makes the publisher wait (or drop), so release
+/// them as soon as they have been processed.
+///
+/// The subscriber doesn't need GStreamer to be initialized.
+public final class SharedMemorySubscriber: Sendable {
+    private struct Status {
+        var caps: String?
+        var isClosed = false
+        /// Identifies the ``frames()`` stream being fed; bumped to stop it.
+        var stream = 0
+    }
+
+    /// The publisher's segment and connection, once the handshake is done.
+    private struct Handshake: @unchecked Sendable {
+        let connection: Int32
+        let slotCount: Int
+        let slotStride: Int
+        let base: UnsafeRawPointer
+    }
+
+    /// Path of the publisher's control socket.
+    public let socketPath: String
+
+    /// Number of slots in the publisher's ring.
+    public let slotCount: Int
+
+    private let connection: Int32
+    private let slotStride: Int
+    private let base: UnsafeRawPointer
+    private let status = Mutex(Status())
+    private let sendLock = Mutex(())
+
+    /// Connect to a publisher and map its segment.
+    ///
+    /// The connection and handshake wait on a thread of their own, so the
+    /// caller's task is suspended rather than blocking its thread.
+    ///
+    /// - Parameters:
+    ///   - socketPath: The publisher's control socket.
+    ///   - timeout: Maximum time to wait for the handshake.
+    /// - Throws: ``SharedMemoryError`` if the publisher can't be reached.
+    public init(socketPath: String, timeout: Duration = .seconds(5)) async throws {
+        let handshake = try await SocketThread.run(named: "shm-connect") {
+            SharedMemorySubscriber.handshake(socketPath: socketPath, timeout: timeout)
+        }.get()
+
+        self.socketPath = socketPath
+        self.slotCount = handshake.slotCount
+        self.slotStride = handshake.slotStride
+        self.connection = handshake.connection
+        self.base = handshake.base
+    }
+
+    /// Connect, receive the segment and map it. Blocks for up to `timeout`.
+    private static func handshake(socketPath: String, timeout: Duration) -> Result<Handshake, SharedMemoryError> {
+        let connection = swift_shm_connect(socketPath)
+        guard connection >= 0 else {
+            return .failure(.socketUnavailable(path: socketPath))
+        }
+
+        var hello = SwiftShmMessage()
+        var segment: Int32 = -1
+        let milliseconds = Int32(clamping: max(timeout, .zero).components.seconds * 1000
+            + max(timeout, .zero).components.attoseconds / 1_000_000_000_000_000)
+        guard swift_shm_receive(connection, &hello, &segment, nil, 0, milliseconds) > 0,
+            hello.kind == SWIFT_SHM_MESSAGE_HELLO.rawValue, segment >= 0
+        else {
+            swift_shm_close(segment)
+            swift_shm_close(connection)
+            return .failure(.handshakeFailed(path: socketPath))
+        }
+
+        let slotCount = Int(hello.slot)
+        let slotStride = Int(hello.size)
+        let mapped = swift_shm_segment_map(segment, gsize(slotCount * slotStride), 0)
+        // The mapping keeps the segment alive.
+        swift_shm_close(segment)
+        guard let mapped else {
+            swift_shm_close(connection)
+            return .failure(.segmentUnavailable(size: slotCount * slotStride))
+        }
+
+        return .success(
+            Handshake(connection: connection, slotCount: slotCount, slotStride: slotStride, base: UnsafeRawPointer(mapped))
+        )
+    }
+
+    deinit {
+        swift_shm_close(connection)
+        swift_shm_segment_unmap(UnsafeMutableRawPointer(mutating: base), gsize(slotCount * slotStride))
+    }
+
+    /// Frames as the publisher announces them.
+    ///
+    /// Finishes when the publisher closes or disconnects, or when the
+    /// consumer stops iterating. Intended for a single consumer; a new
+    /// call takes over from the previous stream, which finishes.
+    ///
+    /// Messages are read on a thread of the subscriber's own, so waiting
+    /// for the publisher never holds a thread of Swift's cooperative pool.
+    public func frames() -> AsyncStream<SharedFrame> {
+        let stream = status.withLock { status in
+            status.stream += 1
+            return status.stream
+        }
+        return AsyncStream { continuation in
+            continuation.onTermination = { [weak self] _ in
+                self?.status.withLock { status in
+                    if status.stream == stream {
+                        status.stream += 1
+                    }
+                }
+            }
+            SocketThread.start(named: "shm-receive") { [weak self] in
+                while let subscriber = self, subscriber.status.withLock({ $0.stream == stream }) {
+                    switch subscriber.receive() {
+                    case .frame(let frame):
+                        continuation.yield(frame)
+                    case .idle:
+                        continue
+                    case .finished:
+                        continuation.finish()
+                        return
+                    }
+                }
+                continuation.finish()
+            }
+        }
+    }
+
+    private enum Received {
+        case frame(SharedFrame)
+        case idle
+        case finished
+    }
+
+    /// Wait briefly for the next message.
+    private func receive() -> Received {
+        var message = SwiftShmMessage()
+        var caps = [CChar](repeating: 0, count: 4096)
+        let result = caps.withUnsafeMutableBufferPointer {
+            swift_shm_receive(connection, &message, nil, $0.baseAddress, gsize($0.count), 100)
+        }
+        guard result >= 0 else { return .finished }
+        guard result > 0 else { return .idle }
+
+        switch SwiftShmMessageKind(rawValue: message.kind) {
+        case SWIFT_SHM_MESSAGE_CAPS:
+            let string = caps.withUnsafeBufferPointer { String(cString: $0.baseAddress!) }
+            status.withLock { $0.caps = string }
+            return .idle
+        case SWIFT_SHM_MESSAGE_FRAME:
+            guard Int(message.slot) < slotCount, Int(message.size) <= slotStride else { return .idle }
+            return .frame(SharedFrame(subscriber: self, message: message, caps: status.withLock { $0.caps }))
+        case SWIFT_SHM_MESSAGE_EOS:
+            return .finished
+        default:
+            return .idle
+        }
+    }
+
+    fileprivate func bytes(of slot: Int) -> UnsafeRawPointer {
+        base + slot * slotStride
+    }
+
+    fileprivate func release(_ slot: Int) {
+        var message = SwiftShmMessage()
+        message.kind = guint32(SWIFT_SHM_MESSAGE_RELEASE.rawValue)
+        message.slot = guint32(slot)
+        sendLock.withLock { _ in _ = swift_shm_send(connection, &message, -1, nil, 0) }
+    }
+}
+
+/// A frame in a shared memory slot, received by a ``SharedMemorySubscriber``.
+///
+/// The bytes stay in the publisher's slot until ``release()``; releasing
+/// more than once is harmless, and a frame that is never released
+/// explicitly is released when it is deinitialized.
+public final class SharedFrame: Sendable {
+    /// The slot the frame occupies.
+    public let slot: Int
+    /// Size of the frame in bytes.
+    public let size: Int
+    /// Publisher's frame counter, increasing by one per published frame.
+    public let sequence: UInt64
+    /// Presentation timestamp in nanoseconds.
+    public let pts: UInt64?
+    /// Decode timestamp in nanoseconds.
+    public let dts: UInt64?
+    /// Duration in nanoseconds.
+    public let duration: UInt64?
+    /// The caps of the stream, as last sent by the publisher.
+    public let caps: String?
+
+    private let subscriber: SharedMemorySubscriber
+    private let released = Atomic<Bool>(false)
+
+    fileprivate init(subscriber: SharedMemorySubscriber, message: SwiftShmMessage, caps: String?) {
+        func time(_ value: guint64) -> UInt64? {
+            swift_gst_clock_time_is_valid(value) != 0 ? UInt64(value) : nil
+        }
+        self.subscriber = subscriber
+        self.slot = Int(message.slot)
+        self.size = Int(message.size)
+        self.sequence = UInt64(message.sequence)
+        self.pts = time(message.pts)
+        self.dts = time(message.dts)
+        self.duration = time(message.duration)
+        self.caps = caps
+    }
+
+    deinit {
+        release()
+    }
+
+    /// Whether the slot has been handed back to the publisher.
+    public var isReleased: Bool {
+        released.load(ordering: .acquiring)
+    }
+
+    /// Read the frame in place.
+    ///
+    /// - Parameter body: Receives the frame's bytes. The span is only valid
+    ///   inside the closure.
+    /// - Returns: The value returned by `body`, or `nil` if the frame was
+    ///   already released.
+    public func withBytes<R>(_ body: (RawSpan) throws -> R) rethrows -> R? {
+        guard !isReleased else { return nil }
+        return try body(RawSpan(_unsafeStart: subscriber.bytes(of: slot), byteCount: size))
+    }
+
+    /// Hand the slot back so the publisher can reuse it.
+    public func release() {
+        guard !released.exchange(true, ordering: .acquiringAndReleasing) else { return }
+        subscriber.release(slot)
+    }
+}
+
+/// A thread of its own for blocking socket work.
+///
+/// Accepting, handshakes and reading control messages wait in `poll`;
+/// doing that in a task would hold one of the cooperative pool's few
+/// threads for as long as a peer is connected.
+private final class SocketThread: Sendable {
+    private let body: @Sendable () -> Void
+
+    private init(body: @escaping @Sendable () -> Void) {
+        self.body = body
+    }
+
+    /// Run `body` on a new detached thread.
+    static func start(named name: String, _ body: @escaping @Sendable () -> Void) {
+        let context = Unmanaged.passRetained(SocketThread(body: body))
+        swift_shm_thread_start(
+            name,
+            { userData in
+                guard let userData else { return }
+                Unmanaged<SocketThread>.fromOpaque(userData).takeRetainedValue().body()
+            },
+            context.toOpaque()
+        )
+    }
+
+    /// Run `body` on a new thread and suspend until it returns.
+    static func run<T: Sendable>(named name: String, _ body: @escaping @Sendable () -> T) async -> T {
+        await withCheckedContinuation { continuation in
+            start(named: name) { continuation.resume(returning: body()) }
+        }
+    }
+}
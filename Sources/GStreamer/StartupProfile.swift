@@ -0,0 +1,271 @@
+import CGStreamer
+import CGStreamerShim
+import Synchronization
+
+extension Pipeline {
+    /// Where a pipeline spent its time getting from description to PLAYING.
+    ///
+    /// Enable recording with ``Pipeline/init(_:profileStartup:)`` and read the
+    /// result from ``Pipeline/startupProfile``. All times are measured from
+    /// the start of ``Pipeline/init(_:profileStartup:)``.
+    ///
+    /// GStreamer changes the state of a bin's children one at a time, sinks
+    /// first, so each element's ``Transition/elapsed`` is the time since the
+    /// previous recorded event: for `null → ready` that is mostly the device
+    /// or resource open, for `ready → paused` the element's own setup. Time
+    /// spent waiting for the first buffer to reach the sinks shows up as
+    /// ``prerollWait``.
+    ///
+    /// ## Example
+    ///
+    /// ```swift
+    /// let pipeline = try Pipeline(
+    ///     "v4l2src ! videoconvert ! appsink name=sink",
+    ///     profileStartup: true
+    /// )
+    /// try await pipeline.play(timeout: .seconds(10))
+    ///
+    /// if let profile = pipeline.startupProfile {
+    ///     print(profile)
+    ///     // startup 3120ms (parse 12ms, ready 2804ms, paused 2811ms, preroll wait 301ms, playing 3120ms)
+    ///     //   v4l2src0 null → ready 2751ms
+    ///     //   ...
+    /// }
+    /// ```
+    public struct StartupProfile: Sendable, CustomStringConvertible {
+        /// One element completing a state transition.
+        public struct Transition: Sendable, Hashable {
+            /// The element name.
+            public let element: String
+            /// The state the element left.
+            public let from: State
+            /// The state the element reached.
+            public let to: State
+            /// When the transition completed.
+            public let at: Duration
+            /// Time since the previous recorded event, attributed to this transition.
+            public let elapsed: Duration
+        }
+
+        /// Time spent in `gst_parse_launch`, including element instantiation.
+        public let parse: Duration
+
+        /// Element transitions, in the order they completed.
+        ///
+        /// The pipeline's own transitions are reported in ``reached`` instead.
+        public let transitions: [Transition]
+
+        /// When the pipeline itself reached each state.
+        public let reached: [State: Duration]
+
+        /// When preroll completed (`ASYNC_DONE`), if it has.
+        public let prerolled: Duration?
+
+        /// Time between the last element reaching PAUSED and preroll completing.
+        ///
+        /// This is dominated by the first buffer travelling from the source to
+        /// the sinks: a camera delivering its first frame, a demuxer reading
+        /// headers, a network source buffering.
+        public var prerollWait: Duration? {
+            guard let prerolled else { return nil }
+            let before = transitions.last(where: { $0.at <= prerolled })?.at ?? parse
+            return prerolled - before
+        }
+
+        /// Time from the start of parsing until the pipeline was playing, or
+        /// prerolled if it hasn't reached PLAYING.
+        public var total: Duration? {
+            reached[.playing] ?? prerolled
+        }
+
+        /// The transitions that took longest, slowest first.
+        ///
+        /// - Parameter count: Maximum number of transitions to return.
+        public func slowest(_ count: Int = 5) -> [Transition] {
+            Array(transitions.sorted { $0.elapsed > $1.elapsed }.prefix(count))
+        }
+
+        /// Total attributed time per element, slowest first.
+        public var timeByElement: [(element: String, elapsed: Duration)] {
+            var totals: [String: Duration] = [:]
+            for transition in transitions {
+                totals[transition.element, default: .zero] += transition.elapsed
+            }
+            return totals
+                .map { (element: $0.key, elapsed: $0.value) }
+                .sorted { $0.elapsed > $1.elapsed }
+        }
+
+        public var description: String {
+            func ms(_ duration: Duration) -> String {
+                "\(duration.components.seconds * 1_000 + duration.components.attoseconds / 1_000_000_000_000_000)ms"
+            }
+
+            var summary = ["parse \(ms(parse))"]
+            for state in [State.ready, .paused] {
+                if let at = reached[state] {
+                    summary.append("\(state) \(ms(at))")
+                }
+            }
+            if let prerollWait {
+                summary.append("preroll wait \(ms(prerollWait))")
+            }
+            if let at = reached[.playing] {
+                summary.append("playing \(ms(at))")
+            }
+
+            var lines = ["startup \(total.map(ms) ?? "incomplete") (\(summary.joined(separator: ", ")))"]
+            for transition in slowest() {
+                lines.append("  \(transition.element) \(transition.from) → \(transition.to) \(ms(transition.elapsed))")
+            }
+            return lines.joined(separator: "\n")
+        }
+    }
+}
+
+/// Records element state changes as they are posted, for ``Pipeline/StartupProfile``.
+///
+/// Messages are observed with a bus sync observer on the posting thread, so
+/// timestamps are exact and nothing is removed from the bus. Recording stops
+/// once the pipeline reaches PLAYING.
+internal final class StartupProfiler: @unchecked Sendable {
+    private struct Record {
+        var transitions: [Pipeline.StartupProfile.Transition] = []
+        var reached: [Pipeline.State: Duration] = [:]
+        var prerolled: Duration?
+        var lastEvent: Duration = .zero
+        var isComplete = false
+    }
+
+    private let start: ContinuousClock.Instant
+    private let parse: Duration
+    private let pipelineAddress: UInt
+    private let record = Mutex(Record())
+    private let bus: UnsafeMutablePointer<GstBus>?
+    private let handler = Mutex<gulong>(0)
+
+    /// - Parameters:
+    ///   - pipeline: The parsed pipeline element.
+    ///   - start: When parsing started.
+    init(pipeline: UnsafeMutablePointer<GstElement>, start: ContinuousClock.Instant) {
+        self.start = start
+        self.parse = start.duration(to: .now)
+        self.pipelineAddress = UInt(bitPattern: pipeline)
+        self.bus = swift_gst_element_get_bus(pipeline)
+        record.withLock { $0.lastEvent = parse }
+    }
+
+    deinit {
+        if let bus {
+            swift_gst_object_unref(bus)
+        }
+    }
+
+    /// Start observing the pipeline's bus.
+    func attach() {
+        guard let bus else { return }
+
+        let observer: SwiftGstBusSyncObserver = { message, userData in
+            guard let message, let userData else { return }
+            Unmanaged<StartupProfiler>.fromOpaque(userData).takeUnretainedValue().observe(message)
+        }
+        let destroy: GDestroyNotify = { userData in
+            guard let userData else { return }
+            Unmanaged<StartupProfiler>.fromOpaque(userData).release()
+        }
+
+        let id = swift_gst_bus_add_sync_observer(
+            bus,
+            observer,
+            Unmanaged.passRetained(self).toOpaque(),
+            destroy
+        )
+        handler.withLock { $0 = id }
+    }
+
+    /// Stop observing the pipeline's bus.
+    func detach() {
+        let id = handler.withLock { id in
+            defer { id = 0 }
+            return id
+        }
+        if let bus, id != 0 {
+            swift_gst_bus_remove_sync_observer(bus, id)
+        }
+    }
+
+    /// Mark the start of a state change requested by the application, so
+    /// idle time before it isn't attributed to the first element.
+    func stateRequested() {
+        let at = start.duration(to: .now)
+        record.withLock { record in
+            guard !record.isComplete else { return }
+            record.lastEvent = at
+        }
+    }
+
+    /// The profile recorded so far.
+    var profile: Pipeline.StartupProfile {
+        record.withLock { record in
+            Pipeline.StartupProfile(
+                parse: parse,
+                transitions: record.transitions,
+                reached: record.reached,
+                prerolled: record.prerolled
+            )
+        }
+    }
+
+    private func observe(_ message: UnsafeMutablePointer<GstMessage>) {
+        let type = swift_gst_message_type(message)
+        guard type == GST_MESSAGE_STATE_CHANGED || type == GST_MESSAGE_ASYNC_DONE else { return }
+
+        let at = start.duration(to: .now)
+        let source = swift_gst_message_src(message)
+        let isPipeline = UInt(bitPattern: source) == pipelineAddress
+
+        if type == GST_MESSAGE_ASYNC_DONE {
+            guard isPipeline else { return }
+            record.withLock { record in
+                guard !record.isComplete, record.prerolled == nil else { return }
+                record.prerolled = at
+                record.lastEvent = at
+            }
+            return
+        }
+
+        var old: GstState = GST_STATE_NULL
+        var new: GstState = GST_STATE_NULL
+        var pending: GstState = GST_STATE_NULL
+        swift_gst_message_parse_state_changed(message, &old, &new, &pending)
+        let from = Pipeline.State(gstState: old)
+        let to = Pipeline.State(gstState: new)
+
+        if isPipeline {
+            record.withLock { record in
+                guard !record.isComplete else { return }
+                record.reached[to] = at
+                record.lastEvent = at
+                if to == .playing {
+                    record.isComplete = true
+                }
+            }
+            return
+        }
+
+        let element = source.flatMap { GLibString.takeOwnership(gst_object_get_name($0)) } ?? "unknown"
+        record.withLock { record in
+            guard !record.isComplete else { return }
+            record.transitions.append(
+                Pipeline.StartupProfile.Transition(
+                    element: element,
+                    from: from,
+                    to: to,
+                    at: at,
+                    elapsed: at - record.lastEvent
+                )
+            )
+            record.lastEvent = at
+        }
+    }
+}
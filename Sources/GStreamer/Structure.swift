@@ -0,0 +1,145 @@
+import CGStreamer
+import CGStreamerShim
+
+/// A read-only view of a GStreamer structure.
+///
+/// Structures are the named key/value records GStreamer uses for message
+/// payloads, caps and events. `Structure` does not copy anything up front:
+/// it keeps its owner (a ``Message`` or ``Caps``) alive and decodes a field
+/// only when you ask for it, so subscribing to high-rate element messages
+/// costs nothing for fields you never read.
+///
+/// ## Example
+///
+/// ```swift
+/// // level element: peak and RMS per channel
+/// for await message in pipeline.bus.rawMessages(filter: .element) {
+///     guard let structure = message.structure, structure.name == "level" else {
+///         continue
+///     }
+///     let endTime = structure.uint64("endtime")
+///     let rms = structure.serializedValue("rms")
+/// }
+/// ```
+public struct Structure: @unchecked Sendable {
+    /// Keeps the memory `pointer` refers to alive.
+    private let owner: AnyObject
+
+    /// The underlying GstStructure pointer.
+    internal let pointer: UnsafePointer<GstStructure>
+
+    internal init(pointer: UnsafePointer<GstStructure>, owner: AnyObject) {
+        self.pointer = pointer
+        self.owner = owner
+    }
+
+    /// The structure's name (e.g. `"level"`, `"video/x-raw"`).
+    public var name: String {
+        GLibString.borrow(gst_structure_get_name(pointer)) ?? ""
+    }
+
+    /// Number of fields in the structure.
+    public var fieldCount: Int {
+        Int(gst_structure_n_fields(pointer))
+    }
+
+    /// Names of all fields, in order.
+    public var fieldNames: [String] {
+        (0..<gst_structure_n_fields(pointer)).compactMap {
+            GLibString.borrow(gst_structure_nth_field_name(pointer, guint($0)))
+        }
+    }
+
+    /// Whether the structure has a field with the given name.
+    public func has(_ field: String) -> Bool {
+        gst_structure_has_field(pointer, field) != 0
+    }
+
+    // MARK: - Typed Access
+
+    /// Read a `gint` field.
+    public func int(_ field: String) -> Int? {
+        var value: gint = 0
+        guard gst_structure_get_int(pointer, field, &value) != 0 else { return nil }
+        return Int(value)
+    }
+
+    /// Read a `guint` field.
+    public func uint(_ field: String) -> UInt? {
+        var value: guint = 0
+        guard gst_structure_get_uint(pointer, field, &value) != 0 else { return nil }
+        return UInt(value)
+    }
+
+    /// Read a `gint64` field.
+    public func int64(_ field: String) -> Int64? {
+        var value: gint64 = 0
+        guard gst_structure_get_int64(pointer, field, &value) != 0 else { return nil }
+        return Int64(value)
+    }
+
+    /// Read a `guint64` field, including `GstClockTime` values.
+    public func uint64(_ field: String) -> UInt64? {
+        var value: guint64 = 0
+        guard gst_structure_get_uint64(pointer, field, &value) != 0 else { return nil }
+        return UInt64(value)
+    }
+
+    /// Read a `gdouble` field.
+    public func double(_ field: String) -> Double? {
+        var value: gdouble = 0
+        guard gst_structure_get_double(pointer, field, &value) != 0 else { return nil }
+        return Double(value)
+    }
+
+    /// Read a `gboolean` field.
+    public func bool(_ field: String) -> Bool? {
+        var value: gboolean = 0
+        guard gst_structure_get_boolean(pointer, field, &value) != 0 else { return nil }
+        return value != 0
+    }
+
+    /// Read a string field.
+    public func string(_ field: String) -> String? {
+        GLibString.borrow(gst_structure_get_string(pointer, field))
+    }
+
+    /// Read a `GstFraction` field such as a framerate.
+    public func fraction(_ field: String) -> (numerator: Int, denominator: Int)? {
+        var numerator: gint = 0
+        var denominator: gint = 0
+        guard gst_structure_get_fraction(pointer, field, &numerator, &denominator) != 0 else {
+            return nil
+        }
+        return (Int(numerator), Int(denominator))
+    }
+
+    /// Serialize any field to its GStreamer string form.
+    ///
+    /// Use this for lists, arrays and other types without a typed accessor.
+    /// Serialization allocates, so prefer the typed accessors on hot paths.
+    public func serializedValue(_ field: String) -> String? {
+        guard let value = gst_structure_get_value(pointer, field) else { return nil }
+        return GLibString.takeOwnership(gst_value_serialize(value))
+    }
+
+    /// All fields serialized to strings.
+    ///
+    /// This decodes every field; it exists for logging and compatibility.
+    public var fields: [String: String] {
+        var result: [String: String] = [:]
+        for name in fieldNames {
+            result[name] = serializedValue(name)
+        }
+        return result
+    }
+}
+
+// MARK: - CustomStringConvertible
+
+extension Structure: CustomStringConvertible {
+    /// The structure in GStreamer's string form.
+    public var description: String {
+        GLibString.takeOwnership(gst_structure_to_string(pointer)) ?? name
+    }
+}
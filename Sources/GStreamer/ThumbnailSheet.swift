@@ -0,0 +1,364 @@
+import CGStreamerShim
+import Synchronization
+
+/// Generates a grid of evenly spaced keyframe thumbnails for a video file.
+///
+/// Decoding an entire file to sample a hundred frames wastes nearly all of
+/// the work. `ThumbnailSheet` instead seeks a paused pipeline to each sample
+/// point with key-unit trick-mode seeks, so the decoder only ever sees the
+/// keyframe nearest each point. The prerolled frame is downscaled in-process
+/// straight into its tile of a single preallocated BGRA image.
+///
+/// ## Example
+///
+/// ```swift
+/// let sheet = ThumbnailSheet(columns: 10, rows: 10, tileWidth: 160, tileHeight: 90)
+///
+/// let image = try await sheet.generate(uri: "file:///videos/movie.mp4")
+/// let jpeg = try await image.jpegData(quality: 85)
+/// ```
+///
+/// ## Many Files
+///
+/// ```swift
+/// await sheet.generate(uris: libraryURIs, maxConcurrent: 4) { uri, result in
+///     switch result {
+///     case .success(let image):
+///         try? await store.save(image, for: uri)
+///     case .failure(let error):
+///         print("\(uri): \(error)")
+///     }
+/// }
+/// ```
+public struct ThumbnailSheet: Sendable {
+    /// A composited thumbnail sheet.
+    public struct Image: Sendable {
+        /// Width of the sheet in pixels.
+        public let width: Int
+
+        /// Height of the sheet in pixels.
+        public let height: Int
+
+        /// Tightly packed BGRA pixels, `width * 4` bytes per row.
+        public let pixels: [UInt8]
+
+        /// Presentation timestamp of the keyframe shown in each tile, in
+        /// row-major order. `nil` for tiles that could not be filled.
+        public let timestamps: [UInt64?]
+
+        /// JPEG encoders of the sheet that generated this image.
+        internal let encoders: Encoders
+
+        /// Encode the sheet as a JPEG image.
+        ///
+        /// Images from the same ``ThumbnailSheet`` share a warm encoder
+        /// pipeline per quality, so encoding many sheets doesn't build a
+        /// pipeline for each.
+        ///
+        /// - Parameter quality: JPEG quality from 0 to 100.
+        /// - Returns: The encoded JPEG bytes.
+        public func jpegData(quality: Int = 85) async throws -> [UInt8] {
+            let buffer = try Buffer(data: pixels)
+            let frame = VideoFrame(
+                buffer: swift_gst_buffer_ref(buffer.buffer),
+                width: width,
+                height: height,
+                format: .bgra,
+                ownsReference: true
+            )
+            let jpeg = try await encoders.encoder(quality: quality).encode(frame)
+            return jpeg.bytes.withUnsafeBytes { Array($0) }
+        }
+    }
+
+    /// JPEG encoders shared by the images of one sheet, one per quality.
+    internal final class Encoders: Sendable {
+        private let byQuality = Mutex<[Int: ImageEncoder]>([:])
+
+        func encoder(quality: Int) -> ImageEncoder {
+            byQuality.withLock { encoders in
+                if let encoder = encoders[quality] {
+                    return encoder
+                }
+                let encoder = ImageEncoder(format: .jpeg(quality: quality), maxPipelines: 1)
+                encoders[quality] = encoder
+                return encoder
+            }
+        }
+    }
+
+    /// Errors specific to thumbnail generation.
+    public enum ThumbnailError: Error, Sendable, CustomStringConvertible {
+        /// The source did not report a duration after preroll.
+        case durationUnavailable
+
+        /// No tile could be filled.
+        case noFrames
+
+        public var description: String {
+            switch self {
+            case .durationUnavailable:
+                return "Source did not report a duration; thumbnail sheets require a seekable file"
+            case .noFrames:
+                return "No keyframes could be decoded for the thumbnail sheet"
+            }
+        }
+    }
+
+    /// Number of tiles per row.
+    public let columns: Int
+
+    /// Number of tile rows.
+    public let rows: Int
+
+    /// Width of each tile in pixels.
+    public let tileWidth: Int
+
+    /// Height of each tile in pixels.
+    public let tileHeight: Int
+
+    /// Maximum time to wait for each seek to preroll.
+    public let seekTimeout: Duration
+
+    private let encoders = Encoders()
+
+    /// Create a thumbnail sheet layout.
+    ///
+    /// Frames are scaled to fit their tile while preserving aspect ratio;
+    /// unused tile area is left black.
+    ///
+    /// - Parameters:
+    ///   - columns: Number of tiles per row.
+    ///   - rows: Number of tile rows.
+    ///   - tileWidth: Width of each tile in pixels.
+    ///   - tileHeight: Height of each tile in pixels.
+    ///   - seekTimeout: Maximum time to wait for each seek to preroll.
+    public init(
+        columns: Int = 10,
+        rows: Int = 10,
+        tileWidth: Int = 160,
+        tileHeight: Int = 90,
+        seekTimeout: Duration = .seconds(5)
+    ) {
+        self.columns = columns
+        self.rows = rows
+        self.tileWidth = tileWidth
+        self.tileHeight = tileHeight
+        self.seekTimeout = seekTimeout
+    }
+
+    /// Generate a thumbnail sheet for one file.
+    ///
+    /// - Parameter uri: URI of the file (e.g. `file:///path/to/video.mp4`).
+    /// - Returns: The composited sheet.
+    /// - Throws: ``ThumbnailError`` if the file has no duration or no frames,
+    ///   or ``GStreamerError`` if the pipeline fails.
+    public func generate(uri: String) async throws -> Image {
+        let width = columns * tileWidth
+        let height = rows * tileHeight
+        let tileCount = columns * rows
+
+        let pipeline = try Pipeline(
+            """
+            uridecodebin uri=\(uri.pipelineQuoted) ! videoconvert ! video/x-raw,format=BGRA ! \
+            appsink name=sink sync=false max-buffers=1
+            """
+        )
+        defer { pipeline.stop() }
+
+        let sink = try pipeline.appSink(named: "sink")
+        try await pipeline.pause(timeout: seekTimeout)
+
+        guard let duration = pipeline.duration, duration > 0 else {
+            throw ThumbnailError.durationUnavailable
+        }
+
+        var pixels = [UInt8](repeating: 0, count: width * height * 4)
+        var timestamps = [UInt64?](repeating: nil, count: tileCount)
+
+        for (index, position) in Self.samplePoints(duration: duration, count: tileCount).enumerated() {
+            try Task.checkCancellation()
+
+            try pipeline.seek(
+                from: position,
+                to: nil,
+                flags: [.flush, .keyUnit, .snapNearest, .trickmode, .trickmodeKeyUnits]
+            )
+            _ = try await pipeline.settle(timeout: seekTimeout)
+
+            guard let frame = try await sink.preroll(timeout: seekTimeout),
+                  frame.width > 0, frame.height > 0
+            else {
+                continue
+            }
+
+            let tileX = (index % columns) * tileWidth
+            let tileY = (index / columns) * tileHeight
+
+            // Sparse keyframes can snap neighbouring points onto the same
+            // frame; reuse the scaled tile instead of filtering it again.
+            if index > 0, let previous = timestamps[index - 1], previous == frame.pts {
+                Self.copyTile(
+                    in: &pixels, stride: width * 4,
+                    from: ((index - 1) % columns) * tileWidth, ((index - 1) / columns) * tileHeight,
+                    to: tileX, tileY,
+                    width: tileWidth, height: tileHeight
+                )
+            } else {
+                try frame.withUnsafeBytes { source in
+                    pixels.withUnsafeMutableBytes { destination in
+                        Self.scaleToFit(
+                            source: source,
+                            sourceWidth: frame.width,
+                            sourceHeight: frame.height,
+                            sourceStride: source.count / frame.height,
+                            into: destination,
+                            destinationStride: width * 4,
+                            x: tileX,
+                            y: tileY,
+                            width: tileWidth,
+                            height: tileHeight
+                        )
+                    }
+                }
+            }
+            timestamps[index] = frame.pts
+        }
+
+        guard timestamps.contains(where: { $0 != nil }) else {
+            throw ThumbnailError.noFrames
+        }
+
+        return Image(width: width, height: height, pixels: pixels, timestamps: timestamps, encoders: encoders)
+    }
+
+    /// Generate thumbnail sheets for many files with bounded parallelism.
+    ///
+    /// At most `maxConcurrent` pipelines exist at any time; each one is torn
+    /// down before the next file starts. Failures are reported per file and
+    /// do not stop the remaining work.
+    ///
+    /// - Parameters:
+    ///   - uris: URIs of the files to process.
+    ///   - maxConcurrent: Maximum number of files processed at once.
+    ///   - handler: Called once per file, in completion order.
+    public func generate(
+        uris: [String],
+        maxConcurrent: Int,
+        _ handler: @escaping @Sendable (String, Result<Image, any Error>) async -> Void
+    ) async {
+        await withTaskGroup(of: Void.self) { group in
+            var pending = uris.makeIterator()
+            var running = 0
+
+            while let uri = pending.next() {
+                if running >= max(1, maxConcurrent) {
+                    _ = await group.next()
+                    running -= 1
+                }
+                group.addTask {
+                    do {
+                        await handler(uri, .success(try await generate(uri: uri)))
+                    } catch {
+                        await handler(uri, .failure(error))
+                    }
+                }
+                running += 1
+            }
+        }
+    }
+
+    // MARK: - Sampling
+
+    /// Midpoints of `count` equal slices of `duration`.
+    internal static func samplePoints(duration: UInt64, count: Int) -> [UInt64] {
+        guard count > 0 else { return [] }
+        let slices = UInt64(count)
+        return (0..<slices).map { duration * (2 * $0 + 1) / (2 * slices) }
+    }
+
+    // MARK: - Compositing
+
+    /// Box-filter a BGRA image into a rectangle of a larger BGRA image,
+    /// preserving aspect ratio and centering it.
+    ///
+    /// Each destination pixel averages the source pixels it covers, which
+    /// avoids the aliasing of nearest-neighbour sampling at large reductions.
+    internal static func scaleToFit(
+        source: UnsafeRawBufferPointer,
+        sourceWidth: Int,
+        sourceHeight: Int,
+        sourceStride: Int,
+        into destination: UnsafeMutableRawBufferPointer,
+        destinationStride: Int,
+        x: Int,
+        y: Int,
+        width: Int,
+        height: Int
+    ) {
+        guard sourceWidth > 0, sourceHeight > 0, width > 0, height > 0 else { return }
+
+        // Fit inside the tile without distortion.
+        var fitWidth = width
+        var fitHeight = sourceHeight * width / sourceWidth
+        if fitHeight > height {
+            fitHeight = height
+            fitWidth = max(1, sourceWidth * height / sourceHeight)
+        }
+        fitHeight = max(1, fitHeight)
+        let originX = x + (width - fitWidth) / 2
+        let originY = y + (height - fitHeight) / 2
+
+        // Source column span for every destination column.
+        let columnSpans = (0..<fitWidth).map { column -> (Int, Int) in
+            let start = column * sourceWidth / fitWidth
+            let end = max(start + 1, (column + 1) * sourceWidth / fitWidth)
+            return (start, end)
+        }
+
+        for row in 0..<fitHeight {
+            let rowStart = row * sourceHeight / fitHeight
+            let rowEnd = max(rowStart + 1, (row + 1) * sourceHeight / fitHeight)
+            let destinationRow = (originY + row) * destinationStride + originX * 4
+
+            for (column, (columnStart, columnEnd)) in columnSpans.enumerated() {
+                var b = 0, g = 0, r = 0, a = 0
+                for sourceRow in rowStart..<rowEnd {
+                    var offset = sourceRow * sourceStride + columnStart * 4
+                    for _ in columnStart..<columnEnd {
+                        b += Int(source[offset])
+                        g += Int(source[offset + 1])
+                        r += Int(source[offset + 2])
+                        a += Int(source[offset + 3])
+                        offset += 4
+                    }
+                }
+                let count = (rowEnd - rowStart) * (columnEnd - columnStart)
+                let offset = destinationRow + column * 4
+                destination[offset] = UInt8(b / count)
+                destination[offset + 1] = UInt8(g / count)
+                destination[offset + 2] = UInt8(r / count)
+                destination[offset + 3] = UInt8(a / count)
+            }
+        }
+    }
+
+    /// Copy one tile of the sheet onto another.
+    private static func copyTile(
+        in pixels: inout [UInt8],
+        stride: Int,
+        from sourceX: Int, _ sourceY: Int,
+        to destinationX: Int, _ destinationY: Int,
+        width: Int,
+        height: Int
+    ) {
+        pixels.withUnsafeMutableBytes { buffer in
+            for row in 0..<height {
+                let source = (sourceY + row) * stride + sourceX * 4
+                let destination = (destinationY + row) * stride + destinationX * 4
+                buffer.baseAddress!.advanced(by: destination)
+                    .copyMemory(from: buffer.baseAddress!.advanced(by: source), byteCount: width * 4)
+            }
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/// Offline caps negotiation used by ``VideoSourceBuilder``.
+///
+/// Given what a source can produce and what the consumer (appsink or an
+/// encoder) accepts, the negotiator finds the cheapest chain of conversion
+/// elements by intersecting caps in memory, before any pipeline exists.
+internal struct VideoCapsNegotiator {
+    /// The elements needed between source and consumer, and the source mode to pin.
+    struct Plan {
+        /// Insert `videoconvert` (source format not accepted downstream).
+        var needsConvert: Bool
+        /// Insert `videoscale` (source can't produce the requested size).
+        var needsScale: Bool
+        /// Insert `videorate` (source can't produce the requested framerate).
+        var needsRate: Bool
+        /// Fixed caps to request from the source, or `nil` to let it choose.
+        var sourceCaps: Caps?
+
+        /// The historical chain: convert, scale and rate, source unconstrained.
+        static let fullChain = Plan(needsConvert: true, needsScale: true, needsRate: true, sourceCaps: nil)
+    }
+
+    /// Caps the source can produce.
+    let available: Caps
+    /// Requested output size.
+    let size: (width: Int, height: Int)?
+    /// Requested output framerate.
+    let framerate: Int?
+    /// Raw formats the consumer accepts, in order of preference.
+    let formats: [PixelFormat]
+    /// Caps the consumer's sink pad accepts (e.g. an encoder), if any.
+    let consumerCaps: Caps?
+    /// Whether a scaler is required regardless of caps (crop/letterbox).
+    let requiresScale: Bool
+
+    /// Find the cheapest chain that connects the source to the consumer.
+    ///
+    /// Candidates are tried from cheapest to most expensive. A rate adapter
+    /// only drops or duplicates buffers, so it is preferred over a format
+    /// conversion, which touches every pixel; scaling is considered the most
+    /// expensive step since it also filters.
+    ///
+    /// - Returns: A plan, or `nil` if no combination intersects.
+    func negotiate() -> Plan? {
+        let candidates: [(convert: Bool, rate: Bool, scale: Bool)] = [
+            (false, false, false),
+            (false, true, false),
+            (true, false, false),
+            (true, true, false),
+            (false, false, true),
+            (false, true, true),
+            (true, false, true),
+            (true, true, true),
+        ]
+
+        for candidate in candidates {
+            if requiresScale && !candidate.scale { continue }
+            if candidate.rate && framerate == nil { continue }
+            if candidate.scale && size == nil && !requiresScale { continue }
+
+            if let sourceCaps = sourceCaps(convert: candidate.convert, rate: candidate.rate, scale: candidate.scale) {
+                return Plan(
+                    needsConvert: candidate.convert,
+                    needsScale: candidate.scale,
+                    needsRate: candidate.rate,
+                    sourceCaps: sourceCaps
+                )
+            }
+        }
+
+        return nil
+    }
+
+    /// Source caps compatible with a chain, or `nil` if none.
+    ///
+    /// Every constraint that a present element can satisfy is dropped from the
+    /// source side: a converter frees the format, a scaler the size, a rate
+    /// adapter the framerate.
+    private func sourceCaps(convert: Bool, rate: Bool, scale: Bool) -> Caps? {
+        var builder = CapsBuilder.video()
+
+        if !convert, !formats.isEmpty {
+            builder = builder.formats(formats)
+        }
+        if !scale, let size {
+            builder = builder.size(width: size.width, height: size.height)
+        }
+        if !rate, let framerate {
+            builder = builder.framerate(framerate, 1)
+        }
+
+        var candidate = builder.buildCaps().intersect(available)
+        if !convert, let consumerCaps {
+            candidate = candidate.intersect(consumerCaps)
+        }
+        guard !candidate.isEmpty else { return nil }
+
+        // When scaling, prefer a mode at least as large as the output so the
+        // scaler only ever downsamples.
+        if scale, let size {
+            let larger = CapsBuilder.video()
+                .width(in: size.width...Int(Int32.max))
+                .height(in: size.height...Int(Int32.max))
+                .buildCaps()
+                .intersect(candidate)
+            if !larger.isEmpty {
+                return fixate(larger)
+            }
+        }
+
+        return fixate(candidate)
+    }
+
+    /// Size a source falls back to when neither the request nor the source
+    /// offers one, such as `videotestsrc` with its open ranges.
+    static let defaultSize = (width: 640, height: 480)
+
+    /// Framerate a source falls back to when none was requested.
+    static let defaultFramerate = 30
+
+    /// Fix the source caps without collapsing open ranges to their minimum.
+    ///
+    /// Fields the request constrains are fixated toward the requested value;
+    /// a scaler or rate adapter downstream then has the least work to do.
+    /// Otherwise the size goes to the source's largest fixed mode and the
+    /// framerate to ``defaultFramerate``.
+    private func fixate(_ caps: Caps) -> Caps {
+        var caps = caps
+        var target = size ?? Self.defaultSize
+        if size == nil, let largest = largestMode(in: caps) {
+            target = largest
+            caps = CapsBuilder.video()
+                .size(width: largest.width, height: largest.height)
+                .buildCaps()
+                .intersect(caps)
+        }
+        return caps.fixated(width: target.width, height: target.height, framerate: framerate ?? Self.defaultFramerate)
+    }
+
+    /// The largest fixed size among the caps' structures, if any.
+    private func largestMode(in caps: Caps) -> (width: Int, height: Int)? {
+        var largest: (width: Int, height: Int)?
+        for index in 0..<caps.structureCount {
+            guard let structure = caps.structure(at: index),
+                let width = structure.int("width"),
+                let height = structure.int("height")
+            else { continue }
+            if width * height > (largest.map { $0.width * $0.height } ?? 0) {
+                largest = (width, height)
+            }
+        }
+        return largest
+    }
+}
@@ -65,6 +65,10 @@ extension VideoFrame {
     /// - `.nv12` → `kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange`
     /// - `.i420` → `kCVPixelFormatType_420YpCbCr8Planar`
     /// - `.gray8` → `kCVPixelFormatType_OneComponent8`
+    /// - `.yuy2` → `kCVPixelFormatType_422YpCbCr8_yuvs`
+    /// - `.uyvy` → `kCVPixelFormatType_422YpCbCr8`
+    /// - `.p010` → `kCVPixelFormatType_420YpCbCr10BiPlanarVideoRange`
+    /// - `.gray16le` → `kCVPixelFormatType_OneComponent16`
     ///
     /// Other formats will return `nil`.
     public func toCVPixelBuffer() throws -> CVPixelBuffer? {
@@ -113,13 +117,14 @@ extension VideoFrame {
               let srcBase = src.baseAddress else { return }
 
         let destBytesPerRow = CVPixelBufferGetBytesPerRow(buffer)
-        let srcBytesPerRow = width * format.bytesPerPixel
+        let rowBytes = width * format.bytesPerPixel
+        let srcBytesPerRow = format.planes(width: width, height: height).first?.stride ?? rowBytes
 
         // Copy row by row to handle stride differences
         for y in 0..<height {
             let srcRow = srcBase.advanced(by: y * srcBytesPerRow)
             let destRow = destBase.advanced(by: y * destBytesPerRow)
-            memcpy(destRow, srcRow, srcBytesPerRow)
+            memcpy(destRow, srcRow, rowBytes)
         }
     }
 
@@ -135,18 +140,22 @@ extension VideoFrame {
             // I420: Y plane + U plane + V plane
             copyI420(from: src, to: buffer)
         default:
-            // For other planar formats, copy plane by plane
+            // For other planar formats (P010), copy row by row using
+            // GStreamer's plane layout on the source side
             guard let srcBase = src.baseAddress else { return }
-            var srcOffset = 0
-            for plane in 0..<planeCount {
+            let layout = format.planes(width: width, height: height)
+            for plane in 0..<min(planeCount, layout.count) {
                 guard let destBase = CVPixelBufferGetBaseAddressOfPlane(buffer, plane) else { continue }
-                let planeHeight = CVPixelBufferGetHeightOfPlane(buffer, plane)
-                let planeBytesPerRow = CVPixelBufferGetBytesPerRowOfPlane(buffer, plane)
-                let planeBytes = planeHeight * planeBytesPerRow
+                let source = layout[plane]
+                let planeHeight = min(CVPixelBufferGetHeightOfPlane(buffer, plane), source.height)
+                let destBytesPerRow = CVPixelBufferGetBytesPerRowOfPlane(buffer, plane)
+                let rowBytes = min(source.stride, destBytesPerRow)
 
-                let srcPlane = srcBase.advanced(by: srcOffset)
-                memcpy(destBase, srcPlane, planeBytes)
-                srcOffset += planeBytes
+                for y in 0..<planeHeight {
+                    let srcRow = srcBase.advanced(by: source.offset + y * source.stride)
+                    let destRow = destBase.advanced(by: y * destBytesPerRow)
+                    memcpy(destRow, srcRow, rowBytes)
+                }
             }
         }
     }
@@ -240,6 +249,14 @@ extension PixelFormat {
             return kCVPixelFormatType_420YpCbCr8Planar
         case .gray8:
             return kCVPixelFormatType_OneComponent8
+        case .yuy2:
+            return kCVPixelFormatType_422YpCbCr8_yuvs
+        case .uyvy:
+            return kCVPixelFormatType_422YpCbCr8
+        case .p010:
+            return kCVPixelFormatType_420YpCbCr10BiPlanarVideoRange
+        case .gray16le:
+            return kCVPixelFormatType_OneComponent16
         default:
             return nil
         }
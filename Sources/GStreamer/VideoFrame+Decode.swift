@@ -0,0 +1,225 @@
+import Synchronization
+
+extension VideoFrame {
+    /// Errors that can occur when decoding a compressed frame.
+    public enum DecodeError: Error, Sendable, CustomStringConvertible {
+        /// The frame is not JPEG-compressed.
+        case notJPEG(PixelFormat)
+
+        /// The frame has no known dimensions to describe to the decoder.
+        case unknownDimensions
+
+        /// The decoder produced no frame in time (e.g. corrupt JPEG data).
+        case timedOut
+
+        public var description: String {
+            switch self {
+            case .notJPEG(let format):
+                return "Only MJPEG frames can be decoded, got \(format)"
+            case .unknownDimensions:
+                return "Frame dimensions are unknown; cannot configure the decoder"
+            case .timedOut:
+                return "JPEG decoder produced no frame before the timeout"
+            }
+        }
+    }
+
+    /// Decode an MJPEG frame to raw pixels.
+    ///
+    /// Use this with ``VideoSource/Encoding/mjpeg`` capture to pay for JPEG
+    /// decoding only on the frames you actually inspect. Decoding runs on a
+    /// pool of persistent `jpegdec` pipelines, so repeated calls don't pay
+    /// for pipeline construction. The compressed buffer is handed to the
+    /// decoder without copying.
+    ///
+    /// When a smaller size is requested the decoder output is downscaled in
+    /// the same pipeline, so only the smaller frame is copied out.
+    ///
+    /// - Parameters:
+    ///   - width: Output width, or `nil` for the frame's own width. When only
+    ///     one dimension is given, the other keeps the aspect ratio.
+    ///   - height: Output height, or `nil` for the frame's own height.
+    ///   - format: Output pixel format.
+    ///   - timeout: Maximum time to wait for the decoded frame.
+    /// - Returns: The decoded frame, with this frame's timestamps.
+    /// - Throws: ``DecodeError`` if this frame isn't MJPEG or decoding fails,
+    ///   or ``GStreamerError`` if a decoder pipeline can't be created.
+    ///
+    /// ## Example
+    ///
+    /// ```swift
+    /// let source = try VideoSource.webcam()
+    ///     .withResolution(.hd1080p)
+    ///     .withFramerate(30)
+    ///     .withEncoding(.mjpeg)
+    ///     .build()
+    ///
+    /// var count = 0
+    /// for try await frame in source.frames() {
+    ///     count += 1
+    ///     guard count % 10 == 0 else { continue }  // inspect 1 frame in 10
+    ///
+    ///     let small = try await frame.decode(width: 480, format: .bgra)
+    ///     try detector.process(small)
+    /// }
+    /// ```
+    public func decode(
+        width: Int? = nil,
+        height: Int? = nil,
+        format: PixelFormat = .bgra,
+        timeout: Duration = .seconds(2)
+    ) async throws -> VideoFrame {
+        guard self.format == .mjpeg else {
+            throw DecodeError.notJPEG(self.format)
+        }
+        guard self.width > 0, self.height > 0 else {
+            throw DecodeError.unknownDimensions
+        }
+
+        let outputWidth: Int
+        let outputHeight: Int
+        switch (width, height) {
+        case let (width?, height?):
+            (outputWidth, outputHeight) = (width, height)
+        case let (width?, nil):
+            (outputWidth, outputHeight) = (width, evenRounded(width * self.height / self.width))
+        case let (nil, height?):
+            (outputWidth, outputHeight) = (evenRounded(height * self.width / self.height), height)
+        case (nil, nil):
+            (outputWidth, outputHeight) = (self.width, self.height)
+        }
+
+        let key = JPEGDecoderPool.Key(
+            inputWidth: self.width,
+            inputHeight: self.height,
+            outputWidth: outputWidth,
+            outputHeight: outputHeight,
+            format: format
+        )
+        return try await JPEGDecoderPool.shared.decode(self, key: key, timeout: timeout)
+    }
+}
+
+/// Round to the nearest even number, at least 2, for chroma-subsampled output.
+private func evenRounded(_ value: Int) -> Int {
+    max(2, (value + 1) & ~1)
+}
+
+/// Persistent JPEG decoding pipelines shared by ``VideoFrame/decode(width:height:format:timeout:)``.
+///
+/// Each decoder is fixed to one input size and one output size/format, so
+/// its caps never renegotiate. Decoders are checked out for the duration of
+/// a single decode; a few idle decoders per configuration are kept for reuse
+/// and any that fail are discarded. Idle decoders are kept for the most
+/// recently used configurations only, so a camera that changes resolution
+/// doesn't leave pipelines for the old size running.
+internal final class JPEGDecoderPool: Sendable {
+    /// The process-wide pool.
+    static let shared = JPEGDecoderPool(maxIdlePerKey: 2, maxKeys: 4)
+
+    /// A decoder configuration.
+    struct Key: Hashable, Sendable {
+        let inputWidth: Int
+        let inputHeight: Int
+        let outputWidth: Int
+        let outputHeight: Int
+        let format: PixelFormat
+    }
+
+    /// One `appsrc ! jpegdec ! videoconvert ! videoscale ! appsink` pipeline.
+    final class Decoder: @unchecked Sendable {
+        private let pipeline: Pipeline
+        private let source: AppSource
+        private let sink: AppSink
+
+        init(key: Key) throws {
+            pipeline = try Pipeline(
+                """
+                appsrc name=src format=time ! jpegdec ! videoconvert ! videoscale ! \
+                capsfilter name=caps ! appsink name=sink sync=false
+                """
+            )
+            source = try pipeline.appSource(named: "src")
+            sink = try pipeline.appSink(named: "sink")
+
+            source.setCaps(
+                CapsBuilder(mediaType: PixelFormat.mjpeg.mediaType)
+                    .size(width: key.inputWidth, height: key.inputHeight)
+                    .framerate(0, 1)
+                    .buildCaps()
+            )
+            pipeline.element(named: "caps")?.set(
+                "caps",
+                CapsBuilder.video()
+                    .format(key.format)
+                    .size(width: key.outputWidth, height: key.outputHeight)
+                    .buildCaps()
+            )
+
+            do {
+                try pipeline.play()
+            } catch {
+                pipeline.stop()
+                throw error
+            }
+        }
+
+        deinit {
+            pipeline.stop()
+        }
+
+        /// Decode one frame, or return `nil` if the decoder stalled.
+        func decode(_ frame: VideoFrame, timeout: Duration) async throws -> VideoFrame? {
+            try frame.withBuffer { try source.push(buffer: $0) }
+            return try await sink.pull(timeout: timeout)
+        }
+    }
+
+    /// Idle decoders and their configurations, least recently used first.
+    struct Idle {
+        var decoders: [Key: [Decoder]] = [:]
+        var recent: [Key] = []
+    }
+
+    private let maxIdlePerKey: Int
+    private let maxKeys: Int
+    private let idle = Mutex(Idle())
+
+    init(maxIdlePerKey: Int, maxKeys: Int) {
+        self.maxIdlePerKey = maxIdlePerKey
+        self.maxKeys = maxKeys
+    }
+
+    /// Configurations that currently have idle decoders.
+    var idleKeys: Set<Key> {
+        idle.withLock { Set($0.decoders.keys) }
+    }
+
+    /// Decode a frame on an idle decoder for `key`, creating one if needed.
+    func decode(_ frame: VideoFrame, key: Key, timeout: Duration) async throws -> VideoFrame {
+        let decoder = try idle.withLock { $0.decoders[key]?.popLast() } ?? Decoder(key: key)
+
+        // A decoder that failed is dropped rather than returned to the pool.
+        guard let output = try await decoder.decode(frame, timeout: timeout) else {
+            throw VideoFrame.DecodeError.timedOut
+        }
+
+        // Evicted decoders stop their pipelines once released below, outside the lock.
+        var evicted = idle.withLock { idle -> [Decoder] in
+            if idle.decoders[key, default: []].count < maxIdlePerKey {
+                idle.decoders[key, default: []].append(decoder)
+            }
+            idle.recent.removeAll { $0 == key }
+            idle.recent.append(key)
+
+            var evicted: [Decoder] = []
+            while idle.recent.count > maxKeys {
+                let oldest = idle.recent.removeFirst()
+                evicted += idle.decoders.removeValue(forKey: oldest) ?? []
+            }
+            return evicted
+        }
+        evicted.removeAll()
+        return output
+    }
+}
@@ -1,5 +1,6 @@
 import CGStreamer
 import CGStreamerShim
+import Synchronization
 
 /// A video frame with access to pixel data.
 ///
@@ -86,6 +87,12 @@ public struct VideoFrame: @unchecked Sendable {
     /// - `.nv12`: YUV 4:2:0 (common for video codecs)
     /// - `.i420`: YUV 4:2:0 planar
     /// - `.gray8`: 8-bit grayscale
+    /// - `.yuy2`, `.uyvy`: YUV 4:2:2 packed (USB webcams)
+    /// - `.p010`, `.i420_10le`: 10-bit YUV 4:2:0 (HDR decoders)
+    /// - `.gray16le`: 16-bit grayscale (depth cameras)
+    /// - `.mjpeg`: compressed JPEG frames
+    ///
+    /// Use ``PixelFormat/planes(width:height:)`` to locate each plane in the buffer.
     public let format: PixelFormat
 
     /// The presentation timestamp (PTS) in nanoseconds.
@@ -102,7 +109,7 @@ public struct VideoFrame: @unchecked Sendable {
     /// }
     /// ```
     public var pts: UInt64? {
-        let value = swift_gst_buffer_get_pts(storage.buffer)
+        let value = storage.withBuffer { swift_gst_buffer_get_pts($0) }
         return swift_gst_clock_time_is_valid(value) != 0 ? UInt64(value) : nil
     }
 
@@ -112,7 +119,7 @@ public struct VideoFrame: @unchecked Sendable {
     /// DTS equals PTS. For formats with B-frames, DTS may differ.
     /// Returns `nil` if not set.
     public var dts: UInt64? {
-        let value = swift_gst_buffer_get_dts(storage.buffer)
+        let value = storage.withBuffer { swift_gst_buffer_get_dts($0) }
         return swift_gst_clock_time_is_valid(value) != 0 ? UInt64(value) : nil
     }
 
@@ -129,28 +136,131 @@ public struct VideoFrame: @unchecked Sendable {
     /// }
     /// ```
     public var duration: UInt64? {
-        let value = swift_gst_buffer_get_duration(storage.buffer)
+        let value = storage.withBuffer { swift_gst_buffer_get_duration($0) }
         return swift_gst_clock_time_is_valid(value) != 0 ? UInt64(value) : nil
     }
 
     /// Storage class to manage the buffer lifecycle.
-    private final class Storage: @unchecked Sendable {
-        let buffer: UnsafeMutablePointer<GstBuffer>
+    ///
+    /// The buffer can be swapped for a copy while the frame is alive (see
+    /// ``AppSink/setDetachPolicy(_:)``), so every access goes through
+    /// ``beginAccess(writing:)``: a buffer is never replaced while in use.
+    internal final class Storage: @unchecked Sendable {
+        private struct State {
+            var buffer: UnsafeMutablePointer<GstBuffer>
+            var readers = 0
+            /// Bumped by every write access, so a copy taken before a write is discarded.
+            var writes = 0
+            /// Handed out as a raw pointer; can no longer be swapped.
+            var pinned = false
+            var detached = false
+        }
+
+        private let state: Mutex<State>
         let ownsReference: Bool
 
-        init(buffer: UnsafeMutablePointer<GstBuffer>, ownsReference: Bool) {
-            self.buffer = buffer
+        init(buffer: UnsafeMutablePointer<GstBuffer>, ownsReference: Bool, detached: Bool = false) {
+            self.state = Mutex(State(buffer: buffer, detached: detached))
             self.ownsReference = ownsReference
         }
 
         deinit {
-            if ownsReference {
+            let (buffer, detached) = state.withLock { ($0.buffer, $0.detached) }
+            // A swapped-in copy is always ours.
+            if ownsReference || detached {
                 swift_gst_buffer_unref(buffer)
             }
         }
+
+        func beginAccess(writing: Bool) -> UnsafeMutablePointer<GstBuffer> {
+            state.withLock {
+                $0.readers += 1
+                if writing { $0.writes += 1 }
+                return $0.buffer
+            }
+        }
+
+        func endAccess() {
+            state.withLock { $0.readers -= 1 }
+        }
+
+        func withBuffer<R>(_ body: (UnsafeMutablePointer<GstBuffer>) throws -> R) rethrows -> R {
+            let buffer = beginAccess(writing: false)
+            defer { endAccess() }
+            return try body(buffer)
+        }
+
+        /// The buffer, which stays this frame's for the rest of its life.
+        var pinnedBuffer: UnsafeMutablePointer<GstBuffer> {
+            state.withLock {
+                $0.pinned = true
+                return $0.buffer
+            }
+        }
+
+        /// Whether the frame no longer references the buffer it was created with.
+        var isDetached: Bool {
+            state.withLock { $0.detached }
+        }
+
+        enum DetachResult {
+            case detached(bytes: Int)
+            /// In use, pinned or already detached; nothing was copied.
+            case skipped
+            /// The copy couldn't be allocated.
+            case failed
+        }
+
+        /// Swap the buffer for a copy from `allocator`, releasing the original.
+        func detach(allocator: BufferAllocator?) -> DetachResult {
+            let (buffer, writes, eligible) = state.withLock {
+                ($0.buffer, $0.writes, !$0.pinned && !$0.detached && $0.readers == 0)
+            }
+            guard eligible else { return .skipped }
+
+            let copy = withExtendedLifetime(allocator) {
+                withBuffer { swift_gst_buffer_copy_deep_with($0, allocator?.allocator) }
+            }
+            guard let copy else { return .failed }
+
+            let original = state.withLock { state -> UnsafeMutablePointer<GstBuffer>? in
+                guard state.readers == 0, !state.pinned, !state.detached, state.writes == writes else {
+                    return nil
+                }
+                state.buffer = copy
+                state.detached = true
+                return buffer
+            }
+            guard let original else {
+                swift_gst_buffer_unref(copy)
+                return .skipped
+            }
+            if ownsReference {
+                swift_gst_buffer_unref(original)
+            }
+            return .detached(bytes: Int(swift_gst_buffer_get_size(copy)))
+        }
+    }
+
+    internal let storage: Storage
+
+    /// The underlying GstBuffer, valid while the frame is alive.
+    ///
+    /// A frame whose pointer has been taken is never detached automatically;
+    /// prefer ``withBuffer(_:)`` for short uses.
+    internal var buffer: UnsafeMutablePointer<GstBuffer> {
+        storage.pinnedBuffer
     }
 
-    private let storage: Storage
+    /// Use the underlying GstBuffer without pinning it to the frame.
+    internal func withBuffer<R>(_ body: (UnsafeMutablePointer<GstBuffer>) throws -> R) rethrows -> R {
+        try storage.withBuffer(body)
+    }
+
+    /// A new reference to the underlying GstBuffer, for uses that outlive an access.
+    internal func bufferReference() -> Buffer {
+        withBuffer { Buffer(buffer: swift_gst_buffer_ref($0), ownsReference: true) }
+    }
 
     /// Create a VideoFrame from a GstBuffer and video info.
     internal init(
@@ -158,14 +268,80 @@ public struct VideoFrame: @unchecked Sendable {
         width: Int,
         height: Int,
         format: PixelFormat,
-        ownsReference: Bool
+        ownsReference: Bool,
+        detached: Bool = false
     ) {
-        self.storage = Storage(buffer: buffer, ownsReference: ownsReference)
+        self.storage = Storage(buffer: buffer, ownsReference: ownsReference, detached: detached)
         self.width = width
         self.height = height
         self.format = format
     }
 
+    /// Wrap a sample's buffer, reading dimensions and format from its caps.
+    ///
+    /// The sample is borrowed; the frame takes its own reference on the buffer.
+    internal init?(sample: OpaquePointer) {
+        guard let buffer = swift_gst_sample_get_buffer(UnsafeMutableRawPointer(sample)),
+            let caps = swift_gst_sample_get_caps(UnsafeMutableRawPointer(sample)),
+            let info = VideoInfo(caps: caps)
+        else {
+            return nil
+        }
+
+        self.init(
+            buffer: swift_gst_buffer_ref(buffer),
+            width: info.width,
+            height: info.height,
+            format: info.format,
+            ownsReference: true
+        )
+    }
+
+    // MARK: - Detaching
+
+    /// Whether the frame holds its own copy rather than the upstream buffer.
+    ///
+    /// Frames from an ``AppSink`` reference the buffer the upstream element
+    /// produced, which usually belongs to a small pool. A detached frame
+    /// has been copied, and the upstream buffer has gone back to its pool.
+    public var isDetached: Bool {
+        storage.isDetached
+    }
+
+    /// A copy of this frame that no longer references the upstream buffer.
+    ///
+    /// Cameras and decoders allocate from pools of typically 4 to 8 buffers,
+    /// and every frame the application holds keeps one of them out of the
+    /// pool; when all of them are held, capture stalls. Detach frames that
+    /// are kept for more than a moment, such as a tracking window or the
+    /// frames of a clip being assembled, and let the original go.
+    ///
+    /// ```swift
+    /// let arena = FrameArena(capacity: 64 * 1920 * 1080 * 4)
+    /// for await frame in sink.frames() {
+    ///     window.append(try frame.detached(into: arena))
+    ///     if window.count > 60 { window.removeFirst() }
+    /// }
+    /// ```
+    ///
+    /// Timestamps, flags and video metadata are copied along with the pixels.
+    /// To have an ``AppSink`` do this for frames held past a deadline, use
+    /// ``AppSink/setDetachPolicy(_:)``.
+    ///
+    /// - Parameter arena: Recycles the memory of released copies, or `nil`
+    ///   to use the system allocator.
+    /// - Returns: The copied frame.
+    /// - Throws: ``GStreamerError/bufferMapFailed`` if the copy can't be allocated.
+    public func detached(into arena: FrameArena? = nil) throws -> VideoFrame {
+        let copy = withExtendedLifetime(arena) {
+            withBuffer { swift_gst_buffer_copy_deep_with($0, arena?.allocator.allocator) }
+        }
+        guard let copy else {
+            throw GStreamerError.bufferMapFailed
+        }
+        return VideoFrame(buffer: copy, width: width, height: height, format: format, ownsReference: true, detached: true)
+    }
+
     // MARK: - Pixel Data Access
 
     /// The frame's pixel data as a read-only span.
@@ -187,11 +363,13 @@ public struct VideoFrame: @unchecked Sendable {
     /// ```
     public var bytes: RawSpan {
         _read {
+            let buffer = storage.beginAccess(writing: false)
+            defer { storage.endAccess() }
             var mapInfo = GstMapInfo()
-            guard swift_gst_buffer_map_read(storage.buffer, &mapInfo) != 0 else {
+            guard swift_gst_buffer_map_read(buffer, &mapInfo) != 0 else {
                 fatalError("Failed to map buffer for reading")
             }
-            defer { swift_gst_buffer_unmap(storage.buffer, &mapInfo) }
+            defer { swift_gst_buffer_unmap(buffer, &mapInfo) }
             yield RawSpan(_unsafeStart: mapInfo.data, byteCount: Int(mapInfo.size))
         }
     }
@@ -215,11 +393,13 @@ public struct VideoFrame: @unchecked Sendable {
             fatalError("Cannot read mutableBytes")
         }
         _modify {
+            let buffer = storage.beginAccess(writing: true)
+            defer { storage.endAccess() }
             var mapInfo = GstMapInfo()
-            guard swift_gst_buffer_map_write(storage.buffer, &mapInfo) != 0 else {
+            guard swift_gst_buffer_map_write(buffer, &mapInfo) != 0 else {
                 fatalError("Failed to map buffer for writing")
             }
-            defer { swift_gst_buffer_unmap(storage.buffer, &mapInfo) }
+            defer { swift_gst_buffer_unmap(buffer, &mapInfo) }
             var span = MutableRawSpan(_unsafeStart: mapInfo.data, byteCount: Int(mapInfo.size))
             yield &span
         }
@@ -234,12 +414,14 @@ public struct VideoFrame: @unchecked Sendable {
     /// - Returns: The value returned by the closure.
     /// - Throws: ``GStreamerError/bufferMapFailed`` if mapping fails.
     public func withUnsafeBytes<R>(_ body: (UnsafeRawBufferPointer) throws -> R) throws -> R {
+        let buffer = storage.beginAccess(writing: false)
+        defer { storage.endAccess() }
         var mapInfo = GstMapInfo()
-        guard swift_gst_buffer_map_read(storage.buffer, &mapInfo) != 0 else {
+        guard swift_gst_buffer_map_read(buffer, &mapInfo) != 0 else {
             throw GStreamerError.bufferMapFailed
         }
         defer {
-            swift_gst_buffer_unmap(storage.buffer, &mapInfo)
+            swift_gst_buffer_unmap(buffer, &mapInfo)
         }
 
         let ptr = UnsafeRawBufferPointer(start: mapInfo.data, count: Int(mapInfo.size))
@@ -255,12 +437,14 @@ public struct VideoFrame: @unchecked Sendable {
     /// - Returns: The value returned by the closure.
     /// - Throws: ``GStreamerError/bufferMapFailed`` if mapping fails.
     public func withUnsafeMutableBytes<R>(_ body: (UnsafeMutableRawBufferPointer) throws -> R) throws -> R {
+        let buffer = storage.beginAccess(writing: true)
+        defer { storage.endAccess() }
         var mapInfo = GstMapInfo()
-        guard swift_gst_buffer_map_write(storage.buffer, &mapInfo) != 0 else {
+        guard swift_gst_buffer_map_write(buffer, &mapInfo) != 0 else {
             throw GStreamerError.bufferMapFailed
         }
         defer {
-            swift_gst_buffer_unmap(storage.buffer, &mapInfo)
+            swift_gst_buffer_unmap(buffer, &mapInfo)
         }
 
         let ptr = UnsafeMutableRawBufferPointer(start: mapInfo.data, count: Int(mapInfo.size))
@@ -283,3 +467,32 @@ extension VideoFrame: CustomStringConvertible {
         return result
     }
 }
+
+/// Dimensions and pixel format read from video caps.
+internal struct VideoInfo: Sendable {
+    var width: Int = 0
+    var height: Int = 0
+    var format: PixelFormat = .unknown("")
+
+    init() {}
+
+    /// Read the first structure of `caps`, or `nil` if the caps are empty.
+    ///
+    /// Missing fields are left at zero, which callers treat as unknown.
+    init?(caps: UnsafeMutablePointer<GstCaps>) {
+        guard let structure = gst_caps_get_structure(caps, 0) else { return nil }
+
+        var width: gint = 0
+        var height: gint = 0
+        _ = gst_structure_get_int(structure, "width", &width)
+        _ = gst_structure_get_int(structure, "height", &height)
+        self.width = Int(width)
+        self.height = Int(height)
+
+        if GLibString.borrow(gst_structure_get_name(structure)) == PixelFormat.mjpeg.mediaType {
+            format = .mjpeg
+        } else {
+            format = PixelFormat(string: GLibString.borrow(gst_structure_get_string(structure, "format")) ?? "")
+        }
+    }
+}
@@ -99,6 +99,12 @@ public final class VideoSource: @unchecked Sendable {
     case raw
     case jpeg(quality: Int)
     case h264(bitrate: Int)
+    /// The camera's own MJPEG stream, delivered without decoding.
+    ///
+    /// Frames have format ``PixelFormat/mjpeg``; call
+    /// ``VideoFrame/decode(width:height:format:timeout:)`` on the ones you
+    /// need as pixels.
+    case mjpeg
   }
 
   /// Errors that can occur when building a video source.
@@ -163,22 +169,54 @@ public final class VideoSource: @unchecked Sendable {
 
   /// An async sequence of video frames from this source.
   ///
-  /// When encoding is `.raw`, frames contain raw pixel data (typically BGRA).
-  /// For encoded outputs (`.jpeg`, `.h264`), frames contain encoded bytes and
-  /// the frame format will be `.unknown`.
+  /// When encoding is `.raw`, frames contain raw pixel data in one of the
+  /// builder's accepted formats (BGRA by default); check `frame.format`.
+  /// For `.jpeg` and `.mjpeg`, frames contain JPEG bytes and the frame format
+  /// is `.mjpeg`. For `.h264`, frames contain encoded bytes and the frame
+  /// format will be `.unknown`; use ``encodedFrames()`` instead.
   public func frames() -> AppSink.Frames {
     sink.frames()
   }
 
+  /// An async sequence of encoded frames from this source.
+  ///
+  /// Use with `.h264` encoding: each frame carries the stream's caps and
+  /// its NAL units, located once, instead of the raw-video assumptions of
+  /// ``frames()``.
+  public func encodedFrames() -> AppSink.EncodedFrames {
+    sink.encodedFrames()
+  }
+
+  /// The most recent frame, fetched on request.
+  ///
+  /// Use this instead of ``frames()`` when frames are only needed
+  /// occasionally (e.g. a dashboard preview); nothing runs in Swift between
+  /// calls.
+  public func latestFrame() -> VideoFrame? {
+    sink.latestFrame()
+  }
+
+  /// Watch this source for stalls and restart the capture when frames stop.
+  ///
+  /// Keep the returned ``Watchdog`` alive for as long as the source should
+  /// be watched. ``frames()`` keeps yielding across recoveries.
+  ///
+  /// - Parameter configuration: Stall detection and recovery settings.
+  public func watchdog(_ configuration: Watchdog.Configuration = Watchdog.Configuration()) throws -> Watchdog {
+    try Watchdog(pipeline: pipeline, configuration: configuration)
+  }
+
   /// Stop the underlying pipeline.
   public func stop() async {
     pipeline.stop()
   }
 
+  /// Device monitor shared by device discovery and every builder.
+  internal static let deviceMonitor = DeviceMonitor()
+
   /// Discover available webcams on the system.
   public static func availableWebcams() throws -> [WebcamInfo] {
-    let monitor = DeviceMonitor()
-    let devices = monitor.videoSources()
+    let devices = deviceMonitor.videoSources()
 
     return devices.enumerated().map { index, device in
       let uniqueID = VideoSource.uniqueID(for: device, index: index)
@@ -233,8 +271,7 @@ public final class VideoSource: @unchecked Sendable {
   private static func resolveDeviceSelection(forName name: String) throws
     -> VideoSourceBuilder.DeviceSelection
   {
-    let monitor = DeviceMonitor()
-    let devices = monitor.videoSources()
+    let devices = deviceMonitor.videoSources()
     let normalized = name.lowercased()
 
     for (index, device) in devices.enumerated() {
@@ -339,6 +376,7 @@ public struct VideoSourceBuilder: Sendable {
   private var cropIfNeeded: Bool = false
   private var encoding: VideoSource.Encoding = .raw
   private var preferHardwareAcceleration: Bool = false
+  private var acceptedFormats: [PixelFormat] = [.bgra]
 
   fileprivate init(selection: DeviceSelection) {
     self.selection = selection
@@ -390,6 +428,35 @@ public struct VideoSourceBuilder: Sendable {
     withEncoding(.h264(bitrate: bitrate))
   }
 
+  /// Deliver the camera's MJPEG frames without decoding them.
+  public func withMJPEGCapture() -> VideoSourceBuilder {
+    withEncoding(.mjpeg)
+  }
+
+  /// Accept raw frames in any of these pixel formats, in order of preference.
+  ///
+  /// When the source natively produces one of the formats at the requested
+  /// size and framerate, frames are delivered without `videoconvert`,
+  /// `videoscale` or `videorate`. Only the elements that actually change
+  /// something are inserted otherwise. Defaults to `[.bgra]`.
+  ///
+  /// Only raw formats are accepted; ``build()`` rejects ``PixelFormat/mjpeg``
+  /// and ``PixelFormat/unknown(_:)``. Use ``withEncoding(_:)`` with `.mjpeg`
+  /// to receive the camera's JPEG frames.
+  ///
+  /// ```swift
+  /// // Take whatever the camera produces natively if it's a YUV format we handle
+  /// let source = try VideoSource.webcam()
+  ///     .withResolution(.hd720p)
+  ///     .withAcceptedFormats([.nv12, .i420, .bgra])
+  ///     .build()
+  /// ```
+  public func withAcceptedFormats(_ formats: [PixelFormat]) -> VideoSourceBuilder {
+    var copy = self
+    copy.acceptedFormats = formats
+    return copy
+  }
+
   /// Prefer hardware-accelerated encoders when available.
   public func preferHardwareAcceleration(_ prefer: Bool = true) -> VideoSourceBuilder {
     var copy = self
@@ -414,14 +481,65 @@ public struct VideoSourceBuilder: Sendable {
       throw VideoSource.VideoSourceError.invalidConfiguration("H.264 bitrate must be positive")
     }
 
+    if encoding == .raw, acceptedFormats.isEmpty {
+      throw VideoSource.VideoSourceError.invalidConfiguration("At least one pixel format must be accepted")
+    }
+
+    if let format = acceptedFormats.first(where: { format in
+      if case .unknown = format { return true }
+      return format.isCompressed
+    }) {
+      throw VideoSource.VideoSourceError.invalidConfiguration(
+        "Accepted formats must be raw pixel formats, not \(format); use withEncoding(.mjpeg) for MJPEG capture")
+    }
+
+    if encoding == .mjpeg, let aspectRatio, aspectRatio != .original {
+      throw VideoSource.VideoSourceError.invalidConfiguration(
+        "Aspect ratio adjustment requires decoding; not available with MJPEG capture")
+    }
+
     let sinkName = "sink\(UInt32.random(in: 0...UInt32.max))"
 
     let sourceCandidates = try resolveSourceCandidates()
+
+    if encoding == .mjpeg {
+      return try buildMJPEG(sourceCandidates: sourceCandidates, sinkName: sinkName)
+    }
+
     let encoderCandidates = resolveEncoderCandidates()
     let aspectModes = resolveAspectModes()
 
     var diagnostics: [String] = []
 
+    // Pre-flight: intersect source, requested and consumer caps offline and
+    // start only the cheapest chain. Trial-and-error below is the fallback.
+    if let source = sourceCandidates.first, let aspectMode = aspectModes.first,
+      let negotiated = negotiateChain(
+        encoderCandidates: encoderCandidates,
+        aspectMode: aspectMode,
+        diagnostics: &diagnostics
+      )
+    {
+      let description = buildPipelineDescription(
+        source: source,
+        aspectMode: aspectMode,
+        encoder: negotiated.encoder,
+        sinkName: sinkName,
+        plan: negotiated.plan
+      )
+
+      do {
+        return try start(
+          description: description,
+          sinkName: sinkName,
+          sourceCaps: negotiated.plan.sourceCaps,
+          diagnostics: diagnostics
+        )
+      } catch {
+        diagnostics.append("Failed: \(description) -> \(error)")
+      }
+    }
+
     for source in sourceCandidates {
       for aspectMode in aspectModes {
         for encoder in encoderCandidates {
@@ -429,24 +547,16 @@ public struct VideoSourceBuilder: Sendable {
             source: source,
             aspectMode: aspectMode,
             encoder: encoder,
-            sinkName: sinkName
+            sinkName: sinkName,
+            plan: .fullChain
           )
 
           do {
-            let pipeline = try Pipeline(description)
-            let sink = try pipeline.appSink(named: sinkName)
-            do {
-              try pipeline.play()
-            } catch {
-              pipeline.stop()
-              throw error
-            }
-            return VideoSource(
-              pipeline: pipeline,
-              sink: sink,
-              pipelineDescription: description,
-              diagnostics: diagnostics,
-              encoding: encoding
+            return try start(
+              description: description,
+              sinkName: sinkName,
+              sourceCaps: nil,
+              diagnostics: diagnostics
             )
           } catch {
             diagnostics.append("Failed: \(description) -> \(error)")
@@ -459,6 +569,125 @@ public struct VideoSourceBuilder: Sendable {
     throw VideoSource.VideoSourceError.noWorkingPipeline(diagnostics)
   }
 
+  /// Start a pass-through pipeline that delivers the source's MJPEG frames.
+  ///
+  /// No decoder, converter, scaler or rate adapter is inserted, so the
+  /// requested size and framerate must be a mode the camera produces as
+  /// MJPEG.
+  private func buildMJPEG(sourceCandidates: [String], sinkName: String) throws -> VideoSource {
+    var diagnostics: [String] = []
+
+    if let available = sourceCapabilities(), buildCaps().intersect(available).isEmpty {
+      diagnostics.append("Pre-flight: source has no MJPEG mode matching the requested size and framerate")
+      throw VideoSource.VideoSourceError.noWorkingPipeline(diagnostics)
+    }
+
+    for source in sourceCandidates {
+      let description = [
+        source,
+        "capsfilter name=\(sinkName)_caps",
+        "appsink name=\(sinkName) sync=false drop=true max-buffers=1 emit-signals=true enable-last-sample=true",
+      ].joined(separator: " ! ")
+
+      do {
+        return try start(
+          description: description,
+          sinkName: sinkName,
+          sourceCaps: nil,
+          diagnostics: diagnostics
+        )
+      } catch {
+        diagnostics.append("Failed: \(description) -> \(error)")
+      }
+    }
+
+    throw VideoSource.VideoSourceError.noWorkingPipeline(diagnostics)
+  }
+
+  private func start(
+    description: String,
+    sinkName: String,
+    sourceCaps: Caps?,
+    diagnostics: [String]
+  ) throws -> VideoSource {
+    let pipeline = try Pipeline(description)
+    if let sourceCaps {
+      pipeline.element(named: "\(sinkName)_src")?.set("caps", sourceCaps)
+    }
+    pipeline.element(named: "\(sinkName)_caps")?.set("caps", buildCaps())
+    let sink = try pipeline.appSink(named: sinkName)
+    do {
+      try pipeline.play()
+    } catch {
+      pipeline.stop()
+      throw error
+    }
+    return VideoSource(
+      pipeline: pipeline,
+      sink: sink,
+      pipelineDescription: description,
+      diagnostics: diagnostics,
+      encoding: encoding
+    )
+  }
+
+  /// Choose an encoder and the minimal conversion chain without starting anything.
+  private func negotiateChain(
+    encoderCandidates: [String?],
+    aspectMode: AspectMode,
+    diagnostics: inout [String]
+  ) -> (plan: VideoCapsNegotiator.Plan, encoder: String?)? {
+    guard let available = sourceCapabilities() else {
+      diagnostics.append("Pre-flight: source capabilities unavailable")
+      return nil
+    }
+
+    for encoder in encoderCandidates {
+      var consumerCaps: Caps?
+      if let encoder {
+        let factory = String(encoder.prefix { $0 != " " })
+        guard Element.isAvailable(factory: factory) else {
+          diagnostics.append("Pre-flight: \(factory) not installed")
+          continue
+        }
+        consumerCaps = (try? Element.make(factory: factory))?.staticPad("sink")?.queryCaps()
+      }
+
+      let negotiator = VideoCapsNegotiator(
+        available: available,
+        size: resolution?.size,
+        framerate: framerate,
+        formats: encoder == nil ? acceptedFormats : [],
+        consumerCaps: consumerCaps,
+        requiresScale: aspectMode != .none
+      )
+      if let plan = negotiator.negotiate() {
+        return (plan, encoder)
+      }
+      diagnostics.append("Pre-flight: no caps intersection for \(encoder ?? "raw output")")
+    }
+
+    return nil
+  }
+
+  /// Caps the selected source can produce, queried without a pipeline.
+  private func sourceCapabilities() -> Caps? {
+    switch selection {
+    case .deviceIndex(let index):
+      let devices = VideoSource.deviceMonitor.videoSources()
+      guard devices.indices.contains(index) else { return nil }
+      return devices[index].supportedCaps
+
+    case .devicePath(let path):
+      return VideoSource.deviceMonitor.videoSources().first {
+        $0.property("device.path") == path || $0.property("api.v4l2.path") == path
+      }?.supportedCaps
+
+    case .testPattern:
+      return (try? Element.make(factory: "videotestsrc"))?.staticPad("src")?.queryCaps()
+    }
+  }
+
   private func resolveSourceCandidates() throws -> [String] {
     switch selection {
     case .deviceIndex(let index):
@@ -506,6 +735,10 @@ public struct VideoSourceBuilder: Sendable {
       encoders.append("jpegenc quality=\(clampedQuality)")
       return encoders.map { Optional($0) }
 
+    case .mjpeg:
+      // Handled by buildMJPEG; no encoder is ever inserted.
+      return [nil]
+
     case .h264(let bitrate):
       var encoders: [String] = []
       if preferHardwareAcceleration {
@@ -536,43 +769,54 @@ public struct VideoSourceBuilder: Sendable {
     source: String,
     aspectMode: AspectMode,
     encoder: String?,
-    sinkName: String
+    sinkName: String,
+    plan: VideoCapsNegotiator.Plan
   ) -> String {
-    var parts: [String] = [source, "videoconvert"]
+    var parts: [String] = [source]
+
+    if plan.sourceCaps != nil {
+      parts.append("capsfilter name=\(sinkName)_src")
+    }
+
+    if plan.needsConvert {
+      parts.append("videoconvert")
+    }
 
     if let aspectRatio, let ratioString = aspectRatio.ratioString, aspectMode == .crop {
       parts.append("aspectratiocrop aspect-ratio=\(ratioString)")
     }
 
-    var videoscale = "videoscale"
-    if aspectMode == .letterbox {
-      videoscale += " add-borders=true"
+    if plan.needsScale {
+      var videoscale = "videoscale"
+      if aspectMode == .letterbox {
+        videoscale += " add-borders=true"
+      }
+      parts.append(videoscale)
     }
-    parts.append(videoscale)
 
-    if let framerate, framerate > 0 {
+    if plan.needsRate, let framerate, framerate > 0 {
       parts.append("videorate")
     }
 
-    let caps = buildCaps()
-    if !caps.isEmpty {
-      parts.append(caps)
-    }
+    // Caps are set on the filter as a GstCaps after parsing rather than
+    // being printed into the description and parsed again.
+    parts.append("capsfilter name=\(sinkName)_caps")
 
     if let encoder {
       parts.append(encoder)
     }
 
-    parts.append("appsink name=\(sinkName) sync=false drop=true max-buffers=1 emit-signals=true")
+    parts.append("appsink name=\(sinkName) sync=false drop=true max-buffers=1 emit-signals=true enable-last-sample=true")
 
     return parts.joined(separator: " ! ")
   }
 
-  private func buildCaps() -> String {
-    var builder = CapsBuilder.video()
+  private func buildCaps() -> Caps {
+    var builder =
+      encoding == .mjpeg ? CapsBuilder(mediaType: PixelFormat.mjpeg.mediaType) : CapsBuilder.video()
 
     if encoding == .raw {
-      builder = builder.format(.bgra)
+      builder = builder.formats(acceptedFormats)
     }
 
     if let resolution {
@@ -584,7 +828,7 @@ public struct VideoSourceBuilder: Sendable {
       builder = builder.framerate(framerate, 1)
     }
 
-    return builder.build()
+    return builder.buildCaps()
   }
 }
 
@@ -0,0 +1,366 @@
+import CGStreamer
+import CGStreamerShim
+import Synchronization
+
+/// Detects stalled pipelines and restarts them.
+///
+/// A camera that drops off the network rarely posts an error: buffers just
+/// stop arriving, and a consumer iterating ``AppSink/frames()`` waits
+/// forever. A watchdog counts the buffers passing the pipeline's sink and
+/// any pads you choose. When none has moved for longer than the deadline
+/// while the pipeline is PLAYING, it recovers:
+///
+/// 1. The source element alone is restarted, which only reconnects the
+///    device or stream and leaves everything downstream, including the
+///    sink your consumer holds, untouched. This takes milliseconds.
+/// 2. If that doesn't bring buffers back, or the source can't be restarted
+///    on its own, the whole pipeline is restarted.
+///
+/// Further attempts wait with exponential backoff. If ``Configuration/maxAttempts``
+/// is reached the pipeline is stopped, so frame iterators finish instead of
+/// waiting on a dead stream.
+///
+/// ## Example
+///
+/// ```swift
+/// let pipeline = try Pipeline("""
+///     rtspsrc location=rtsp://camera/stream ! decodebin ! videoconvert ! \
+///     appsink name=sink
+///     """)
+/// let sink = try pipeline.appSink(named: "sink")
+/// let watchdog = try Watchdog(pipeline: pipeline, configuration: .init(deadline: .seconds(1)))
+/// try pipeline.play()
+///
+/// Task {
+///     for await event in watchdog.events {
+///         print(event)
+///     }
+/// }
+/// for try await frame in sink.frames() {
+///     process(frame)
+/// }
+/// ```
+///
+/// Pipelines whose source has sometimes pads, such as `rtspsrc` or
+/// `uridecodebin`, are restarted as a whole unless a source element with a
+/// static `src` pad, or a bin wrapping the source with a ghost `src` pad,
+/// is named with `source`.
+public final class Watchdog: Sendable {
+    /// Stall detection and recovery settings.
+    public struct Configuration: Sendable, Hashable {
+        /// How long no buffer may pass while PLAYING before recovering.
+        public var deadline: Duration
+        /// Delay before the second recovery attempt; doubled for each one after.
+        public var initialBackoff: Duration
+        /// Longest delay between attempts.
+        public var maxBackoff: Duration
+        /// Attempts before giving up and stopping the pipeline, or `nil` to
+        /// keep trying.
+        public var maxAttempts: Int?
+        /// Maximum time to wait for each state change during recovery.
+        public var timeout: Duration
+
+        public init(
+            deadline: Duration = .seconds(2),
+            initialBackoff: Duration = .milliseconds(100),
+            maxBackoff: Duration = .seconds(10),
+            maxAttempts: Int? = nil,
+            timeout: Duration = .seconds(5)
+        ) {
+            self.deadline = deadline
+            self.initialBackoff = initialBackoff
+            self.maxBackoff = maxBackoff
+            self.maxAttempts = maxAttempts
+            self.timeout = timeout
+        }
+    }
+
+    /// How a recovery attempt restarts the pipeline.
+    public enum Strategy: Sendable, Hashable {
+        /// Only the named source element was restarted.
+        case restartSource(String)
+        /// The whole pipeline was stopped and started again.
+        case restartPipeline
+    }
+
+    /// Something the watchdog noticed or did.
+    public enum Event: Sendable, Hashable, CustomStringConvertible {
+        /// No buffer passed any watched pad within the deadline.
+        case stalled(silentFor: Duration)
+        /// A recovery attempt is starting.
+        case recovering(attempt: Int, strategy: Strategy)
+        /// Buffers are flowing again, `elapsed` after the stall was detected.
+        case recovered(attempt: Int, elapsed: Duration)
+        /// Every attempt failed and the pipeline was stopped.
+        case gaveUp(attempts: Int)
+
+        public var description: String {
+            switch self {
+            case .stalled(let silentFor):
+                return "Stalled: no buffers for \(silentFor)"
+            case .recovering(let attempt, .restartSource(let name)):
+                return "Recovery attempt \(attempt): restarting source \(name)"
+            case .recovering(let attempt, .restartPipeline):
+                return "Recovery attempt \(attempt): restarting pipeline"
+            case .recovered(let attempt, let elapsed):
+                return "Recovered after \(attempt) attempt(s) in \(elapsed)"
+            case .gaveUp(let attempts):
+                return "Gave up after \(attempts) attempt(s)"
+            }
+        }
+    }
+
+    /// Buffer counters on the watched pads.
+    private final class Monitors: @unchecked Sendable {
+        let monitors: [OpaquePointer]
+
+        init(_ monitors: [OpaquePointer]) {
+            self.monitors = monitors
+        }
+
+        deinit {
+            monitors.forEach { swift_gst_flow_monitor_free($0) }
+        }
+
+        /// Sum of buffers seen on every pad.
+        var buffers: UInt {
+            monitors.reduce(0) { $0 &+ UInt(swift_gst_flow_monitor_buffers($1)) }
+        }
+
+        /// Whether every pad has seen EOS, so silence is expected.
+        var isEOS: Bool {
+            monitors.allSatisfy { swift_gst_flow_monitor_is_eos($0) != 0 }
+        }
+    }
+
+    private struct Status {
+        var isStalled = false
+        var recoveries = 0
+    }
+
+    /// The pipeline being watched.
+    public let pipeline: Pipeline
+
+    /// Stall detection and recovery settings.
+    public let configuration: Configuration
+
+    /// Stalls and recoveries as they happen. Intended for a single consumer.
+    public let events: AsyncStream<Event>
+
+    private let continuation: AsyncStream<Event>.Continuation
+    private let monitors: Monitors
+    private let source: Element?
+    private let status = Mutex(Status())
+    private let task = Mutex<Task<Void, Never>?>(nil)
+
+    /// Start watching a pipeline.
+    ///
+    /// - Parameters:
+    ///   - pipeline: The pipeline to watch.
+    ///   - pads: Pads to watch in addition to the pipeline's first sink.
+    ///   - source: Name of the element to restart first when the pipeline
+    ///     stalls, or `nil` to use the pipeline's first source element.
+    ///   - configuration: Stall detection and recovery settings.
+    /// - Throws: ``GStreamerError/elementNotFound(_:)`` if `source` names
+    ///   no element, or if there is nothing to watch.
+    public init(
+        pipeline: Pipeline,
+        pads: [Pad] = [],
+        source: String? = nil,
+        configuration: Configuration = Configuration()
+    ) throws {
+        var watched: [OpaquePointer?] = pads.map { swift_gst_pad_monitor_flow($0.pad) }
+        if let sink = swift_gst_bin_find_sink(pipeline._element) {
+            if let pad = gst_element_get_static_pad(sink, "sink") {
+                watched.append(swift_gst_pad_monitor_flow(pad))
+                swift_gst_pad_unref(pad)
+            }
+            swift_gst_object_unref(sink)
+        }
+        let monitors = Monitors(watched.compactMap { $0 })
+        guard !monitors.monitors.isEmpty else {
+            throw GStreamerError.elementNotFound("sink")
+        }
+        self.monitors = monitors
+
+        if let source {
+            guard let element = pipeline.element(named: source) else {
+                throw GStreamerError.elementNotFound(source)
+            }
+            self.source = element
+        } else {
+            self.source = swift_gst_bin_find_source(pipeline._element).map { Element(element: $0) }
+        }
+
+        self.pipeline = pipeline
+        self.configuration = configuration
+        (events, continuation) = AsyncStream.makeStream(bufferingPolicy: .bufferingNewest(16))
+
+        task.withLock {
+            $0 = Task { [weak self] in
+                guard var phase = self?.initialPhase() else { return }
+                while !Task.isCancelled {
+                    // Only hold the watchdog while stepping, so that dropping
+                    // it ends the loop and releases the pipeline.
+                    guard let delay = self?.delay(in: phase) else { return }
+                    try? await Task.sleep(for: delay)
+                    guard !Task.isCancelled, let next = await self?.step(phase) else { break }
+                    phase = next
+                }
+                self?.status.withLock { $0.isStalled = false }
+            }
+        }
+    }
+
+    deinit {
+        task.withLock { $0?.cancel() }
+        continuation.finish()
+    }
+
+    /// Whether the pipeline is stalled and being recovered.
+    public var isStalled: Bool {
+        status.withLock { $0.isStalled }
+    }
+
+    /// Number of stalls recovered so far.
+    public var recoveries: Int {
+        status.withLock { $0.recoveries }
+    }
+
+    /// Stop watching. The pipeline is left as it is.
+    public func cancel() {
+        task.withLock { $0?.cancel() }
+        continuation.finish()
+    }
+
+    // MARK: - Detection
+
+    /// How often buffer counters are sampled.
+    private var tick: Duration {
+        max(configuration.deadline / 4, .milliseconds(10))
+    }
+
+    /// Where the watch loop is. Carried between ticks, so the loop holds no
+    /// reference to the watchdog while it sleeps.
+    private enum Phase {
+        /// Watching for silence; the buffer count last changed at `since`.
+        case watching(count: UInt, since: ContinuousClock.Instant)
+        /// Waiting out the backoff before the next restart.
+        case backingOff(Recovery, until: ContinuousClock.Instant)
+        /// Restarted; waiting for the buffer count to move.
+        case awaitingFlow(Recovery, count: UInt, until: ContinuousClock.Instant)
+    }
+
+    /// Progress through recovering one stall.
+    private struct Recovery {
+        var attempt: Int
+        var backoff: Duration
+        let stall: ContinuousClock.Instant
+    }
+
+    private func initialPhase() -> Phase {
+        .watching(count: monitors.buffers, since: .now)
+    }
+
+    /// How long to sleep before the next step.
+    private func delay(in phase: Phase) -> Duration {
+        guard case .backingOff(_, let until) = phase else { return tick }
+        return max(until - .now, .zero)
+    }
+
+    /// Advance the watch loop by one tick.
+    ///
+    /// - Returns: The next phase, or `nil` once the watchdog gave up.
+    private func step(_ phase: Phase) async -> Phase? {
+        let now = ContinuousClock.now
+        switch phase {
+        case .watching(let count, let since):
+            let current = monitors.buffers
+            // Only silence while PLAYING is a stall.
+            if current != count || monitors.isEOS || pipeline.currentState() != .playing {
+                return .watching(count: current, since: now)
+            }
+            guard now - since >= configuration.deadline else { return phase }
+
+            continuation.yield(.stalled(silentFor: now - since))
+            status.withLock { $0.isStalled = true }
+            let first = Recovery(attempt: 1, backoff: configuration.initialBackoff, stall: now)
+            guard !exhausted(first) else { return await giveUp() }
+            return await attempt(first)
+
+        case .backingOff(let recovery, let until):
+            guard now >= until else { return phase }
+            return await attempt(recovery)
+
+        case .awaitingFlow(let recovery, let count, let until):
+            if monitors.buffers != count {
+                status.withLock {
+                    $0.isStalled = false
+                    $0.recoveries += 1
+                }
+                continuation.yield(.recovered(attempt: recovery.attempt, elapsed: now - recovery.stall))
+                return .watching(count: monitors.buffers, since: now)
+            }
+            guard now >= until else { return phase }
+
+            var next = recovery
+            next.attempt += 1
+            next.backoff = min(recovery.backoff * 2, configuration.maxBackoff)
+            guard !exhausted(next) else { return await giveUp() }
+            return .backingOff(next, until: now + recovery.backoff)
+        }
+    }
+
+    // MARK: - Recovery
+
+    /// Whether `recovery` is past the configured number of attempts.
+    private func exhausted(_ recovery: Recovery) -> Bool {
+        guard let maxAttempts = configuration.maxAttempts else { return false }
+        return recovery.attempt > maxAttempts
+    }
+
+    private func giveUp() async -> Phase? {
+        continuation.yield(.gaveUp(attempts: configuration.maxAttempts ?? 0))
+        status.withLock { $0.isStalled = false }
+        // Ends frame iterators rather than leaving them waiting.
+        await pipeline.stop(timeout: configuration.timeout)
+        continuation.finish()
+        return nil
+    }
+
+    /// Make a restart attempt and start waiting for buffers.
+    private func attempt(_ recovery: Recovery) async -> Phase {
+        let strategy = strategy(for: recovery.attempt)
+        continuation.yield(.recovering(attempt: recovery.attempt, strategy: strategy))
+        await restart(strategy)
+        return .awaitingFlow(recovery, count: monitors.buffers, until: .now + configuration.deadline)
+    }
+
+    /// Restart the source first; escalate to the pipeline if that fails.
+    private func strategy(for attempt: Int) -> Strategy {
+        guard attempt == 1, let source, let pad = source.staticPad("src"), pad.isLinked else {
+            return .restartPipeline
+        }
+        return .restartSource(source.name)
+    }
+
+    internal func restart(_ strategy: Strategy) async {
+        switch strategy {
+        case .restartSource:
+            guard let source else { return }
+            // Tear the source down and bring it back to the pipeline's
+            // state; downstream elements keep running.
+            let target = pipeline.currentState()
+            _ = try? await pipeline.setState(of: source, to: .null, timeout: configuration.timeout)
+            _ = try? await pipeline.setState(of: source, to: target, timeout: configuration.timeout)
+        case .restartPipeline:
+            // READY releases streaming resources without the full teardown
+            // of NULL. App sinks read as end-of-stream until they start
+            // again, so their frame iterators are told to wait it out.
+            pipeline.restarts.begin()
+            defer { pipeline.restarts.end() }
+            _ = try? await pipeline.setState(.ready, timeout: configuration.timeout)
+            try? await pipeline.play(timeout: configuration.timeout)
+        }
+    }
+}
@@ -0,0 +1,105 @@
+import Synchronization
+import Testing
+@testable import GStreamer
+
+@Suite("Buffer Allocator Tests")
+struct BufferAllocatorTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    private static func address(of buffer: Buffer) -> Int {
+        buffer.bytes.withUnsafeBytes { Int(bitPattern: $0.baseAddress) }
+    }
+
+    @Test("Aligned allocators place data on the requested boundary")
+    func aligned() throws {
+        for alignment in [64, 4096] {
+            let allocator = BufferAllocator.aligned(to: alignment)
+            for size in [1, 1000, 1920 * 1080 * 4] {
+                let buffer = try Buffer(size: size, allocator: allocator)
+                #expect(buffer.size == size)
+                #expect(Self.address(of: buffer) % alignment == 0)
+            }
+        }
+    }
+
+    @Test("Memory is accounted until the last buffer is released")
+    func statistics() throws {
+        let allocator = BufferAllocator.aligned(to: 64)
+        do {
+            let buffer = try Buffer(size: 4096, pts: 0, allocator: allocator)
+            #expect(buffer.pts == 0)
+            #expect(allocator.statistics.allocations == 1)
+            #expect(allocator.statistics.bytes >= 4096)
+        }
+        #expect(allocator.statistics.allocations == 0)
+        #expect(allocator.statistics.bytes == 0)
+    }
+
+    @Test("Huge-page buffers are 2 MiB aligned")
+    func hugePages() throws {
+        let allocator = BufferAllocator.hugePages()
+        var buffer = try Buffer(size: 3840 * 2160 * 4, allocator: allocator)
+        #expect(Self.address(of: buffer) % (2 * 1024 * 1024) == 0)
+        #expect(allocator.statistics.bytes % (2 * 1024 * 1024) == 0)
+
+        try buffer.withUnsafeMutableBytes { $0[$0.count - 1] = 7 }
+        #expect(buffer.bytes[buffer.size - 1] == 7)
+    }
+
+    private final class CountingProvider: MemoryProvider {
+        let live = Mutex(0)
+
+        func allocate(byteCount: Int, alignment: Int) -> UnsafeMutableRawPointer? {
+            live.withLock { $0 += 1 }
+            return UnsafeMutableRawPointer.allocate(byteCount: byteCount, alignment: alignment)
+        }
+
+        func deallocate(_ pointer: UnsafeMutableRawPointer, byteCount: Int) {
+            live.withLock { $0 -= 1 }
+            pointer.deallocate()
+        }
+    }
+
+    @Test("Provided memory is returned to the provider")
+    func provider() throws {
+        let provider = CountingProvider()
+        do {
+            let buffer = try {
+                // The memory outlives the allocator.
+                let allocator = BufferAllocator(alignment: 128, provider: provider)
+                return try Buffer(size: 1000, allocator: allocator)
+            }()
+            #expect(provider.live.withLock { $0 } == 1)
+            #expect(Self.address(of: buffer) % 128 == 0)
+            #expect(buffer.size == 1000)
+        }
+        #expect(provider.live.withLock { $0 } == 0)
+    }
+
+    @Test("AppSource copies pushed bytes into its allocator's memory")
+    func appSource() async throws {
+        let pipeline = try Pipeline("appsrc name=src format=time ! appsink name=sink")
+        let src = try AppSource(pipeline: pipeline, name: "src")
+        let sink = try AppSink(pipeline: pipeline, name: "sink")
+        let allocator = BufferAllocator.aligned(to: 4096)
+        src.setCaps("application/x-test")
+        src.setAllocator(allocator)
+        try pipeline.play()
+        defer { pipeline.stop() }
+
+        try src.push(data: [1, 2, 3], pts: 0)
+        var buffer = try Buffer(size: 2, pts: 1, allocator: allocator)
+        try buffer.withUnsafeMutableBytes { $0.copyBytes(from: [4, 5]) }
+        try src.push(buffer)
+        src.endOfStream()
+
+        var sizes: [Int] = []
+        for try await frame in sink.frames() {
+            sizes.append(frame.bytes.byteCount)
+        }
+        #expect(sizes == [3, 2])
+    }
+}
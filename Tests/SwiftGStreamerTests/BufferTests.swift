@@ -0,0 +1,85 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Buffer Tests")
+struct BufferTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    private static func contents(of buffer: Buffer) -> [UInt8] {
+        buffer.bytes.withUnsafeBytes { Array($0) }
+    }
+
+    @Test("Joining buffers shares their memory")
+    func joining() throws {
+        let header = try Buffer(data: [0xAA, 0xBB])
+        let payload = try Buffer(data: [1, 2, 3])
+        let packet = try Buffer(joining: [header, payload])
+
+        #expect(packet.size == 5)
+        #expect(packet.memoryCount == 2)
+        #expect(Self.contents(of: packet) == [0xAA, 0xBB, 1, 2, 3])
+    }
+
+    @Test("Append and prepend add memory blocks in place")
+    func appendPrepend() throws {
+        var buffer = try Buffer(data: [2], pts: 100)
+        try buffer.append(try Buffer(data: [3, 4]))
+        try buffer.prepend(try Buffer(data: [0, 1]))
+
+        #expect(buffer.memoryCount == 3)
+        #expect(Self.contents(of: buffer) == [0, 1, 2, 3, 4])
+        #expect(buffer.pts == 100)
+
+        // Appending a buffer to itself doubles it.
+        try buffer.append(buffer)
+        #expect(Self.contents(of: buffer) == [0, 1, 2, 3, 4, 0, 1, 2, 3, 4])
+    }
+
+    @Test("Slices share memory and copy on write")
+    func slice() throws {
+        let original = try Buffer(data: [0, 1, 2, 3, 4, 5], pts: 7)
+        var slice = try #require(original.slice(offset: 2, size: 3))
+
+        #expect(Self.contents(of: slice) == [2, 3, 4])
+        #expect(slice.pts == 7)
+        #expect(original.slice(offset: 4, size: 3) == nil)
+        #expect(original.slice(offset: -1, size: 1) == nil)
+
+        slice.mutableBytes[0] = 99
+        #expect(Self.contents(of: slice) == [99, 3, 4])
+        #expect(Self.contents(of: original) == [0, 1, 2, 3, 4, 5])
+    }
+
+    @Test("Writability accounts for GStreamer references")
+    func writability() throws {
+        let pipeline = try Pipeline("appsrc name=src ! fakesink")
+        let src = try AppSource(pipeline: pipeline, name: "src")
+        src.setCaps("application/x-test")
+        try pipeline.pause()
+        defer { pipeline.stop() }
+
+        var buffer = try Buffer(data: [1, 2, 3])
+        #expect(buffer.isWritable)
+
+        // The pipeline now holds a reference: queued in appsrc, or kept
+        // by fakesink as its preroll buffer.
+        try src.push(buffer)
+        let pushed = buffer.buffer
+        #expect(!buffer.isWritable)
+
+        buffer.pts = 5
+        #expect(buffer.isWritable)
+        #expect(buffer.buffer != pushed)
+
+        var copy = buffer
+        #expect(!copy.isWritable)
+        try copy.makeWritable()
+        #expect(copy.isWritable)
+        copy.fill(from: [9])
+        #expect(Self.contents(of: buffer) == [1, 2, 3])
+        #expect(Self.contents(of: copy) == [9, 2, 3])
+    }
+}
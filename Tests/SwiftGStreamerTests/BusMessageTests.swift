@@ -87,4 +87,51 @@ struct BusMessageTests {
         pipeline.stop()
         // Note: This test may or may not receive an error depending on GStreamer's behavior
     }
+
+    @Test("Raw messages decode element structures lazily")
+    func rawElementMessage() async throws {
+        let pipeline = try Pipeline(
+            "audiotestsrc num-buffers=10 ! level post-messages=true ! fakesink"
+        )
+
+        try pipeline.play()
+
+        var levelStructure: Structure?
+        for await message in pipeline.bus.rawMessages(filter: [.element, .eos]) {
+            if let structure = message.structure, structure.name == "level" {
+                #expect(message.sourceName != nil)
+                levelStructure = structure
+                break
+            }
+        }
+
+        pipeline.stop()
+
+        let structure = try #require(levelStructure)
+        #expect(structure.has("endtime"))
+        #expect(structure.uint64("endtime") != nil)
+        #expect(structure.int("endtime") == nil)
+        #expect(structure.serializedValue("rms") != nil)
+        #expect(structure.fieldNames.contains("peak"))
+    }
+
+    @Test("Element messages carry their fields")
+    func elementMessageFields() async throws {
+        let pipeline = try Pipeline(
+            "audiotestsrc num-buffers=10 ! level post-messages=true ! fakesink"
+        )
+
+        try pipeline.play()
+
+        var fields: [String: String] = [:]
+        for await message in pipeline.bus.messages(filter: [.element, .eos]) {
+            if case .element(_, let elementFields) = message {
+                fields = elementFields
+                break
+            }
+        }
+
+        pipeline.stop()
+        #expect(fields["endtime"] != nil)
+    }
 }
@@ -102,6 +102,11 @@ struct CVPixelBufferTests {
         #expect(PixelFormat.nv12.cvPixelFormat == kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange)
         #expect(PixelFormat.i420.cvPixelFormat == kCVPixelFormatType_420YpCbCr8Planar)
         #expect(PixelFormat.gray8.cvPixelFormat == kCVPixelFormatType_OneComponent8)
+        #expect(PixelFormat.yuy2.cvPixelFormat == kCVPixelFormatType_422YpCbCr8_yuvs)
+        #expect(PixelFormat.uyvy.cvPixelFormat == kCVPixelFormatType_422YpCbCr8)
+        #expect(PixelFormat.p010.cvPixelFormat == kCVPixelFormatType_420YpCbCr10BiPlanarVideoRange)
+        #expect(PixelFormat.gray16le.cvPixelFormat == kCVPixelFormatType_OneComponent16)
+        #expect(PixelFormat.mjpeg.cvPixelFormat == nil)
     }
 }
 #endif
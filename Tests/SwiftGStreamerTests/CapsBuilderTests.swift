@@ -0,0 +1,81 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Caps Builder Tests")
+struct CapsBuilderTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    @Test("Built caps carry typed fields")
+    func typedFields() throws {
+        let caps = CapsBuilder.video()
+            .format(.bgra)
+            .size(width: 1280, height: 720)
+            .framerate(30, 1)
+            .buildCaps()
+
+        let structure = try #require(caps.structure(at: 0))
+        #expect(structure.name == "video/x-raw")
+        #expect(structure.string("format") == "BGRA")
+        #expect(structure.int("width") == 1280)
+        #expect(structure.int("height") == 720)
+        #expect(structure.fraction("framerate")?.numerator == 30)
+        #expect(caps.isFixed)
+    }
+
+    @Test("Direct construction matches the parsed string")
+    func matchesParsedString() throws {
+        let builder = CapsBuilder.video()
+            .formats([.nv12, .i420])
+            .width(in: 320...1920)
+            .height(in: 240...1080)
+            .framerate(min: (1, 1), max: (60, 1))
+
+        let direct = builder.buildCaps()
+        let parsed = try Caps(builder.build())
+
+        #expect(!direct.isFixed)
+        #expect(direct.canIntersect(with: parsed))
+        #expect(!direct.intersect(parsed).isEmpty)
+        #expect(direct.structure(at: 0)?.serializedValue("format") == parsed.structure(at: 0)?.serializedValue("format"))
+    }
+
+    @Test("Untyped string properties are inferred")
+    func inferredTypes() throws {
+        let caps = CapsBuilder.video()
+            .property("width", "640")
+            .property("framerate", "25/1")
+            .property("format", "RGBA")
+            .buildCaps()
+
+        let structure = try #require(caps.structure(at: 0))
+        #expect(structure.int("width") == 640)
+        #expect(structure.fraction("framerate")?.denominator == 1)
+        #expect(structure.string("format") == "RGBA")
+    }
+
+    @Test("Identical builders share interned caps")
+    func interning() {
+        let first = CapsBuilder.hd720pBGRA.buildCaps()
+        let second = CapsBuilder.hd720pBGRA.buildCaps()
+        #expect(first.caps == second.caps)
+    }
+
+    @Test("Intersect and fixate against device caps")
+    func intersectAndFixate() throws {
+        let device = try Caps("video/x-raw,format={ NV12, YUY2 },width=[ 1, 1920 ],height=[ 1, 1080 ],framerate=30/1")
+
+        let wanted = try #require(
+            CapsBuilder.video().format(.nv12).size(width: 1280, height: 720).intersect(with: device)
+        )
+        #expect(wanted.isFixed)
+
+        #expect(CapsBuilder.video().format(.bgra).intersect(with: device) == nil)
+
+        let fixed = device.fixated()
+        #expect(fixed.isFixed)
+        #expect(fixed.structure(at: 0)?.string("format") == "NV12")
+    }
+}
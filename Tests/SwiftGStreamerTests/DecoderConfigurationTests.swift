@@ -0,0 +1,128 @@
+import Synchronization
+import Testing
+@testable import GStreamer
+
+@Suite("Decoder Configuration Tests")
+struct DecoderConfigurationTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    private static let jpegPipeline = """
+        videotestsrc num-buffers=3 ! video/x-raw,width=64,height=48 ! jpegenc ! \
+        decodebin name=dec ! fakesink sync=false
+        """
+
+    /// Run a pipeline to EOS or error and return whether it reached EOS.
+    private func run(_ pipeline: Pipeline) async throws -> Bool {
+        try pipeline.play()
+        defer { pipeline.stop() }
+        for await message in pipeline.bus.messages(filter: [.eos, .error]) {
+            if case .eos = message { return true }
+            return false
+        }
+        return false
+    }
+
+    @Test("Element setup sees every auto-plugged element")
+    func elementSetupSeesPluggedElements() async throws {
+        let added = Mutex<[String]>([])
+        let pipeline = try Pipeline(Self.jpegPipeline)
+        try pipeline.configureDecoders(
+            named: "dec",
+            DecoderConfiguration { element in
+                added.withLock { $0.append(element.name) }
+            }
+        )
+
+        #expect(try await run(pipeline))
+        #expect(added.withLock { $0.contains { $0.hasPrefix("jpegdec") } })
+    }
+
+    @Test("Element setup sees each element once")
+    func elementSetupOncePerElement() async throws {
+        let added = Mutex<[String]>([])
+        let pipeline = try Pipeline(Self.jpegPipeline)
+        try pipeline.configureDecoders(
+            named: "dec",
+            DecoderConfiguration { element in
+                added.withLock { $0.append(element.name) }
+            }
+        )
+
+        #expect(try await run(pipeline))
+        let names = added.withLock { $0 }
+        #expect(Set(names).count == names.count)
+    }
+
+    @Test("A rank of zero excludes a factory")
+    func rankZeroExcludesFactory() async throws {
+        let added = Mutex<[String]>([])
+        let pipeline = try Pipeline(Self.jpegPipeline)
+        try pipeline.configureDecoders(
+            named: "dec",
+            DecoderConfiguration(rankOverrides: ["jpegdec": 0]) { element in
+                added.withLock { $0.append(element.name) }
+            }
+        )
+
+        _ = try await run(pipeline)
+        #expect(!added.withLock { $0.contains { $0.hasPrefix("jpegdec") } })
+    }
+
+    @Test("Configuring a missing element throws")
+    func missingElementThrows() throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink")
+        #expect(throws: GStreamerError.self) {
+            try pipeline.configureDecoders(named: "dec", DecoderConfiguration(maxThreads: 1))
+        }
+    }
+
+    @Test("A configured URIDecodeSource names its decodebin")
+    func configuredSourceIsNamed() throws {
+        let plain = URIDecodeSource.file(path: "/tmp/clip.mp4")
+        let configured = plain.configured(DecoderConfiguration(maxThreads: 1))
+
+        #expect(plain.pipeline == "uridecodebin uri=file:///tmp/clip.mp4")
+        #expect(configured.pipeline.hasPrefix("uridecodebin name=swiftdecodebin"))
+        #expect(configured.pipeline.hasSuffix(" uri=file:///tmp/clip.mp4"))
+    }
+
+    @Test("A configured source configures the pipeline built from it")
+    func configuredSourceReachesElement() async throws {
+        let path = "/tmp/swift-gst-decoder-\(UInt32.random(in: 0...UInt32.max)).avi"
+        let writer = try Pipeline(
+            """
+            videotestsrc num-buffers=3 ! video/x-raw,width=64,height=48 ! jpegenc ! avimux ! \
+            filesink location=\(path)
+            """
+        )
+        #expect(try await run(writer))
+
+        let added = Mutex<[String]>([])
+        let source = URIDecodeSource.file(path: path).configured(
+            DecoderConfiguration { element in
+                added.withLock { $0.append(element.name) }
+            }
+        )
+        let partial = VideoPipelineBuilder.buildPartialBlock(first: source)
+        #expect(partial.decoders.count == 1)
+
+        // The same description configures every pipeline parsed from it.
+        for _ in 0..<2 {
+            added.withLock { $0.removeAll() }
+            let pipeline = try Pipeline(partial.pipeline + " ! fakesink sync=false")
+            try pipeline.configureDecoders(partial.decoders)
+            #expect(try await run(pipeline))
+            #expect(added.withLock { $0.contains { $0.hasPrefix("jpegdec") } })
+        }
+    }
+
+    @Test("Reading a source's description has no side effects")
+    func descriptionIsStable() {
+        let source = URIDecodeSource.file(path: "/tmp/clip.mp4").configured(DecoderConfiguration(maxThreads: 1))
+        #expect(source.pipeline == source.pipeline)
+        #expect(source.decoderConfigurations.keys.map { "uridecodebin name=\($0) uri=file:///tmp/clip.mp4" } == [source.pipeline])
+    }
+}
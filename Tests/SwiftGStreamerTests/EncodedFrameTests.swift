@@ -0,0 +1,111 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Encoded Frame Tests")
+struct EncodedFrameTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    /// SPS, PPS and IDR slice with 4- and 3-byte start codes.
+    private static let annexB: [UInt8] = [
+        0, 0, 0, 1, 0x67, 0x42, 0x00, 0x1E,
+        0, 0, 1, 0x68, 0xCE, 0x38, 0x80,
+        0, 0, 0, 1, 0x65, 0x88, 0x84, 0x00, 0x00,
+    ]
+
+    @Test("Byte-stream NAL units are located by start code")
+    func byteStream() throws {
+        let caps = try Caps("video/x-h264,stream-format=byte-stream,alignment=au")
+        let frame = EncodedFrame(buffer: try Buffer(data: Self.annexB), caps: caps)
+
+        #expect(frame.codec == .h264)
+        #expect(frame.streamFormat == .byteStream)
+        #expect(frame.nalUnits.map(\.type) == [7, 8, 5])
+        #expect(frame.nalUnits.map(\.offset) == [4, 11, 19])
+        #expect(frame.nalUnits.map(\.size) == [4, 4, 3])
+        #expect(frame.isKeyframe)
+        #expect(frame.containsParameterSets)
+    }
+
+    @Test("Length-prefixed NAL units are located by size")
+    func lengthPrefixed() throws {
+        let data: [UInt8] = [0, 0, 0, 3, 0x41, 0x9A, 0x02, 0, 0, 0, 2, 0x06, 0x05]
+        let caps = try Caps("video/x-h264,stream-format=avc,alignment=au")
+        let frame = EncodedFrame(buffer: try Buffer(data: data), caps: caps)
+
+        #expect(frame.streamFormat == .lengthPrefixed(4))
+        #expect(frame.nalUnits.map(\.type) == [1, 6])
+        #expect(!frame.isKeyframe)
+        #expect(!frame.containsSPS)
+    }
+
+    @Test("H.265 NAL types use the six-bit header field")
+    func h265Types() throws {
+        let data: [UInt8] = [0, 0, 1, 0x40, 0x01, 0x0C, 0, 0, 1, 0x26, 0x01, 0xAF]
+        let caps = try Caps("video/x-h265,stream-format=byte-stream")
+        let frame = EncodedFrame(buffer: try Buffer(data: data), caps: caps)
+
+        #expect(frame.nalUnits.map(\.type) == [32, 19])
+        #expect(frame.containsVPS)
+        #expect(frame.isKeyframe)
+    }
+
+    @Test("NAL units are read in place and shared as sub-buffers")
+    func zeroCopyAccess() throws {
+        let caps = try Caps("video/x-h264,stream-format=byte-stream")
+        let frame = EncodedFrame(buffer: try Buffer(data: Self.annexB), caps: caps)
+        let pps = frame.nalUnits[1]
+
+        let header = try frame.withBytes(of: pps) { $0.unsafeLoad(as: UInt8.self) }
+        #expect(header == 0x68)
+
+        let slice = try #require(frame.buffer(for: pps))
+        #expect(slice.size == 4)
+        #expect(slice.bytes.unsafeLoad(fromByteOffset: 3, as: UInt8.self) == 0x80)
+    }
+
+    @Test("Other codecs carry caps without NAL units")
+    func otherCodec() throws {
+        let caps = try Caps("audio/mpeg,mpegversion=4")
+        let frame = EncodedFrame(buffer: try Buffer(data: [0xFF, 0xF1, 0x50]), caps: caps)
+
+        #expect(frame.codec == .other("audio/mpeg"))
+        #expect(frame.streamFormat == nil)
+        #expect(frame.nalUnits.isEmpty)
+    }
+
+    @Test("Codec data is taken from the caps")
+    func codecData() throws {
+        let caps = try Caps("audio/mpeg,mpegversion=4,stream-format=raw,codec_data=(buffer)1210")
+        let frame = EncodedFrame(buffer: try Buffer(data: [0x21, 0x00]), caps: caps)
+
+        let config = try #require(frame.codecData)
+        #expect(config.size == 2)
+        #expect(config.bytes.unsafeLoad(fromByteOffset: 0, as: UInt8.self) == 0x12)
+        #expect(config.bytes.unsafeLoad(fromByteOffset: 1, as: UInt8.self) == 0x10)
+
+        let bare = EncodedFrame(buffer: try Buffer(data: [0x21, 0x00]), caps: try Caps("audio/x-opus"))
+        #expect(bare.codecData == nil)
+    }
+
+    @Test("Encoded frames are pulled from an appsink")
+    func encodedFramesFromSink() async throws {
+        let pipeline = try Pipeline("""
+            videotestsrc num-buffers=3 ! video/x-raw,width=64,height=48 ! x264enc key-int-max=1 ! \
+            video/x-h264,stream-format=byte-stream,alignment=au ! appsink name=sink sync=false
+            """)
+        let sink = try pipeline.appSink(named: "sink")
+        try pipeline.play()
+        defer { pipeline.stop() }
+
+        var count = 0
+        for try await frame in sink.encodedFrames() {
+            #expect(frame.codec == .h264)
+            #expect(frame.isKeyframe)
+            count += 1
+        }
+        #expect(count == 3)
+    }
+}
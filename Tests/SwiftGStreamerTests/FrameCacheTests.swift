@@ -0,0 +1,78 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Frame Cache Tests")
+struct FrameCacheTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    /// 25 fps, 40ms per frame.
+    private func makePipeline() throws -> (Pipeline, AppSink) {
+        let pipeline = try Pipeline("""
+            videotestsrc ! video/x-raw,format=BGRA,width=64,height=48,framerate=25/1 ! \
+            appsink name=sink sync=false
+            """)
+        return (pipeline, try pipeline.appSink(named: "sink"))
+    }
+
+    @Test("Repeated access hits the cache")
+    func repeatedAccessHits() async throws {
+        let (pipeline, sink) = try makePipeline()
+        let cache = FrameCache(pipeline: pipeline, sink: sink)
+        try await pipeline.pause(timeout: .seconds(5))
+
+        let first = try await cache.frame(at: 400_000_000)
+        #expect(first.pts == 400_000_000)
+
+        // Any position within the frame's duration is the same frame.
+        let again = try await cache.frame(at: 420_000_000)
+        #expect(again.pts == 400_000_000)
+
+        let statistics = await cache.statistics
+        #expect(statistics.misses == 1)
+        #expect(statistics.hits == 1)
+        #expect(statistics.frames == 1)
+        #expect(statistics.bytes == 64 * 48 * 4)
+
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("Prefetch fills a window around the playhead")
+    func prefetchWindow() async throws {
+        let (pipeline, sink) = try makePipeline()
+        let cache = FrameCache(pipeline: pipeline, sink: sink)
+        try await pipeline.pause(timeout: .seconds(5))
+
+        await cache.prefetch(around: 1_000_000_000, behind: .milliseconds(200), ahead: .milliseconds(200))
+        try await Task.sleep(for: .seconds(1))
+
+        #expect(await cache.cachedFrame(at: 800_000_000) != nil)
+        #expect(await cache.cachedFrame(at: 1_000_000_000) != nil)
+        #expect(await cache.cachedFrame(at: 1_160_000_000) != nil)
+        #expect(await cache.cachedFrame(at: 2_000_000_000) == nil)
+
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("Least recently used frames are evicted past capacity")
+    func evictsLeastRecentlyUsed() async throws {
+        let (pipeline, sink) = try makePipeline()
+        let frameSize = 64 * 48 * 4
+        let cache = FrameCache(pipeline: pipeline, sink: sink, capacity: frameSize * 2)
+        try await pipeline.pause(timeout: .seconds(5))
+
+        _ = try await cache.frame(at: 0)
+        _ = try await cache.frame(at: 40_000_000)
+        _ = try await cache.frame(at: 0)  // touch the first frame
+        _ = try await cache.frame(at: 80_000_000)
+
+        #expect(await cache.cachedFrame(at: 0) != nil)
+        #expect(await cache.cachedFrame(at: 40_000_000) == nil)
+        #expect(await cache.cachedFrame(at: 80_000_000) != nil)
+        #expect(await cache.statistics.evictions == 1)
+
+        await pipeline.stop(timeout: .seconds(5))
+    }
+}
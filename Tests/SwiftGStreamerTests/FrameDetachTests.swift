@@ -0,0 +1,152 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Frame Detach Tests")
+struct FrameDetachTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    private func makePipeline(buffers: Int) throws -> Pipeline {
+        try Pipeline(
+            """
+            videotestsrc num-buffers=\(buffers) pattern=ball ! \
+            video/x-raw,format=BGRA,width=64,height=48 ! \
+            appsink name=sink
+            """
+        )
+    }
+
+    @Test("Detached frame copies pixels and timestamps")
+    func detachedCopy() async throws {
+        let pipeline = try makePipeline(buffers: 3)
+        let sink = try AppSink(pipeline: pipeline, name: "sink")
+        try pipeline.play()
+        defer { pipeline.stop() }
+
+        for try await frame in sink.frames() {
+            #expect(!frame.isDetached)
+
+            let copy = try frame.detached()
+            #expect(copy.isDetached)
+            #expect(copy.width == frame.width)
+            #expect(copy.height == frame.height)
+            #expect(copy.format == frame.format)
+            #expect(copy.pts == frame.pts)
+            #expect(copy.duration == frame.duration)
+
+            let original = try frame.withUnsafeBytes { Array($0) }
+            let copied = try copy.withUnsafeBytes { Array($0) }
+            #expect(copied == original)
+            break
+        }
+    }
+
+    @Test("Arena reuses memory of released copies")
+    func arenaReuse() async throws {
+        let pipeline = try makePipeline(buffers: 5)
+        let sink = try AppSink(pipeline: pipeline, name: "sink")
+        let arena = FrameArena(capacity: 4 * 64 * 48 * 4)
+        try pipeline.play()
+        defer { pipeline.stop() }
+
+        var count = 0
+        for try await frame in sink.frames() {
+            do {
+                let copy = try frame.detached(into: arena)
+                #expect(copy.isDetached)
+                #expect(arena.statistics.liveBytes == 64 * 48 * 4)
+            }
+            #expect(arena.statistics.liveBytes == 0)
+            count += 1
+            if count >= 3 { break }
+        }
+
+        let statistics = arena.statistics
+        #expect(statistics.reused == 2)
+        #expect(statistics.cachedBytes == 64 * 48 * 4)
+
+        arena.trim()
+        #expect(arena.statistics.cachedBytes == 0)
+    }
+
+    @Test("Full arena refuses copies")
+    func arenaRefuses() async throws {
+        let pipeline = try makePipeline(buffers: 3)
+        let sink = try AppSink(pipeline: pipeline, name: "sink")
+        let arena = FrameArena(capacity: 64 * 48 * 4)
+        try pipeline.play()
+        defer { pipeline.stop() }
+
+        var held: [VideoFrame] = []
+        for try await frame in sink.frames() {
+            if held.isEmpty {
+                held.append(try frame.detached(into: arena))
+            } else {
+                #expect(throws: GStreamerError.self) {
+                    _ = try frame.detached(into: arena)
+                }
+                break
+            }
+        }
+
+        #expect(held.count == 1)
+        #expect(arena.statistics.refused == 1)
+    }
+
+    @Test("Detach policy copies held frames off the pool")
+    func detachPolicy() async throws {
+        let pipeline = try makePipeline(buffers: 4)
+        let sink = try AppSink(pipeline: pipeline, name: "sink")
+        sink.setDetachPolicy(AppSink.DetachPolicy(after: .milliseconds(50)))
+        try pipeline.play()
+        defer { pipeline.stop() }
+
+        var held: [VideoFrame] = []
+        var original: [[UInt8]] = []
+        for try await frame in sink.frames() {
+            held.append(frame)
+            original.append(try frame.withUnsafeBytes { Array($0) })
+            if held.count >= 3 { break }
+        }
+        #expect(sink.poolPressure.peakOutstanding >= 1)
+
+        try await Task.sleep(for: .milliseconds(300))
+
+        for (frame, bytes) in zip(held, original) {
+            #expect(frame.isDetached)
+            #expect(try frame.withUnsafeBytes { Array($0) } == bytes)
+        }
+
+        let pressure = sink.poolPressure
+        #expect(pressure.outstanding == 0)
+        #expect(pressure.detached == held.count)
+        #expect(pressure.detachedBytes == held.count * 64 * 48 * 4)
+
+        sink.setDetachPolicy(nil)
+    }
+
+    @Test("Frames released in time are not copied")
+    func releasedFramesNotCopied() async throws {
+        let pipeline = try makePipeline(buffers: 3)
+        let sink = try AppSink(pipeline: pipeline, name: "sink")
+        sink.setDetachPolicy(AppSink.DetachPolicy(after: .milliseconds(200)))
+        try pipeline.play()
+        defer { pipeline.stop() }
+
+        var count = 0
+        for try await frame in sink.frames() {
+            _ = frame.width
+            count += 1
+            if count >= 3 { break }
+        }
+
+        try await Task.sleep(for: .milliseconds(300))
+        let pressure = sink.poolPressure
+        #expect(pressure.outstanding == 0)
+        #expect(pressure.detached == 0)
+
+        sink.setDetachPolicy(nil)
+    }
+}
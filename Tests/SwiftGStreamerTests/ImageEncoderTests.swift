@@ -0,0 +1,83 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Image Encoder Tests")
+struct ImageEncoderTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    /// Pull `count` BGRA test-pattern frames.
+    private func frames(_ count: Int) async throws -> [VideoFrame] {
+        let pipeline = try Pipeline(
+            """
+            videotestsrc num-buffers=\(count) ! video/x-raw,format=BGRA,width=160,height=120 ! \
+            appsink name=sink
+            """
+        )
+        defer { pipeline.stop() }
+
+        let sink = try pipeline.appSink(named: "sink")
+        try pipeline.play()
+
+        var result: [VideoFrame] = []
+        for try await frame in sink.frames() {
+            result.append(frame)
+        }
+        return result
+    }
+
+    @Test("Encodes JPEG and keeps frame timestamps")
+    func encodesJPEG() async throws {
+        let frame = try #require(try await frames(1).first)
+        let encoder = ImageEncoder(format: .jpeg(quality: 80))
+
+        let jpeg = try await encoder.encode(frame)
+        let header = jpeg.bytes.withUnsafeBytes { Array($0.prefix(2)) }
+        #expect(header == [0xFF, 0xD8])
+        #expect(jpeg.pts == frame.pts)
+
+        await encoder.close()
+    }
+
+    @Test("Encodes PNG")
+    func encodesPNG() async throws {
+        let frame = try #require(try await frames(1).first)
+        let encoder = ImageEncoder(format: .png(compressionLevel: 1))
+
+        let png = try await encoder.encode(frame)
+        let header = png.bytes.withUnsafeBytes { Array($0.prefix(4)) }
+        #expect(header == [0x89, 0x50, 0x4E, 0x47])
+
+        await encoder.close()
+    }
+
+    @Test("In-flight requests are matched to their frames")
+    func batchPreservesOrder() async throws {
+        let input = try await frames(8)
+        let encoder = ImageEncoder(format: .jpeg(quality: 50), maxInFlight: 3)
+
+        let output = try await encoder.encode(input)
+        #expect(output.count == input.count)
+        #expect(output.map(\.pts) == input.map(\.pts))
+
+        await encoder.close()
+    }
+
+    @Test("Compressed frames are rejected")
+    func rejectsCompressed() async throws {
+        let pipeline = try Pipeline(
+            "videotestsrc num-buffers=1 ! video/x-raw,width=64,height=48 ! jpegenc ! appsink name=sink"
+        )
+        defer { pipeline.stop() }
+        let sink = try pipeline.appSink(named: "sink")
+        try pipeline.play()
+
+        let frame = try #require(try await sink.frames().makeAsyncIterator().next())
+        let encoder = ImageEncoder()
+        await #expect(throws: ImageEncoder.EncoderError.self) {
+            _ = try await encoder.encode(frame)
+        }
+    }
+}
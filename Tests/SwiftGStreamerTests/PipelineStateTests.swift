@@ -0,0 +1,74 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Pipeline State Tests")
+struct PipelineStateTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    @Test("Async play waits for preroll")
+    func playWaitsForPreroll() async throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink")
+
+        let state = try await pipeline.setState(.playing, timeout: .seconds(5))
+        #expect(state == .playing)
+        #expect(pipeline.currentState() == .playing)
+
+        await pipeline.stop(timeout: .seconds(5))
+        #expect(pipeline.currentState() == .null)
+    }
+
+    @Test("Preroll errors are thrown without consuming bus messages")
+    func prerollError() async throws {
+        let pipeline = try Pipeline("filesrc location=/nonexistent/file.mp4 ! decodebin ! fakesink")
+
+        await #expect(throws: GStreamerError.self) {
+            try await pipeline.play(timeout: .seconds(5))
+        }
+
+        var sawError = false
+        for await message in pipeline.bus.messages(filter: .error) {
+            if case .error = message {
+                sawError = true
+                break
+            }
+        }
+        #expect(sawError)
+
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("Timeout is reported as a failed state change")
+    func timeout() async throws {
+        // A sink that never receives a buffer can't preroll.
+        let pipeline = try Pipeline("appsrc ! fakesink")
+
+        await #expect(throws: GStreamerError.self) {
+            try await pipeline.pause(timeout: .milliseconds(100))
+        }
+
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("Parallel start returns results in order")
+    func parallelStart() async throws {
+        let pipelines = try [
+            Pipeline("videotestsrc ! fakesink"),
+            Pipeline("appsrc ! fakesink"),
+            Pipeline("audiotestsrc ! fakesink"),
+        ]
+
+        let results = await Pipeline.start(pipelines, to: .paused, maxConcurrent: 2, timeout: .milliseconds(500))
+
+        #expect(results.count == 3)
+        #expect((try? results[0].get()) == .paused)
+        #expect((try? results[1].get()) == nil)
+        #expect((try? results[2].get()) == .paused)
+
+        for pipeline in pipelines {
+            await pipeline.stop(timeout: .seconds(5))
+        }
+    }
+}
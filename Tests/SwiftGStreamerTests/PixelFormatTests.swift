@@ -0,0 +1,59 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Pixel Format Tests")
+struct PixelFormatTests {
+
+    @Test("Camera and decoder formats round-trip through their names")
+    func roundTrip() {
+        let formats: [PixelFormat] = [.yuy2, .uyvy, .mjpeg, .p010, .i420_10le, .gray16le]
+        for format in formats {
+            #expect(PixelFormat(string: format.formatString) == format)
+        }
+        #expect(PixelFormat(string: "P010_10LE") == .p010)
+        #expect(PixelFormat.mjpeg.mediaType == "image/jpeg")
+        #expect(PixelFormat.yuy2.mediaType == "video/x-raw")
+    }
+
+    @Test("Plane counts and subsampling")
+    func planeProperties() {
+        #expect(PixelFormat.yuy2.planeCount == 1)
+        #expect(PixelFormat.yuy2.chromaSubsampling == .yuv422)
+        #expect(PixelFormat.p010.planeCount == 2)
+        #expect(PixelFormat.p010.bitDepth == 10)
+        #expect(PixelFormat.i420_10le.planeCount == 3)
+        #expect(PixelFormat.i420.chromaSubsampling == .yuv420)
+        #expect(PixelFormat.gray16le.bytesPerPixel == 2)
+        #expect(PixelFormat.mjpeg.isCompressed)
+        #expect(PixelFormat.mjpeg.planes(width: 640, height: 480).isEmpty)
+    }
+
+    @Test("Frame sizes match GStreamer's default layout")
+    func frameSizes() {
+        #expect(PixelFormat.bgra.frameSize(width: 1920, height: 1080) == 8_294_400)
+        #expect(PixelFormat.nv12.frameSize(width: 1920, height: 1080) == 3_110_400)
+        #expect(PixelFormat.i420.frameSize(width: 640, height: 480) == 460_800)
+        #expect(PixelFormat.yuy2.frameSize(width: 640, height: 480) == 614_400)
+        #expect(PixelFormat.p010.frameSize(width: 1920, height: 1080) == 6_220_800)
+        #expect(PixelFormat.gray16le.frameSize(width: 640, height: 480) == 614_400)
+        #expect(PixelFormat.mjpeg.frameSize(width: 640, height: 480) == nil)
+
+        // Odd sizes pad rows to 4 bytes and round chroma up
+        let planes = PixelFormat.i420.planes(width: 321, height: 241)
+        #expect(planes.map(\.stride) == [324, 164, 164])
+        #expect(planes.map(\.offset) == [0, 78_408, 98_252])
+    }
+
+    @Test("Dimensions are inferred from exact frame sizes")
+    func inference() {
+        let nv12 = PixelFormat.nv12.inferDimensions(frameSize: 3_110_400)
+        #expect(nv12?.width == 1920)
+        #expect(nv12?.height == 1080)
+
+        let yuy2 = PixelFormat.yuy2.inferDimensions(frameSize: 614_400)
+        #expect(yuy2?.width == 640)
+        #expect(yuy2?.height == 480)
+
+        #expect(PixelFormat.mjpeg.inferDimensions(frameSize: 614_400) == nil)
+    }
+}
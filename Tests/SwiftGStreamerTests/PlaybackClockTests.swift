@@ -0,0 +1,104 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Playback Clock Tests")
+struct PlaybackClockTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    @Test("Missing sink is reported")
+    func missingSink() throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink name=out")
+        #expect(throws: GStreamerError.self) {
+            _ = try PlaybackClock(pipeline: pipeline, sink: "missing")
+        }
+    }
+
+    @Test("Position is unknown before playback")
+    func unknownBeforePlayback() throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink")
+        let clock = try PlaybackClock(pipeline: pipeline)
+        #expect(clock.position == nil)
+        #expect(!clock.isRunning)
+    }
+
+    @Test("Duration is cached and refreshed on state changes")
+    func duration() async throws {
+        let path = "/tmp/swift-gst-clock-\(UInt32.random(in: 0...UInt32.max)).avi"
+        let writer = try Pipeline("""
+            videotestsrc num-buffers=30 ! video/x-raw,width=64,height=48,framerate=30/1 ! jpegenc ! \
+            avimux ! filesink location=\(path.pipelineQuoted)
+            """)
+        try writer.play()
+        for await message in writer.bus.messages(filter: [.eos, .error]) {
+            if case .error(let message, _) = message { Issue.record("Writer failed: \(message)") }
+            break
+        }
+        await writer.stop(timeout: .seconds(5))
+
+        let pipeline = try Pipeline("filesrc location=\(path.pipelineQuoted) ! avidemux ! fakesink")
+        let clock = try PlaybackClock(pipeline: pipeline)
+        #expect(clock.duration == nil)
+
+        try await pipeline.pause(timeout: .seconds(5))
+        let duration = try #require(clock.duration)
+        #expect(duration > 900_000_000 && duration < 1_100_000_000)
+        #expect(clock.duration == duration)
+
+        await pipeline.stop(timeout: .seconds(5))
+        #expect(clock.duration == nil)
+    }
+
+    @Test("Position advances with the pipeline clock")
+    func tracksPosition() async throws {
+        let pipeline = try Pipeline("videotestsrc is-live=true ! fakesink sync=true name=out")
+        let clock = try PlaybackClock(pipeline: pipeline, sink: "out")
+        try await pipeline.play(timeout: .seconds(5))
+
+        try await Task.sleep(for: .milliseconds(200))
+        #expect(clock.isRunning)
+        #expect(clock.rate == 1)
+        let first = try #require(clock.position)
+        let queried = try #require(pipeline.position)
+        let difference = first > queried ? first - queried : queried - first
+        #expect(difference < 100_000_000)
+
+        try await Task.sleep(for: .milliseconds(100))
+        let second = try #require(clock.position)
+        #expect(second > first)
+
+        await pipeline.stop(timeout: .seconds(5))
+        #expect(clock.position == nil)
+    }
+
+    @Test("Position freezes while paused")
+    func freezesWhenPaused() async throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink sync=true")
+        let clock = try PlaybackClock(pipeline: pipeline)
+        try await pipeline.play(timeout: .seconds(5))
+        try await Task.sleep(for: .milliseconds(100))
+
+        try await pipeline.pause(timeout: .seconds(5))
+        #expect(!clock.isRunning)
+        let paused = try #require(clock.position)
+        try await Task.sleep(for: .milliseconds(100))
+        #expect(clock.position == paused)
+
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("Seeking while paused moves the position")
+    func seekWhilePaused() async throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink sync=true")
+        let clock = try PlaybackClock(pipeline: pipeline)
+        try await pipeline.pause(timeout: .seconds(5))
+
+        try pipeline.seek(to: 2_000_000_000)
+        try await pipeline.pause(timeout: .seconds(5))
+        #expect(clock.position == 2_000_000_000)
+
+        await pipeline.stop(timeout: .seconds(5))
+    }
+}
@@ -0,0 +1,88 @@
+import Synchronization
+import Testing
+@testable import GStreamer
+
+@Suite("Playlist Player Tests")
+struct PlaylistPlayerTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    @Test("Items play in order and the stream finishes")
+    func playsInOrder() async throws {
+        let player = PlaylistPlayer([
+            "videotestsrc num-buffers=5 ! fakesink sync=false",
+            "videotestsrc num-buffers=5 pattern=ball ! fakesink sync=false",
+            "videotestsrc num-buffers=5 pattern=snow ! fakesink sync=false",
+        ])
+        try await player.play()
+
+        var seen: [Int] = []
+        for await index in player.transitions {
+            seen.append(index)
+        }
+        #expect(seen.last == 2)
+        #expect(seen == seen.sorted())
+        #expect(player.currentIndex == nil)
+    }
+
+    @Test("Items that fail to preroll are skipped")
+    func skipsBrokenItems() async throws {
+        let player = PlaylistPlayer([
+            "videotestsrc num-buffers=5 ! fakesink sync=false",
+            "filesrc location=/nonexistent/file.mp4 ! decodebin ! fakesink",
+            "videotestsrc num-buffers=5 ! fakesink sync=false",
+        ])
+        try await player.play()
+
+        var seen: [Int] = []
+        for await index in player.transitions {
+            seen.append(index)
+        }
+        #expect(!seen.contains(1))
+        #expect(seen.last == 2)
+    }
+
+    @Test("A single looping item keeps playing past its end")
+    func segmentLoop() async throws {
+        let player = PlaylistPlayer(
+            ["audiotestsrc num-buffers=10 samplesperbuffer=441 ! audio/x-raw,rate=44100 ! fakesink name=out sync=true"],
+            loop: true
+        )
+        try await player.play()
+
+        let buffers = Atomic(0)
+        let pad = try #require(player.currentPipeline?.element(named: "out")?.staticPad("sink"))
+        let probe = pad.addProbe(type: .buffer) {
+            buffers.add(1, ordering: .relaxed)
+            return .ok
+        }
+
+        // 10 buffers of 10ms per pass: 500ms covers several loops only if
+        // every SEGMENT_DONE queues the next one.
+        try await Task.sleep(for: .milliseconds(500))
+        #expect(buffers.load(ordering: .relaxed) > 20)
+        #expect(player.currentIndex == 0)
+        #expect(player.currentPipeline?.currentState() == .playing)
+
+        pad.removeProbe(probe)
+        await player.stop()
+        #expect(player.currentPipeline == nil)
+    }
+
+    @Test("A short first item still advances")
+    func shortFirstItem() async throws {
+        let player = PlaylistPlayer([
+            "videotestsrc num-buffers=1 ! fakesink sync=false",
+            "videotestsrc num-buffers=1 ! fakesink sync=false",
+        ])
+        try await player.play()
+
+        var seen: [Int] = []
+        for await index in player.transitions {
+            seen.append(index)
+        }
+        #expect(seen.last == 1)
+    }
+}
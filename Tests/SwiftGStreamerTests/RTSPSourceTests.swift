@@ -0,0 +1,84 @@
+import Testing
+@testable import GStreamer
+
+@Suite("RTSP Source Tests")
+struct RTSPSourceTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    /// Local RTP stream standing in for a camera: payloaded test video
+    /// through a jitterbuffer, as rtspsrc would set it up.
+    private static let rtpPipeline = """
+        videotestsrc num-buffers=20 ! video/x-raw,width=64,height=48 ! rtpvrawpay ! \
+        rtpjitterbuffer name=jb latency=50 ! fakesink sync=false
+        """
+
+    @Test("Default options keep the low-latency string")
+    func defaultOptions() {
+        let source = RTSPVideoSource(location: "rtsp://camera.local/stream")
+        #expect(source.pipeline == "rtspsrc location=rtsp://camera.local/stream latency=0 ! decodebin")
+    }
+
+    @Test("Transport, drop and buffer mode become rtspsrc properties")
+    func options() {
+        let source = RTSPVideoSource(
+            location: "rtsp://camera.local/stream",
+            latency: 200,
+            transport: .tcp,
+            dropOnLatency: true,
+            bufferMode: .slave
+        )
+        #expect(source.pipeline.hasPrefix(
+            "rtspsrc location=rtsp://camera.local/stream latency=200 protocols=tcp drop-on-latency=true buffer-mode=1"))
+    }
+
+    @Test("Starting on a keyframe configures the decodebin")
+    func startOnKeyframe() throws {
+        let source = RTSPVideoSource(location: "rtsp://camera.local/stream", startOnKeyframe: true)
+        #expect(source.pipeline.contains("! decodebin name=swiftdecodebin"))
+        let name = try #require(source.decoderConfigurations.keys.first)
+        #expect(source.pipeline.hasSuffix("! decodebin name=\(name)"))
+    }
+
+    @Test("Statistics are read from jitterbuffers")
+    func statisticsAfterPlayback() async throws {
+        let pipeline = try Pipeline(Self.rtpPipeline)
+        try pipeline.play()
+        defer { pipeline.stop() }
+        for await message in pipeline.bus.messages(filter: [.eos, .error]) {
+            if case .error(let message, _) = message {
+                Issue.record("Pipeline failed: \(message)")
+            }
+            break
+        }
+
+        let statistics = pipeline.jitterBufferStatistics()
+        #expect(statistics.count == 1)
+        #expect(statistics.first?.element == "jb")
+        #expect((statistics.first?.pushed ?? 0) > 0)
+        #expect(statistics.first?.lost == 0)
+    }
+
+    @Test("A pipeline without jitterbuffers has no statistics")
+    func noJitterBuffer() throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink")
+        #expect(pipeline.jitterBufferStatistics().isEmpty)
+    }
+
+    @Test("The statistics stream samples while playing")
+    func statisticsStream() async throws {
+        let pipeline = try Pipeline(Self.rtpPipeline)
+        try pipeline.play()
+        defer { pipeline.stop() }
+
+        var samples = 0
+        for await snapshot in pipeline.jitterBufferStatistics(every: .milliseconds(10)) {
+            #expect(snapshot.count == 1)
+            samples += 1
+            if samples == 3 { break }
+        }
+        #expect(samples == 3)
+    }
+}
@@ -0,0 +1,53 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Scrubber Tests")
+struct ScrubberTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    @Test("Rapid scrubs coalesce to the latest position")
+    func coalescesToLatest() async throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink sync=true")
+        try await pipeline.pause(timeout: .seconds(5))
+
+        let scrubber = Scrubber(pipeline: pipeline)
+        for second in 1...50 {
+            scrubber.scrub(to: UInt64(second) * 100_000_000)
+        }
+        await scrubber.idle()
+
+        #expect(!scrubber.isSeeking)
+        #expect(scrubber.displayedPosition == 5_000_000_000)
+
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("Release seeks accurately to the last scrub position")
+    func releaseRefines() async throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink sync=true")
+        try await pipeline.pause(timeout: .seconds(5))
+
+        let scrubber = Scrubber(pipeline: pipeline)
+        scrubber.scrub(to: 1_234_000_000)
+        scrubber.release()
+        await scrubber.idle()
+
+        #expect(scrubber.displayedPosition == 1_234_000_000)
+
+        var iterator = scrubber.displayedPositions.makeAsyncIterator()
+        #expect(await iterator.next() == 1_234_000_000)
+
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("Idle returns immediately when nothing is pending")
+    func idleWhenUnused() async throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink")
+        let scrubber = Scrubber(pipeline: pipeline)
+        await scrubber.idle()
+        #expect(scrubber.displayedPosition == nil)
+    }
+}
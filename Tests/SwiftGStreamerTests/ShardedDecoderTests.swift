@@ -0,0 +1,96 @@
+import Synchronization
+import Testing
+@testable import GStreamer
+
+@Suite("Sharded Decoder Tests")
+struct ShardedDecoderTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    /// Write a 30 fps clip of `frames` keyframes to a temporary AVI file.
+    ///
+    /// The name contains `!`, which must survive as part of the URI.
+    private func makeClip(frames: Int) async throws -> String {
+        let path = "/tmp/swift-gst-sharded!\(UInt32.random(in: 0...UInt32.max)).avi"
+        let pipeline = try Pipeline(
+            """
+            videotestsrc num-buffers=\(frames) ! \
+            video/x-raw,width=64,height=48,framerate=30/1 ! jpegenc ! avimux ! \
+            filesink location=\(path.pipelineQuoted)
+            """
+        )
+        try pipeline.play()
+        defer { pipeline.stop() }
+        for await message in pipeline.bus.messages(filter: [.eos, .error]) {
+            if case .error(let text, let debug) = message {
+                throw GStreamerError.busError(text, source: nil, debug: debug)
+            }
+            break
+        }
+        return "file://\(path)"
+    }
+
+    @Test("Nominal boundaries split the duration evenly")
+    func nominalBoundaries() {
+        let boundaries = ShardedDecoder.nominalBoundaries(duration: 8_000, count: 4)
+        #expect(boundaries == [2_000, 4_000, 6_000])
+
+        #expect(ShardedDecoder.nominalBoundaries(duration: 8_000, count: 1).isEmpty)
+    }
+
+    @Test("Shards are contiguous and half-open")
+    func shardsAreContiguous() {
+        let shards = ShardedDecoder.makeShards(boundaries: [0, 1_900, 4_000, 5_950])
+
+        #expect(shards.count == 4)
+        #expect(shards[0].start == 0)
+        #expect(shards[0].stop == 1_900)
+        #expect(shards[3].stop == nil)
+
+        for (current, next) in zip(shards, shards.dropFirst()) {
+            #expect(current.stop == next.start)
+        }
+
+        // A boundary frame belongs to exactly one shard.
+        #expect(!shards[0].contains(1_900))
+        #expect(shards[1].contains(1_900))
+    }
+
+    @Test("Split points snapping to the same keyframe are merged")
+    func duplicateKeyframesMerged() {
+        let shards = ShardedDecoder.makeShards(boundaries: [0, 0, 2_000, 2_000, 3_000])
+
+        #expect(shards.map(\.start) == [0, 2_000, 3_000])
+        #expect(shards.map(\.index) == [0, 1, 2])
+    }
+
+    @Test("Invalid shard count throws")
+    func invalidShardCount() async {
+        let decoder = ShardedDecoder(uri: "file:///nonexistent.mp4", shardCount: 0)
+
+        await #expect(throws: ShardedDecoder.ShardingError.self) {
+            try await decoder.run { _, _ in }
+        }
+    }
+
+    @Test("Every frame is decoded exactly once across shards")
+    func decodesAcrossShards() async throws {
+        let uri = try await makeClip(frames: 60)
+        let decoder = ShardedDecoder(uri: uri, shardCount: 2)
+
+        let seen = Mutex<[(shard: Int, pts: UInt64)]>([])
+        try await decoder.run { shard, frame in
+            #expect(frame.width == 64)
+            #expect(frame.height == 48)
+            let pts = try #require(frame.pts)
+            seen.withLock { $0.append((shard.index, pts)) }
+        }
+
+        let frames = seen.withLock { $0 }
+        #expect(frames.count == 60)
+        #expect(Set(frames.map(\.pts)).count == 60)
+        #expect(Set(frames.map(\.shard)) == [0, 1])
+    }
+}
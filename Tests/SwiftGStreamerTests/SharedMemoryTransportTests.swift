@@ -0,0 +1,142 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Shared Memory Transport Tests")
+struct SharedMemoryTransportTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    private static func socketPath() -> String {
+        "/tmp/swift-gst-shm-\(UInt32.random(in: 0...UInt32.max)).sock"
+    }
+
+    @Test("Frames arrive with their bytes, timestamps and caps")
+    func roundTrip() async throws {
+        let path = Self.socketPath()
+        let publisher = try SharedMemoryPublisher(socketPath: path, slotSize: 16)
+        defer { publisher.close() }
+        let subscriber = try await SharedMemorySubscriber(socketPath: path)
+        #expect(subscriber.slotCount == 4)
+
+        let buffer = try Buffer(data: [1, 2, 3, 4, 5], pts: 40_000_000, duration: 20_000_000)
+        #expect(try await publisher.publish(buffer, caps: "application/x-test"))
+
+        var frames = subscriber.frames().makeAsyncIterator()
+        let frame = try #require(await frames.next())
+        #expect(frame.size == 5)
+        #expect(frame.sequence == 1)
+        #expect(frame.pts == 40_000_000)
+        #expect(frame.duration == 20_000_000)
+        #expect(frame.dts == nil)
+        #expect(frame.caps == "application/x-test")
+        #expect(frame.withBytes { bytes in (0..<bytes.byteCount).map { bytes.unsafeLoad(fromByteOffset: $0, as: UInt8.self) } } == [1, 2, 3, 4, 5])
+
+        frame.release()
+        frame.release()
+        #expect(frame.isReleased)
+        #expect(frame.withBytes { _ in true } == nil)
+        #expect(publisher.statistics.published == 1)
+        #expect(publisher.statistics.bytes == 5)
+    }
+
+    @Test("A full ring drops frames when asked to")
+    func dropWhenFull() async throws {
+        let path = Self.socketPath()
+        let publisher = try SharedMemoryPublisher(socketPath: path, slotCount: 1, slotSize: 4, dropWhenFull: true)
+        defer { publisher.close() }
+        let subscriber = try await SharedMemorySubscriber(socketPath: path)
+
+        let buffer = try Buffer(data: [9, 9, 9, 9])
+        #expect(try await publisher.publish(buffer))
+        #expect(try await !publisher.publish(buffer))
+        #expect(publisher.statistics.dropped == 1)
+
+        // Releasing the held frame frees the slot again.
+        var frames = subscriber.frames().makeAsyncIterator()
+        let held = try #require(await frames.next())
+        held.release()
+        var published = false
+        for _ in 0..<50 where !published {
+            published = try await publisher.publish(buffer)
+            if !published { try await Task.sleep(for: .milliseconds(10)) }
+        }
+        #expect(published)
+    }
+
+    @Test("A new subscriber gets the slots the previous one held")
+    func reconnect() async throws {
+        let path = Self.socketPath()
+        let publisher = try SharedMemoryPublisher(socketPath: path, slotCount: 1, slotSize: 4, dropWhenFull: true)
+        defer { publisher.close() }
+
+        do {
+            // Leaves without releasing the only slot.
+            let first = try await SharedMemorySubscriber(socketPath: path)
+            #expect(try await publisher.publish(try Buffer(data: [1, 1, 1, 1])))
+            withExtendedLifetime(first) {}
+        }
+        for _ in 0..<50 where publisher.isConnected {
+            try await Task.sleep(for: .milliseconds(10))
+        }
+        #expect(!publisher.isConnected)
+
+        let second = try await SharedMemorySubscriber(socketPath: path)
+        #expect(try await publisher.publish(try Buffer(data: [2, 2, 2, 2])))
+        var frames = second.frames().makeAsyncIterator()
+        let frame = try #require(await frames.next())
+        #expect(frame.sequence == 2)
+        #expect(frame.withBytes { $0.unsafeLoad(as: UInt8.self) } == 2)
+    }
+
+    @Test("Oversized frames are rejected")
+    func frameTooLarge() async throws {
+        let publisher = try SharedMemoryPublisher(socketPath: Self.socketPath(), slotSize: 4)
+        defer { publisher.close() }
+
+        await #expect(throws: SharedMemoryError.self) {
+            try await publisher.publish(try Buffer(size: 4096 * 2))
+        }
+    }
+
+    @Test("Connecting without a publisher fails")
+    func noPublisher() async {
+        await #expect(throws: SharedMemoryError.self) {
+            try await SharedMemorySubscriber(socketPath: Self.socketPath(), timeout: .milliseconds(100))
+        }
+    }
+
+    @Test("Waiting subscribers leave the cooperative pool free")
+    func waitingOffThePool() async throws {
+        // More idle streams than the pool has threads.
+        var publishers: [SharedMemoryPublisher] = []
+        var consumers: [Task<Int, Never>] = []
+        for _ in 0..<32 {
+            let path = Self.socketPath()
+            let publisher = try SharedMemoryPublisher(socketPath: path, slotSize: 4)
+            let subscriber = try await SharedMemorySubscriber(socketPath: path)
+            publishers.append(publisher)
+            consumers.append(Task {
+                var count = 0
+                for await _ in subscriber.frames() { count += 1 }
+                return count
+            })
+        }
+
+        let elapsed = await ContinuousClock().measure {
+            await withTaskGroup(of: Void.self) { group in
+                for _ in 0..<32 {
+                    group.addTask { await Task.yield() }
+                }
+            }
+        }
+        #expect(elapsed < .milliseconds(500))
+
+        // Closing the publishers ends every stream.
+        publishers.forEach { $0.close() }
+        for consumer in consumers {
+            #expect(await consumer.value == 0)
+        }
+    }
+}
@@ -0,0 +1,65 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Snapshot Tests")
+struct SnapshotTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    /// Wait until the pipeline has pushed all its buffers.
+    private func waitForEOS(_ pipeline: Pipeline) async {
+        for await message in pipeline.bus.messages(filter: [.eos, .error]) {
+            if case .eos = message { return }
+            if case .error = message { return }
+        }
+    }
+
+    @Test("AppSink latest frame without a consumer")
+    func appSinkLatestFrame() async throws {
+        let pipeline = try Pipeline(
+            """
+            videotestsrc num-buffers=5 ! video/x-raw,format=BGRA,width=64,height=48 ! \
+            appsink name=sink enable-last-sample=true max-buffers=1 drop=true sync=false
+            """
+        )
+        defer { pipeline.stop() }
+        let sink = try pipeline.appSink(named: "sink")
+
+        #expect(sink.latestFrame() == nil)
+
+        try pipeline.play()
+        await waitForEOS(pipeline)
+
+        let frame = try #require(sink.latestFrame())
+        #expect(frame.width == 64)
+        #expect(frame.height == 48)
+        #expect(frame.format == .bgra)
+        #expect(frame.bytes.byteCount == 64 * 48 * 4)
+    }
+
+    @Test("Pipeline snapshot of a fakesink")
+    func fakesinkSnapshot() async throws {
+        let pipeline = try Pipeline(
+            "videotestsrc num-buffers=3 ! video/x-raw,format=I420,width=32,height=24 ! fakesink name=tap sync=false"
+        )
+        defer { pipeline.stop() }
+
+        try pipeline.play()
+        await waitForEOS(pipeline)
+
+        let frame = try #require(try pipeline.snapshot(of: "tap"))
+        #expect(frame.width == 32)
+        #expect(frame.format == .i420)
+        #expect(frame.bytes.byteCount == PixelFormat.i420.frameSize(width: 32, height: 24))
+    }
+
+    @Test("Snapshot of a missing element throws")
+    func missingElement() throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink")
+        #expect(throws: GStreamerError.self) {
+            _ = try pipeline.snapshot(of: "nope")
+        }
+    }
+}
@@ -0,0 +1,60 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Startup Profile Tests")
+struct StartupProfileTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    @Test("Profiling is off by default")
+    func disabledByDefault() throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink")
+        #expect(pipeline.startupProfile == nil)
+    }
+
+    @Test("Element transitions are recorded up to PLAYING")
+    func recordsTransitions() async throws {
+        let pipeline = try Pipeline("videotestsrc name=src ! fakesink name=sink", profileStartup: true)
+        try await pipeline.play(timeout: .seconds(5))
+
+        let profile = try #require(pipeline.startupProfile)
+        #expect(profile.parse > .zero)
+        #expect(profile.reached[.playing] != nil)
+        #expect(profile.prerolled != nil)
+        #expect(profile.total != nil)
+
+        let sourceSteps = profile.transitions.filter { $0.element == "src" }.map(\.to)
+        #expect(sourceSteps == [.ready, .paused, .playing])
+        #expect(profile.transitions.allSatisfy { $0.elapsed >= .zero })
+        #expect(!profile.transitions.contains { $0.element.hasPrefix("pipeline") })
+
+        // Transitions are in completion order.
+        let times = profile.transitions.map(\.at)
+        #expect(times == times.sorted())
+
+        #expect(Set(profile.timeByElement.map(\.element)) == ["src", "sink"])
+        #expect(profile.description.hasPrefix("startup "))
+
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("Recording leaves bus messages for the application")
+    func busUntouched() async throws {
+        let pipeline = try Pipeline("videotestsrc num-buffers=1 ! fakesink", profileStartup: true)
+        try pipeline.play()
+
+        var sawEOS = false
+        for await message in pipeline.bus.messages(filter: .eos) {
+            if case .eos = message {
+                sawEOS = true
+                break
+            }
+        }
+        #expect(sawEOS)
+        #expect(pipeline.startupProfile?.reached[.playing] != nil)
+
+        pipeline.stop()
+    }
+}
@@ -0,0 +1,104 @@
+import Foundation
+import Testing
+@testable import GStreamer
+
+@Suite("Startup Timings Tests")
+struct StartupTimingsTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    @Test("Initialization records timings")
+    func recorded() throws {
+        let timings = try #require(GStreamer.startupTimings)
+        #expect(timings.core > .zero)
+        #expect(timings.total >= timings.core)
+    }
+
+    @Test("Description reports durations and missing items")
+    func description() {
+        var timings = GStreamer.StartupTimings()
+        timings.core = .milliseconds(35)
+        timings.plugins = .milliseconds(4)
+        timings.preload = .milliseconds(2)
+        timings.missingElements = ["nvh264enc"]
+
+        #expect(timings.description == "init 41ms (core 35ms, plugins 4ms, preload 2ms), missing elements: nvh264enc")
+    }
+
+    @Test("Common elements are preloadable after initialization")
+    func commonElements() {
+        for name in ["queue", "capsfilter", "appsink"] {
+            #expect(GStreamer.Configuration.commonElements.contains(name))
+            #expect(Element.isAvailable(factory: name))
+        }
+    }
+
+    /// Two plugin directories under /tmp, and a file name in them.
+    private static func pluginDirectories() throws -> (first: String, second: String, fileName: (String) -> String) {
+        let root = "/tmp/swift-gst-plugins-\(UInt32.random(in: 0...UInt32.max))"
+        let first = root + "/first"
+        let second = root + "/second"
+        try FileManager.default.createDirectory(atPath: first, withIntermediateDirectories: true)
+        try FileManager.default.createDirectory(atPath: second, withIntermediateDirectories: true)
+        #if os(macOS) || os(iOS)
+            return (first, second, { "libgst\($0).dylib" })
+        #else
+            return (first, second, { "libgst\($0).so" })
+        #endif
+    }
+
+    @Test("Plugin names resolve in directory order")
+    func pluginResolution() throws {
+        let (first, second, fileName) = try Self.pluginDirectories()
+        FileManager.default.createFile(atPath: second + "/" + fileName("fake"), contents: Data())
+        #expect(GStreamer.pluginFile(named: "fake", in: [first, second]) == second + "/" + fileName("fake"))
+
+        FileManager.default.createFile(atPath: first + "/" + fileName("fake"), contents: Data())
+        #expect(GStreamer.pluginFile(named: "fake", in: [first, second]) == first + "/" + fileName("fake"))
+
+        #expect(GStreamer.pluginFile(named: "nosuchplugin", in: [first, second]) == nil)
+        #expect(GStreamer.pluginFile(named: first + "/" + fileName("fake"), in: []) == first + "/" + fileName("fake"))
+        #expect(GStreamer.pluginFile(named: first + "/missing.so", in: [first]) == nil)
+    }
+
+    @Test("Configured plugin directories are searched before the defaults")
+    func pluginSearchOrder() {
+        var config = GStreamer.Configuration()
+        config.pluginDirectories = ["/opt/plugins"]
+        config.pluginPaths = ["/custom/plugins"]
+
+        let directories = GStreamer.pluginSearchDirectories(for: config)
+        #expect(Array(directories.prefix(2)) == ["/opt/plugins", "/custom/plugins"])
+        #expect(directories.count > 2)
+    }
+
+    @Test("Allow-listed plugins that can't be found or loaded are reported")
+    func missingPlugins() throws {
+        let (first, _, fileName) = try Self.pluginDirectories()
+        // Found, but not a loadable library.
+        FileManager.default.createFile(atPath: first + "/" + fileName("broken"), contents: Data("not a plugin".utf8))
+
+        #expect(GStreamer.loadPlugins(["nosuchplugin", "broken"], from: [first]) == ["nosuchplugin", "broken"])
+        #expect(GStreamer.loadPlugins([], from: [first]).isEmpty)
+    }
+
+    @Test("Preload elements without a factory are reported")
+    func missingElements() {
+        #expect(GStreamer.preloadPlugins(for: ["queue", "nosuchelement", "appsink"]) == ["nosuchelement"])
+        #expect(Element.isAvailable(factory: "queue"))
+    }
+
+    @Test("Background warm-up takes precedence over lazy initialization")
+    func startupMode() {
+        var config = GStreamer.Configuration()
+        #expect(GStreamer.Startup(config) == .immediate)
+
+        config.lazyInitialize = true
+        #expect(GStreamer.Startup(config) == .lazy)
+
+        config.backgroundWarmUp = true
+        #expect(GStreamer.Startup(config) == .warmUp)
+    }
+}
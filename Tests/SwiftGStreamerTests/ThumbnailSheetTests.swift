@@ -0,0 +1,101 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Thumbnail Sheet Tests")
+struct ThumbnailSheetTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    @Test("Sample points are slice midpoints")
+    func samplePoints() {
+        let points = ThumbnailSheet.samplePoints(duration: 1_000, count: 4)
+        #expect(points == [125, 375, 625, 875])
+    }
+
+    @Test("Box filter averages covered pixels")
+    func boxFilterAverages() {
+        // 2x2 BGRA source: two black and two white pixels average to grey.
+        let source: [UInt8] = [
+            0, 0, 0, 255, 255, 255, 255, 255,
+            255, 255, 255, 255, 0, 0, 0, 255,
+        ]
+        var destination = [UInt8](repeating: 0, count: 4)
+
+        source.withUnsafeBytes { src in
+            destination.withUnsafeMutableBytes { dst in
+                ThumbnailSheet.scaleToFit(
+                    source: src,
+                    sourceWidth: 2,
+                    sourceHeight: 2,
+                    sourceStride: 8,
+                    into: dst,
+                    destinationStride: 4,
+                    x: 0,
+                    y: 0,
+                    width: 1,
+                    height: 1
+                )
+            }
+        }
+
+        #expect(destination == [127, 127, 127, 255])
+    }
+
+    @Test("Scaling preserves aspect ratio with letterboxing")
+    func letterbox() {
+        // 4x1 white source into a 4x4 tile occupies a single centred row.
+        let source = [UInt8](repeating: 255, count: 4 * 4)
+        var destination = [UInt8](repeating: 0, count: 4 * 4 * 4)
+
+        source.withUnsafeBytes { src in
+            destination.withUnsafeMutableBytes { dst in
+                ThumbnailSheet.scaleToFit(
+                    source: src,
+                    sourceWidth: 4,
+                    sourceHeight: 1,
+                    sourceStride: 16,
+                    into: dst,
+                    destinationStride: 16,
+                    x: 0,
+                    y: 0,
+                    width: 4,
+                    height: 4
+                )
+            }
+        }
+
+        let rows = stride(from: 0, to: destination.count, by: 16).map {
+            destination[$0..<($0 + 16)].allSatisfy { $0 == 255 }
+        }
+        #expect(rows == [false, true, false, false])
+    }
+
+    @Test("Generating from a missing file throws")
+    func missingFileThrows() async {
+        let sheet = ThumbnailSheet(columns: 2, rows: 2, seekTimeout: .seconds(2))
+
+        await #expect(throws: (any Error).self) {
+            _ = try await sheet.generate(uri: "file:///nonexistent/video.mp4")
+        }
+    }
+
+    @Test("Images from one sheet share a JPEG encoder")
+    func sharedJPEGEncoder() async throws {
+        let encoders = ThumbnailSheet.Encoders()
+        let image = ThumbnailSheet.Image(
+            width: 32,
+            height: 16,
+            pixels: [UInt8](repeating: 128, count: 32 * 16 * 4),
+            timestamps: [],
+            encoders: encoders
+        )
+
+        let first = try await image.jpegData(quality: 80)
+        let second = try await image.jpegData(quality: 80)
+        #expect(first.starts(with: [0xFF, 0xD8]))
+        #expect(second == first)
+        #expect(encoders.encoder(quality: 80) === encoders.encoder(quality: 80))
+    }
+}
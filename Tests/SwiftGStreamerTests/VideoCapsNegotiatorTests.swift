@@ -0,0 +1,289 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Video Caps Negotiator Tests")
+struct VideoCapsNegotiatorTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    private let webcam = """
+        video/x-raw,format=YUY2,width=1280,height=720,framerate=30/1; \
+        video/x-raw,format=YUY2,width=640,height=480,framerate={ 30/1, 15/1 }
+        """
+
+    private let testPattern = """
+        video/x-raw,format={ BGRA, I420 },width=[ 1, 2147483647 ],height=[ 1, 2147483647 ],\
+        framerate=[ 0/1, 2147483647/1 ]
+        """
+
+    @Test("Native mode needs only a format conversion")
+    func nativeModeConvertOnly() throws {
+        let negotiator = VideoCapsNegotiator(
+            available: try Caps(webcam),
+            size: (1280, 720),
+            framerate: 30,
+            formats: [.bgra],
+            consumerCaps: nil,
+            requiresScale: false
+        )
+
+        let plan = try #require(negotiator.negotiate())
+        #expect(plan.needsConvert)
+        #expect(!plan.needsScale)
+        #expect(!plan.needsRate)
+        #expect(plan.sourceCaps?.structure(at: 0)?.int("width") == 1280)
+    }
+
+    @Test("Accepted native format needs no conversion at all")
+    func passthrough() throws {
+        let negotiator = VideoCapsNegotiator(
+            available: try Caps(webcam),
+            size: (640, 480),
+            framerate: 15,
+            formats: [.bgra, .unknown("YUY2")],
+            consumerCaps: nil,
+            requiresScale: false
+        )
+
+        let plan = try #require(negotiator.negotiate())
+        #expect(!plan.needsConvert)
+        #expect(!plan.needsScale)
+        #expect(!plan.needsRate)
+    }
+
+    @Test("Unsupported size scales down from a larger mode")
+    func scalesFromLargerMode() throws {
+        let negotiator = VideoCapsNegotiator(
+            available: try Caps(webcam),
+            size: (960, 540),
+            framerate: 30,
+            formats: [.bgra],
+            consumerCaps: nil,
+            requiresScale: false
+        )
+
+        let plan = try #require(negotiator.negotiate())
+        #expect(plan.needsScale)
+        #expect(!plan.needsRate)
+        #expect(plan.sourceCaps?.structure(at: 0)?.int("width") == 1280)
+    }
+
+    @Test("Unsupported framerate adds a rate adapter")
+    func rateAdapter() throws {
+        let negotiator = VideoCapsNegotiator(
+            available: try Caps(webcam),
+            size: (1280, 720),
+            framerate: 15,
+            formats: [.bgra],
+            consumerCaps: nil,
+            requiresScale: false
+        )
+
+        let plan = try #require(negotiator.negotiate())
+        #expect(plan.needsRate)
+        #expect(!plan.needsScale)
+    }
+
+    @Test("A rate adapter is preferred over a format conversion")
+    func rateBeforeConvert() throws {
+        let negotiator = VideoCapsNegotiator(
+            available: try Caps("""
+                video/x-raw,format=BGRA,width=640,height=480,framerate=30/1; \
+                video/x-raw,format=YUY2,width=640,height=480,framerate=15/1
+                """),
+            size: (640, 480),
+            framerate: 15,
+            formats: [.bgra],
+            consumerCaps: nil,
+            requiresScale: false
+        )
+
+        let plan = try #require(negotiator.negotiate())
+        #expect(plan.needsRate)
+        #expect(!plan.needsConvert)
+        #expect(!plan.needsScale)
+        #expect(plan.sourceCaps?.structure(at: 0)?.string("format") == "BGRA")
+    }
+
+    @Test("Non-raw sources cannot be negotiated")
+    func nonRawSource() throws {
+        let negotiator = VideoCapsNegotiator(
+            available: try Caps("image/jpeg,width=1280,height=720"),
+            size: (1280, 720),
+            framerate: nil,
+            formats: [.bgra],
+            consumerCaps: nil,
+            requiresScale: false
+        )
+
+        #expect(negotiator.negotiate() == nil)
+    }
+
+    @Test("Test pattern source starts with a negotiated chain")
+    func testPatternBuild() async throws {
+        let source = try VideoSource.testPattern()
+            .withResolution(.vga)
+            .withFramerate(30)
+            .build()
+
+        #expect(source.diagnostics.isEmpty)
+        #expect(source.selectedPipeline.contains("_src"))
+
+        let iterator = source.frames().makeAsyncIterator()
+        let frame = try await iterator.next()
+        #expect(frame?.width == 640)
+        #expect(frame?.height == 480)
+
+        await source.stop()
+    }
+
+    @Test("Open ranges fixate to defaults, not their minimum")
+    func unconstrainedDefaults() throws {
+        let negotiator = VideoCapsNegotiator(
+            available: try Caps(testPattern),
+            size: nil,
+            framerate: nil,
+            formats: [.bgra],
+            consumerCaps: nil,
+            requiresScale: false
+        )
+
+        let plan = try #require(negotiator.negotiate())
+        let structure = try #require(plan.sourceCaps?.structure(at: 0))
+        #expect(structure.int("width") == 640)
+        #expect(structure.int("height") == 480)
+        #expect(structure.fraction("framerate")?.numerator == 30)
+        #expect(structure.fraction("framerate")?.denominator == 1)
+    }
+
+    @Test("Unconstrained webcam picks its largest mode")
+    func unconstrainedLargestMode() throws {
+        let negotiator = VideoCapsNegotiator(
+            available: try Caps(webcam),
+            size: nil,
+            framerate: nil,
+            formats: [.bgra],
+            consumerCaps: nil,
+            requiresScale: false
+        )
+
+        let plan = try #require(negotiator.negotiate())
+        let structure = try #require(plan.sourceCaps?.structure(at: 0))
+        #expect(structure.int("width") == 1280)
+        #expect(structure.int("height") == 720)
+        #expect(structure.fraction("framerate")?.numerator == 30)
+    }
+
+    @Test("Resolution without a framerate keeps a usable framerate")
+    func resolutionOnly() throws {
+        let negotiator = VideoCapsNegotiator(
+            available: try Caps(testPattern),
+            size: (320, 240),
+            framerate: nil,
+            formats: [.bgra],
+            consumerCaps: nil,
+            requiresScale: false
+        )
+
+        let plan = try #require(negotiator.negotiate())
+        #expect(!plan.needsScale)
+        let structure = try #require(plan.sourceCaps?.structure(at: 0))
+        #expect(structure.int("width") == 320)
+        #expect(structure.int("height") == 240)
+        #expect(structure.fraction("framerate")?.numerator == 30)
+        #expect(structure.fraction("framerate")?.denominator == 1)
+    }
+
+    @Test("Unconstrained test pattern keeps streaming")
+    func unconstrainedTestPatternBuild() async throws {
+        let source = try VideoSource.testPattern().build()
+
+        var count = 0
+        for try await frame in source.frames() {
+            #expect(frame.width == 640)
+            #expect(frame.height == 480)
+            count += 1
+            if count >= 3 { break }
+        }
+        #expect(count == 3)
+
+        await source.stop()
+    }
+
+    @Test("Test pattern with only a resolution keeps streaming")
+    func resolutionOnlyTestPatternBuild() async throws {
+        let source = try VideoSource.testPattern()
+            .withResolution(width: 320, height: 240)
+            .build()
+
+        var count = 0
+        for try await frame in source.frames() {
+            #expect(frame.width == 320)
+            #expect(frame.height == 240)
+            count += 1
+            if count >= 3 { break }
+        }
+        #expect(count == 3)
+
+        await source.stop()
+    }
+
+    @Test("Accepted formats with only a framerate negotiate a native mode")
+    func acceptedFormatsFramerateOnly() throws {
+        let negotiator = VideoCapsNegotiator(
+            available: try Caps(testPattern),
+            size: nil,
+            framerate: 15,
+            formats: [.nv12, .i420],
+            consumerCaps: nil,
+            requiresScale: false
+        )
+
+        let plan = try #require(negotiator.negotiate())
+        #expect(!plan.needsConvert)
+        #expect(!plan.needsScale)
+        #expect(!plan.needsRate)
+        let structure = try #require(plan.sourceCaps?.structure(at: 0))
+        #expect(structure.string("format") == "I420")
+        #expect(structure.int("width") == 640)
+        #expect(structure.int("height") == 480)
+        #expect(structure.fraction("framerate")?.numerator == 15)
+        #expect(structure.fraction("framerate")?.denominator == 1)
+    }
+
+    @Test("Partially constrained source delivers native frames")
+    func partiallyConstrainedBuild() async throws {
+        let source = try VideoSource.testPattern()
+            .withFramerate(15)
+            .withAcceptedFormats([.i420, .bgra])
+            .build()
+
+        #expect(!source.selectedPipeline.contains("videoconvert"))
+        #expect(!source.selectedPipeline.contains("videoscale"))
+        #expect(!source.selectedPipeline.contains("videorate"))
+
+        var count = 0
+        for try await frame in source.frames() {
+            #expect(frame.format == .i420)
+            #expect(frame.width == 640)
+            #expect(frame.height == 480)
+            count += 1
+            if count >= 2 { break }
+        }
+        #expect(count == 2)
+
+        await source.stop()
+    }
+
+    @Test("Compressed and unknown accepted formats are rejected")
+    func rejectsNonRawFormats() {
+        #expect(throws: VideoSource.VideoSourceError.self) {
+            _ = try VideoSource.testPattern().withAcceptedFormats([.bgra, .mjpeg]).build()
+        }
+        #expect(throws: VideoSource.VideoSourceError.self) {
+            _ = try VideoSource.testPattern().withAcceptedFormats([.unknown("YUY2")]).build()
+        }
+    }
+}
@@ -0,0 +1,107 @@
+import Testing
+@testable import GStreamer
+
+@Suite("Video Frame Decode Tests")
+struct VideoFrameDecodeTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    /// Pull one JPEG-encoded frame from a test pattern.
+    private func jpegFrame(width: Int = 320, height: Int = 240) async throws -> VideoFrame {
+        let pipeline = try Pipeline(
+            """
+            videotestsrc num-buffers=1 ! video/x-raw,width=\(width),height=\(height) ! \
+            jpegenc ! appsink name=sink
+            """
+        )
+        defer { pipeline.stop() }
+
+        let sink = try pipeline.appSink(named: "sink")
+        try pipeline.play()
+
+        for try await frame in sink.frames() {
+            return frame
+        }
+        throw GStreamerError.bufferMapFailed
+    }
+
+    @Test("JPEG frames are reported as MJPEG")
+    func jpegFormat() async throws {
+        let frame = try await jpegFrame()
+        #expect(frame.format == .mjpeg)
+        #expect(frame.width == 320)
+        #expect(frame.height == 240)
+    }
+
+    @Test("Decode to full size BGRA")
+    func decodeFullSize() async throws {
+        let frame = try await jpegFrame()
+        let decoded = try await frame.decode()
+
+        #expect(decoded.format == .bgra)
+        #expect(decoded.width == 320)
+        #expect(decoded.height == 240)
+        #expect(decoded.bytes.byteCount == 320 * 240 * 4)
+        #expect(decoded.pts == frame.pts)
+    }
+
+    @Test("Decode scales and keeps the aspect ratio")
+    func decodeScaled() async throws {
+        let frame = try await jpegFrame()
+
+        let first = try await frame.decode(width: 160, format: .i420)
+        #expect(first.width == 160)
+        #expect(first.height == 120)
+        #expect(first.format == .i420)
+
+        // Second decode reuses the pooled decoder
+        let second = try await frame.decode(width: 160, format: .i420)
+        #expect(second.bytes.byteCount == PixelFormat.i420.frameSize(width: 160, height: 120))
+    }
+
+    @Test("Raw frames cannot be decoded")
+    func rawFrameThrows() async throws {
+        let pipeline = try Pipeline(
+            "videotestsrc num-buffers=1 ! video/x-raw,format=BGRA,width=64,height=48 ! appsink name=sink"
+        )
+        defer { pipeline.stop() }
+        let sink = try pipeline.appSink(named: "sink")
+        try pipeline.play()
+
+        let frame = try #require(try await sink.frames().makeAsyncIterator().next())
+        await #expect(throws: VideoFrame.DecodeError.self) {
+            _ = try await frame.decode()
+        }
+    }
+
+    @Test("MJPEG capture from a test pattern fails pre-flight")
+    func mjpegCaptureRequiresMJPEGSource() {
+        #expect(throws: VideoSource.VideoSourceError.self) {
+            _ = try VideoSource.testPattern()
+                .withResolution(.vga)
+                .withMJPEGCapture()
+                .build()
+        }
+    }
+
+    @Test("Idle decoders for old sizes are evicted")
+    func poolEvictsOldSizes() async throws {
+        let pool = JPEGDecoderPool(maxIdlePerKey: 1, maxKeys: 1)
+
+        for (width, height) in [(320, 240), (160, 120)] {
+            let frame = try await jpegFrame(width: width, height: height)
+            let key = JPEGDecoderPool.Key(
+                inputWidth: width,
+                inputHeight: height,
+                outputWidth: width,
+                outputHeight: height,
+                format: .bgra
+            )
+            let decoded = try await pool.decode(frame, key: key, timeout: .seconds(2))
+            #expect(decoded.width == width)
+            #expect(pool.idleKeys == [key])
+        }
+    }
+}
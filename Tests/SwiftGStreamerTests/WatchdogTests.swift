@@ -0,0 +1,162 @@
+import Synchronization
+import Testing
+@testable import GStreamer
+
+@Suite("Watchdog Tests")
+struct WatchdogTests {
+
+    init() throws {
+        try GStreamer.initialize()
+    }
+
+    /// A live source whose output can be cut off with the valve.
+    private static let gatedPipeline = """
+        videotestsrc name=src is-live=true ! video/x-raw,width=64,height=48,framerate=30/1 ! \
+        valve name=valve ! fakesink sync=false
+        """
+
+    private static let fastRecovery = Watchdog.Configuration(
+        deadline: .milliseconds(200),
+        initialBackoff: .milliseconds(20),
+        maxBackoff: .milliseconds(100)
+    )
+
+    @Test("Flowing pipelines are left alone")
+    func noStallWhileFlowing() async throws {
+        let pipeline = try Pipeline(Self.gatedPipeline)
+        let watchdog = try Watchdog(pipeline: pipeline, configuration: Self.fastRecovery)
+        try await pipeline.play(timeout: .seconds(5))
+
+        try await Task.sleep(for: .milliseconds(600))
+        #expect(!watchdog.isStalled)
+        #expect(watchdog.recoveries == 0)
+
+        watchdog.cancel()
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("A stall is detected and recovered by restarting the source")
+    func recoversFromStall() async throws {
+        let pipeline = try Pipeline(Self.gatedPipeline)
+        let valve = try #require(pipeline.element(named: "valve"))
+        let watchdog = try Watchdog(pipeline: pipeline, configuration: Self.fastRecovery)
+        try await pipeline.play(timeout: .seconds(5))
+
+        valve.set("drop", true)
+        var events: [Watchdog.Event] = []
+        for await event in watchdog.events {
+            events.append(event)
+            if case .stalled = event {
+                // The camera comes back.
+                valve.set("drop", false)
+            }
+            if case .recovered = event { break }
+        }
+
+        #expect(events.contains(.recovering(attempt: 1, strategy: .restartSource("src"))))
+        #expect(watchdog.recoveries == 1)
+
+        watchdog.cancel()
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("Frame consumers keep receiving across a pipeline restart")
+    func framesSurvivePipelineRestart() async throws {
+        let pipeline = try Pipeline("""
+            videotestsrc is-live=true ! video/x-raw,format=BGRA,width=64,height=48,framerate=30/1 ! \
+            appsink name=sink sync=false
+            """)
+        let sink = try pipeline.appSink(named: "sink")
+        let watchdog = try Watchdog(pipeline: pipeline, configuration: Self.fastRecovery)
+        try await pipeline.play(timeout: .seconds(5))
+
+        let received = Atomic<Int>(0)
+        let consumer = Task {
+            for try await _ in sink.frames() {
+                if received.add(1, ordering: .relaxed).newValue == 20 { break }
+            }
+        }
+
+        while received.load(ordering: .relaxed) < 5 {
+            try await Task.sleep(for: .milliseconds(10))
+        }
+        // The consumer is waiting in the iterator while the sink is stopped.
+        await watchdog.restart(.restartPipeline)
+
+        try await consumer.value
+        #expect(received.load(ordering: .relaxed) == 20)
+        #expect(pipeline.currentState() == .playing)
+
+        watchdog.cancel()
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("A dropped watchdog stops watching and releases its pipeline")
+    func droppedWatchdogReleasesPipeline() async throws {
+        weak var weakPipeline: Pipeline?
+        weak var weakWatchdog: Watchdog?
+        let events: AsyncStream<Watchdog.Event>
+        do {
+            let pipeline = try Pipeline(Self.gatedPipeline)
+            let watchdog = try Watchdog(pipeline: pipeline, configuration: Self.fastRecovery)
+            weakPipeline = pipeline
+            weakWatchdog = watchdog
+            events = watchdog.events
+            try await pipeline.play(timeout: .seconds(5))
+            // Stall once nobody is watching any more.
+            pipeline.element(named: "valve")?.set("drop", true)
+        }
+
+        // Well past the deadline: a live watchdog would have restarted by now.
+        try await Task.sleep(for: .milliseconds(600))
+        try #require(weakWatchdog == nil)
+        #expect(weakPipeline == nil)
+
+        var received: [Watchdog.Event] = []
+        for await event in events {
+            received.append(event)
+        }
+        #expect(received.isEmpty)
+    }
+
+    @Test("Giving up stops the pipeline")
+    func givesUp() async throws {
+        let pipeline = try Pipeline(Self.gatedPipeline)
+        let valve = try #require(pipeline.element(named: "valve"))
+        var configuration = Self.fastRecovery
+        configuration.maxAttempts = 2
+        let watchdog = try Watchdog(pipeline: pipeline, configuration: configuration)
+        try await pipeline.play(timeout: .seconds(5))
+
+        valve.set("drop", true)
+        var last: Watchdog.Event?
+        for await event in watchdog.events {
+            last = event
+        }
+
+        #expect(last == .gaveUp(attempts: 2))
+        #expect(pipeline.currentState() == .null)
+    }
+
+    @Test("End of stream is not a stall")
+    func eosIsNotAStall() async throws {
+        let pipeline = try Pipeline("videotestsrc num-buffers=5 ! fakesink")
+        let watchdog = try Watchdog(pipeline: pipeline, configuration: Self.fastRecovery)
+        try await pipeline.play(timeout: .seconds(5))
+
+        try await Task.sleep(for: .milliseconds(600))
+        #expect(!watchdog.isStalled)
+        #expect(watchdog.recoveries == 0)
+
+        watchdog.cancel()
+        await pipeline.stop(timeout: .seconds(5))
+    }
+
+    @Test("An unknown source element throws")
+    func unknownSourceThrows() throws {
+        let pipeline = try Pipeline("videotestsrc ! fakesink")
+        #expect(throws: GStreamerError.self) {
+            _ = try Watchdog(pipeline: pipeline, source: "missing")
+        }
+    }
+}